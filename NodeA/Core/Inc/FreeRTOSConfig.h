@@ -61,14 +61,14 @@
 
 #define configUSE_PREEMPTION                     1
 #define configSUPPORT_STATIC_ALLOCATION          1
-#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION         0
 #define configUSE_IDLE_HOOK                      0
 #define configUSE_TICK_HOOK                      0
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)15360)
+#define configTOTAL_HEAP_SIZE                    ((size_t)0)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
 #define configUSE_16_BIT_TICKS                   0
@@ -77,6 +77,7 @@
 #define configUSE_RECURSIVE_MUTEXES              1
 #define configUSE_COUNTING_SEMAPHORES            1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configUSE_TICKLESS_IDLE                  1
 /* USER CODE BEGIN MESSAGE_BUFFER_LENGTH_TYPE */
 /* Defaults to size_t for backward compatibility, but can be changed
    if lengths will always be less than the number of bytes in a size_t. */
@@ -124,7 +125,7 @@ to exclude the API function. */
  * The CMSIS-RTOS V2 FreeRTOS wrapper is dependent on the heap implementation used
  * by the application thus the correct define need to be enabled below
  */
-#define USE_FreeRTOS_HEAP_4
+/* No RTOS heap — all objects are static, see rtos_config.h and heap_none.c */
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -168,6 +169,35 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Tickless idle: TIM1 is suspended around the WFI and the wake-up
+   source is recorded, see power.c */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void Power_TaskSwitchedIn(const void *tcb, uint32_t isIdle);
+void Power_PreSleep(uint32_t *expectedIdleTicks);
+void Power_PostSleep(uint32_t *expectedIdleTicks);
+#include "trace.h"
+#endif
+#define configPRE_SLEEP_PROCESSING(x)            Power_PreSleep(&(x))
+#define configPOST_SLEEP_PROCESSING(x)           Power_PostSleep(&(x))
+
+/* Context switch and idle time accounting, and the trace recorder's
+   task switches. Expands inside tasks.c, where pxCurrentTCB and
+   xIdleTaskHandle are visible */
+#define traceTASK_SWITCHED_IN()                                                              \
+    do {                                                                                     \
+        Power_TaskSwitchedIn(pxCurrentTCB, (void *)pxCurrentTCB == (void *)xIdleTaskHandle); \
+        TRACE_TASK_IN(pxCurrentTCB->uxTCBNumber);                                            \
+    } while (0)
+#define traceTASK_SWITCHED_OUT()                 TRACE_TASK_OUT(pxCurrentTCB->uxTCBNumber)
+
+/* Trace recorder, see trace.h. Queue hooks expand inside queue.c */
+#define traceQUEUE_SEND(q)                       TRACE_QUEUE(TRACE_EV_QUEUE_SEND, q)
+#define traceQUEUE_SEND_FROM_ISR(q)              TRACE_QUEUE(TRACE_EV_QUEUE_SEND, q)
+#define traceQUEUE_SEND_FAILED(q)                TRACE_QUEUE(TRACE_EV_QUEUE_FULL, q)
+#define traceQUEUE_SEND_FROM_ISR_FAILED(q)       TRACE_QUEUE(TRACE_EV_QUEUE_FULL, q)
+#define traceQUEUE_RECEIVE(q)                    TRACE_QUEUE(TRACE_EV_QUEUE_RECEIVE, q)
+#define traceQUEUE_RECEIVE_FROM_ISR(q)           TRACE_QUEUE(TRACE_EV_QUEUE_RECEIVE, q)
+#define traceQUEUE_REGISTRY_ADD(q, name)         TRACE_QUEUE_NAME(q, name)
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
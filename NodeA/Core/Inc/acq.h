@@ -0,0 +1,66 @@
+/*
+ * acq.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Oversampled acquisition. TIM3 fires at ACQ_RATE_HZ; every sample
+ *  runs through its channel's filter stage and is folded into a
+ *  min/max/mean/last window in the ISR. The sensor active object takes the
+ *  windows once per sample period, so nothing between two broadcasts
+ *  is lost. Samples are clamped to the q15 range before filtering.
+ */
+
+#ifndef INC_ACQ_H_
+#define INC_ACQ_H_
+
+#include "stm32f4xx_hal.h"
+#include "decimate.h"
+#include "filter.h"
+#include <stdbool.h>
+
+/* ── Configuration ───────────────────────────── */
+#define ACQ_RATE_HZ             1000
+
+#ifndef ACQ_AGGREGATE
+#define ACQ_AGGREGATE           1       /* 0: broadcast the last value only, as before */
+#endif
+
+/* Bytes per RPM/TEMP broadcast: [min, max, mean, last] or the value */
+#define ACQ_FRAME_DLC           (ACQ_AGGREGATE ? 8 : 2)
+
+/* ── Channels (same numbering as CAN_SIG_*) ──── */
+typedef enum {
+    ACQ_CH_RPM = 0,
+    ACQ_CH_TEMP,
+    ACQ_CH_COUNT
+} Acq_Channel_t;
+
+_Static_assert(ACQ_RATE_HZ == FILT_FS_HZ, "Biquad table is designed for the acquisition rate");
+
+typedef struct {
+    uint32_t samples;
+    uint32_t takes;
+} Acq_Stats_t;
+
+/* ── Filter Stage per Channel (0x2400 RPM, 0x2401 TEMP) ── */
+typedef struct {
+    uint8_t  kind;              /* Filt_Kind_t requested — SDO writable */
+    uint16_t param;
+    uint8_t  active;            /* Kind in effect, FILT_NONE if the request was invalid */
+    uint32_t cyclesAvg;         /* DWT cycles per sample, EWMA 1/16 */
+    uint32_t cyclesMax;         /* Since the filter was last configured */
+} Acq_FilterStage_t;
+
+extern Acq_Stats_t       Acq_Stats;
+extern Acq_FilterStage_t Acq_Filters[ACQ_CH_COUNT];
+
+/* ── Function Declarations ───────────────────── */
+void Acq_Init(TIM_HandleTypeDef *htim);
+void Acq_SampleISR(void);
+bool Acq_Take(Dec_Window_t out[ACQ_CH_COUNT]);     /* false if nothing sampled */
+void Acq_ApplyFilters(void);                        /* Picks up changed kind/param */
+void Acq_LogStats(void);
+void Acq_ReadSensors(int32_t out[ACQ_CH_COUNT]);   /* Weak — synthetic trace */
+
+#endif /* INC_ACQ_H_ */
@@ -0,0 +1,105 @@
+/*
+ * can_bittiming.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  bxCAN bit-timing solver. Derives prescaler, BS1, BS2 and SJW
+ *  from the CAN kernel clock (APB1), the bitrate and a target
+ *  sample point. The macros are integer constant expressions, so
+ *  the supported table is solved at compile time; they work just
+ *  as well on runtime values. No HAL dependencies, so it builds
+ *  and runs on a host.
+ */
+
+#ifndef INC_CAN_BITTIMING_H_
+#define INC_CAN_BITTIMING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ── Configuration ───────────────────────────── */
+#define CAN_CLOCK_HZ                45000000U   /* APB1 = 180 MHz / 4 */
+#define CAN_SAMPLE_POINT_PERMILLE   875U        /* CiA 301 recommendation */
+
+/* ── bxCAN Limits ────────────────────────────── */
+#define CAN_BT_PRESCALER_MAX        1024U
+#define CAN_BT_TSEG1_MAX            16U         /* Tq, sync segment excluded */
+#define CAN_BT_TSEG2_MAX            8U
+#define CAN_BT_SJW_MAX              4U
+
+/* ── Solver ──────────────────────────────────── */
+/* For n time quanta per bit, the sample point sits after 1 + TSEG1 */
+#define CAN_BT_TSEG1(n, sp)         (((n) * (sp) + 500U) / 1000U - 1U)
+#define CAN_BT_TSEG2(n, sp)         ((n) - 1U - CAN_BT_TSEG1(n, sp))
+
+#define CAN_BT_FITS(clk, br, sp, n)                                     \
+    ((clk) % ((br) * (n)) == 0U &&                                      \
+     (clk) / ((br) * (n)) <= CAN_BT_PRESCALER_MAX &&                    \
+     CAN_BT_TSEG1(n, sp) >= 1U && CAN_BT_TSEG1(n, sp) <= CAN_BT_TSEG1_MAX && \
+     CAN_BT_TSEG2(n, sp) >= 1U && CAN_BT_TSEG2(n, sp) <= CAN_BT_TSEG2_MAX)
+
+/* Most quanta per bit that divide the clock exactly: finest sample
+ * point placement and widest resynchronisation. 0 = no solution */
+#define CAN_BT_NTQ(clk, br, sp)                                         \
+    (CAN_BT_FITS(clk, br, sp, 25U) ? 25U : CAN_BT_FITS(clk, br, sp, 24U) ? 24U : \
+     CAN_BT_FITS(clk, br, sp, 23U) ? 23U : CAN_BT_FITS(clk, br, sp, 22U) ? 22U : \
+     CAN_BT_FITS(clk, br, sp, 21U) ? 21U : CAN_BT_FITS(clk, br, sp, 20U) ? 20U : \
+     CAN_BT_FITS(clk, br, sp, 19U) ? 19U : CAN_BT_FITS(clk, br, sp, 18U) ? 18U : \
+     CAN_BT_FITS(clk, br, sp, 17U) ? 17U : CAN_BT_FITS(clk, br, sp, 16U) ? 16U : \
+     CAN_BT_FITS(clk, br, sp, 15U) ? 15U : CAN_BT_FITS(clk, br, sp, 14U) ? 14U : \
+     CAN_BT_FITS(clk, br, sp, 13U) ? 13U : CAN_BT_FITS(clk, br, sp, 12U) ? 12U : \
+     CAN_BT_FITS(clk, br, sp, 11U) ? 11U : CAN_BT_FITS(clk, br, sp, 10U) ? 10U : \
+     CAN_BT_FITS(clk, br, sp, 9U)  ? 9U  : CAN_BT_FITS(clk, br, sp, 8U)  ? 8U  : 0U)
+
+#define CAN_BT_PRESCALER(clk, br, sp)                                   \
+    (CAN_BT_NTQ(clk, br, sp) ? (clk) / ((br) * CAN_BT_NTQ(clk, br, sp)) : 0U)
+
+#define CAN_BT_SJW(n, sp)                                               \
+    (CAN_BT_TSEG2(n, sp) < CAN_BT_SJW_MAX ? CAN_BT_TSEG2(n, sp) : CAN_BT_SJW_MAX)
+
+/* ── Solved Timing ───────────────────────────── */
+typedef struct {
+    uint32_t bitrate;
+    uint16_t prescaler;         /* 0 = no solution */
+    uint8_t  tseg1;             /* Tq */
+    uint8_t  tseg2;             /* Tq */
+    uint8_t  sjw;               /* Tq */
+    uint16_t samplePermille;    /* Achieved sample point */
+} CAN_BitTiming_t;
+
+#define CAN_BT_INIT_N(br, sp, n, presc)                                 \
+    { (br), (presc), CAN_BT_TSEG1(n, sp), CAN_BT_TSEG2(n, sp),          \
+      CAN_BT_SJW(n, sp), (n) ? (1000U * (1U + CAN_BT_TSEG1(n, sp))) / (n) : 0U }
+
+/* Constant initialiser for a CAN_BitTiming_t */
+#define CAN_BIT_TIMING(clk, br, sp)                                     \
+    CAN_BT_INIT_N(br, sp, CAN_BT_NTQ(clk, br, sp), CAN_BT_PRESCALER(clk, br, sp))
+
+/* Runtime form of the same solver — false when the clock cannot
+ * produce the bitrate exactly within the bxCAN limits */
+static inline bool CAN_BitTiming_Solve(uint32_t clk, uint32_t br, uint32_t sp,
+                                       CAN_BitTiming_t *out)
+{
+    if (br == 0U || sp == 0U || sp >= 1000U) return false;
+
+    uint32_t n = CAN_BT_NTQ(clk, br, sp);
+    if (n == 0U) return false;
+
+    out->bitrate        = br;
+    out->prescaler      = (uint16_t)(clk / (br * n));
+    out->tseg1          = (uint8_t)CAN_BT_TSEG1(n, sp);
+    out->tseg2          = (uint8_t)CAN_BT_TSEG2(n, sp);
+    out->sjw            = (uint8_t)CAN_BT_SJW(n, sp);
+    out->samplePermille = (uint16_t)((1000U * (1U + out->tseg1)) / n);
+    return true;
+}
+
+/* ── Supported Bitrates (solved at compile time) ── */
+extern const CAN_BitTiming_t CAN_BitTimings[];
+extern const uint8_t         CAN_BitTimingCount;
+
+const CAN_BitTiming_t *CAN_BitTiming_Find(uint32_t bitrate);
+
+#endif /* INC_CAN_BITTIMING_H_ */
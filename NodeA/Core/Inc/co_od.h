@@ -0,0 +1,36 @@
+/*
+ * co_od.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Node A (sensor) object dictionary.
+ */
+
+#ifndef INC_CO_OD_H_
+#define INC_CO_OD_H_
+
+#include "canopen.h"
+
+/* ── Sensor Node Number (0–15) ───────────────── */
+/* Set per ECU with -DSENSOR_NODE_ID=n; selects the CAN data/command IDs */
+#ifndef SENSOR_NODE_ID
+#define SENSOR_NODE_ID          0
+#endif
+
+/* ── CANopen Node IDs ────────────────────────── */
+#define CO_NODE_ID_SENSOR       0x40    /* + sensor node number */
+#define CO_NODE_ID_CONTROLLER   0x7F
+#define CO_NODE_ID              (CO_NODE_ID_SENSOR + SENSOR_NODE_ID)
+
+/* ── Process Data (0x2000) ───────────────────── */
+extern uint16_t OD_rpm;                 /* 0x2000:01 */
+extern int16_t  OD_temp;                /* 0x2000:02 */
+
+/* ── Parameters (0x2100) ─────────────────────── */
+extern uint16_t OD_txPeriodMs;          /* 0x2100:01 sensor update / heartbeat period */
+
+/* ── Communication (0x1800) ──────────────────── */
+extern uint16_t OD_tpdoEventTimer[1];   /* 0x1800:05 TPDO1 period, ms */
+
+#endif /* INC_CO_OD_H_ */
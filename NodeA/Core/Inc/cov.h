@@ -0,0 +1,56 @@
+/*
+ * cov.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Change-of-value transmission policy for periodic signals.
+ */
+
+#ifndef INC_COV_H_
+#define INC_COV_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ── Sampling ────────────────────────────────── */
+#define COV_SAMPLE_PERIOD_MS    10
+#define COV_BASELINE_PERIOD_MS  100     /* Legacy fixed-rate broadcast, for savings */
+
+/* ── Signals ─────────────────────────────────── */
+typedef enum {
+    COV_SIG_RPM = 0,        /* Same numbering as CAN_SIG_* */
+    COV_SIG_TEMP,
+    COV_SIG_COUNT
+} COV_SignalId_t;
+
+/* ── Per-signal Policy ───────────────────────── */
+typedef struct {
+    uint16_t deadband;      /* Send when |value - lastSent| > deadband  */
+    uint16_t inhibitMs;     /* Minimum gap between two transmissions    */
+    uint16_t refreshMs;     /* Maximum gap — send even if unchanged     */
+} COV_Config_t;
+
+/* ── Per-signal State and Counters ───────────── */
+typedef struct {
+    COV_Config_t cfg;
+    int32_t  lastSent;
+    uint32_t lastTxMs;
+    bool     primed;
+    uint32_t samples;       /* Values offered to COV_Update            */
+    uint32_t sentChange;    /* Sent because value moved past deadband  */
+    uint32_t sentRefresh;   /* Sent because refreshMs expired          */
+    uint32_t suppressed;    /* Samples that did not go on the bus      */
+    uint32_t baseline;      /* Frames a fixed-rate broadcast would send */
+    uint32_t baselineMs;
+} COV_Signal_t;
+
+extern COV_Signal_t COV_Signals[COV_SIG_COUNT];
+
+/* ── Function Declarations ───────────────────── */
+bool     COV_Update(COV_SignalId_t id, int32_t value, uint32_t nowMs, uint16_t maxIntervalMs);
+uint32_t COV_FramesSaved(COV_SignalId_t id);
+uint32_t COV_BitsSaved(COV_SignalId_t id);
+void     COV_LogStats(void);
+
+#endif /* INC_COV_H_ */
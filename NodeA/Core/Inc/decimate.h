@@ -0,0 +1,44 @@
+/*
+ * decimate.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Incremental min/max/mean/last reduction of an oversampled signal
+ *  into one value set per broadcast window. Integer only, and the
+ *  only division happens when the mean is read out. No HAL
+ *  dependencies, so it builds and runs on a host against synthetic
+ *  traces (sensor_sim.c).
+ */
+
+#ifndef INC_DECIMATE_H_
+#define INC_DECIMATE_H_
+
+#include <stdint.h>
+
+/* ── Window Accumulator ──────────────────────── */
+typedef struct {
+    int64_t  sum;
+    int32_t  min;
+    int32_t  max;
+    int32_t  last;
+    uint32_t count;             /* 0 = empty, other fields undefined */
+} Dec_Window_t;
+
+/* ── Function Declarations ───────────────────── */
+void    Dec_Reset(Dec_Window_t *w);
+void    Dec_Merge(Dec_Window_t *dst, const Dec_Window_t *src);
+int32_t Dec_Mean(const Dec_Window_t *w);
+int32_t Dec_Extreme(const Dec_Window_t *w, int32_t ref);
+
+/* One sample — inline, it runs in the acquisition ISR */
+static inline void Dec_Push(Dec_Window_t *w, int32_t x)
+{
+    if (w->count == 0 || x < w->min) w->min = x;
+    if (w->count == 0 || x > w->max) w->max = x;
+    w->last = x;
+    w->sum += x;
+    w->count++;
+}
+
+#endif /* INC_DECIMATE_H_ */
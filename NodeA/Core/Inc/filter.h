@@ -0,0 +1,74 @@
+/*
+ * filter.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Per-sample filter stage between acquisition and decimation.
+ *  Moving average (q15, running sum), 2nd-order Butterworth low-pass
+ *  (q31 DF1 biquad, 64-bit accumulator, or float when FILT_USE_FLOAT)
+ *  and median-of-N for spike rejection. One sample in, one out — no
+ *  block buffering, so the ISR cost per sample is fixed. No HAL
+ *  dependencies outside the saturating intrinsic.
+ */
+
+#ifndef INC_FILTER_H_
+#define INC_FILTER_H_
+
+#include <stdint.h>
+
+/* ── Configuration ───────────────────────────── */
+#define FILT_FS_HZ              1000    /* Biquad table is designed for this rate */
+#define FILT_MOVAVG_MAX         16
+#define FILT_MEDIAN_MAX         9       /* Odd lengths only */
+
+#ifndef FILT_USE_FLOAT
+#define FILT_USE_FLOAT          0       /* 1: float biquad — needs the FPU enabled */
+#endif
+
+#if FILT_USE_FLOAT && defined(__ARM_ARCH) && !defined(__ARM_FP)
+#error "FILT_USE_FLOAT needs an FPU build (-mfpu=fpv4-sp-d16 -mfloat-abi=hard)"
+#endif
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+typedef enum {
+    FILT_NONE = 0,
+    FILT_MOVAVG,                /* param = length 1–16 */
+    FILT_IIR,                   /* param = cutoff Hz, rounded down to 5/10/20/50/100/200 */
+    FILT_MEDIAN,                /* param = length 3–9, odd */
+    FILT_KIND_COUNT
+} Filt_Kind_t;
+
+/* ── Filter Instance ─────────────────────────── */
+typedef struct {
+    uint8_t  kind;
+    uint8_t  length;            /* MOVAVG / MEDIAN window */
+    uint8_t  pos;               /* Ring write index */
+    uint8_t  fill;              /* Samples held, up to length */
+
+    /* Moving average */
+    int32_t  sum;
+    int32_t  recip;             /* 1/length, Q15 (32768 = 1) */
+
+    /* Biquad: b0 b1 b2 −a1 −a2 (Q30), x[n-1] x[n-2] y[n-1] y[n-2] (Q16) */
+    const q31_t *coef;
+    q31_t    x1, x2, y1, y2;
+#if FILT_USE_FLOAT
+    const float *coefF;
+    float    fx1, fx2, fy1, fy2;
+#endif
+
+    /* Ring (MOVAVG, MEDIAN) and sorted copy (MEDIAN) */
+    q15_t    ring[FILT_MOVAVG_MAX];
+    q15_t    sorted[FILT_MEDIAN_MAX];
+} Filt_t;
+
+/* ── Function Declarations ───────────────────── */
+/* Invalid kind/param falls back to FILT_NONE; returns the kind in effect */
+Filt_Kind_t Filt_Configure(Filt_t *f, Filt_Kind_t kind, uint16_t param);
+q15_t       Filt_Process(Filt_t *f, q15_t x);
+const char *Filt_Name(Filt_Kind_t kind);
+
+#endif /* INC_FILTER_H_ */
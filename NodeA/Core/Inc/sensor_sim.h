@@ -0,0 +1,32 @@
+/*
+ * sensor_sim.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Synthetic RPM/TEMP trace, a pure function of time so the same
+ *  trace can be replayed on a host. Slow ramps as before, plus short
+ *  RPM spikes that a once-per-broadcast point sample almost always
+ *  misses.
+ */
+
+#ifndef INC_SENSOR_SIM_H_
+#define INC_SENSOR_SIM_H_
+
+#include <stdint.h>
+
+/* ── Trace Shape ─────────────────────────────── */
+#define SIM_RPM_MIN             800
+#define SIM_RPM_MAX             6000
+#define SIM_RPM_STEP            100
+#define SIM_RPM_NOISE           16      /* ± counts */
+#define SIM_TEMP_MIN            25
+#define SIM_TEMP_MAX            100
+#define SIM_SPIKE_PERIOD_MS     3700
+#define SIM_SPIKE_WIDTH_MS      4
+#define SIM_SPIKE_RPM           2500
+
+/* ── Function Declarations ───────────────────── */
+void Sim_Sample(uint32_t ms, uint16_t stepMs, int32_t *rpm, int32_t *temp);
+
+#endif /* INC_SENSOR_SIM_H_ */
@@ -0,0 +1,29 @@
+/*
+ * subscription.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Consumer-driven TX rates: controllers subscribe to signals at a
+ *  requested period, the sensor sends at the fastest requested rate.
+ */
+
+#ifndef INC_SUBSCRIPTION_H_
+#define INC_SUBSCRIPTION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cov.h"
+
+/* ── Configuration ───────────────────────────── */
+#define SUB_MAX_SUBSCRIBERS     4
+#define SUB_EXPIRY_MS           1500    /* 3 missed controller heartbeats */
+#define SUB_DEFAULT_PERIOD_MS   0       /* Rate with no subscribers, 0 = silent */
+
+/* ── Function Declarations ───────────────────── */
+void     SUB_HandleSubscribe(const uint8_t *data, uint8_t dlc, uint32_t nowMs);
+void     SUB_HandleHeartbeat(uint8_t subscriberId, uint32_t nowMs);
+void     SUB_Expire(uint32_t nowMs);
+uint16_t SUB_EffectivePeriod(COV_SignalId_t sig);
+
+#endif /* INC_SUBSCRIPTION_H_ */
@@ -9,16 +9,24 @@
 #define INC_TASKS_H_
 
 #include "cmsis_os.h"
+#include "ao.h"
 #include "can_app.h"
 #include "uart_log.h"
 
-/* ── Task Function Declarations ──────────────── */
-void vCANTransmitTask(void *argument);
-void vCANReceiveTask(void *argument);
-void vHeartbeatTask(void *argument);
-void vUARTLogTask(void *argument);
+/* ── Threads (one per priority level) ────────── */
+extern AO_Thread_t HighThread;      /* CanopenAO */
+extern AO_Thread_t AboveThread;     /* RxAO */
+extern AO_Thread_t NormalThread;    /* SensorAO */
+extern AO_Thread_t LowThread;       /* HeartbeatAO, LogAO */
 
-/* ── Log Queue ───────────────────────────────── */
-extern osMessageQueueId_t logQueueHandle;
+/* ── Active Objects ──────────────────────────── */
+extern AO_Active_t CanopenAO;       /* TPDO event timers, SDO timeout */
+extern AO_Active_t RxAO;            /* Commands (ACKed at once), subscriptions, SDO */
+extern AO_Active_t SensorAO;        /* Sampling, COV broadcasts, heartbeat, stats */
+extern AO_Active_t HeartbeatAO;     /* LED, trace and profile dumps */
+extern AO_Active_t LogAO;           /* Frame trace (CAN_FRAME_TRACE) */
+
+/* ── Function Declarations ───────────────────── */
+void Tasks_Init(void);
 
 #endif /* INC_TASKS_H_ */
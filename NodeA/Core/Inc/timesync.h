@@ -0,0 +1,65 @@
+/*
+ * timesync.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Cross-node time synchronisation over CAN (two-step SYNC / FOLLOW_UP).
+ *  TIM2 free-runs at 1 MHz as the local microsecond clock. The master
+ *  time-stamps its own SYNC on TX-complete and sends that time in a
+ *  FOLLOW_UP; followers time-stamp SYNC on RX and discipline offset
+ *  and drift against the master.
+ */
+
+#ifndef INC_TIMESYNC_H_
+#define INC_TIMESYNC_H_
+
+#include "stm32f4xx_hal.h"
+#include <stdbool.h>
+
+/* ── CAN IDs ─────────────────────────────────── */
+/* Outside the CANopen predefined set (0x080 is the CiA 301 SYNC,
+ * 0x081 node 1's EMCY). Priority does not matter: the master stamps
+ * SYNC when it actually leaves the controller */
+#define CAN_ID_SYNC             0x6E0
+#define CAN_ID_SYNC_FOLLOWUP    0x6E1
+
+/* ── Configuration ───────────────────────────── */
+#define TSYNC_PERIOD_MS         100     /* Master SYNC interval */
+#define TSYNC_LOCK_US           50      /* |offset| for lock */
+#define TSYNC_LOCK_COUNT        8       /* Consecutive good syncs to lock */
+#define TSYNC_DRIFT_GAIN_SHIFT  1       /* Drift correction = error >> shift */
+#define TSYNC_LOG_EVERY         50      /* Log one line every N syncs */
+
+/* ── Exported Estimates ──────────────────────── */
+typedef struct {
+    int32_t  offsetUs;          /* Master − model at the last SYNC */
+    int32_t  driftPpb;          /* Master rate relative to local clock */
+    uint32_t maxAbsOffsetUs;    /* Since lock was last acquired */
+    uint32_t syncs;
+    uint32_t missed;            /* FOLLOW_UP without matching SYNC */
+    uint8_t  locked;
+} TSync_Stats_t;
+
+extern TSync_Stats_t TSync_Stats;
+
+/* ── Function Declarations ───────────────────── */
+void     TSync_Init(TIM_HandleTypeDef *htim, bool master);
+uint32_t TSync_LocalUs(void);
+uint32_t TSync_NowUs(void);
+uint32_t TSync_LocalToGlobal(uint32_t localUs);
+uint32_t TSync_GlobalToLocal(uint32_t globalUs);
+
+/* Master side — call every TSYNC_PERIOD_MS from one task */
+void     TSync_MasterCycle(void);
+void     TSync_OnTxCompleteISR(uint32_t mailbox, uint32_t localUs);
+
+/* Follower side */
+void     TSync_OnSyncRxISR(const uint8_t *data, uint32_t localUs);
+void     TSync_OnFollowUp(const uint8_t *data, uint8_t dlc);
+
+/* Synchronised sampling trigger on global-time period boundaries */
+void     TSync_StartTrigger(uint32_t periodUs);
+void     TSync_TriggerCallback(void);   /* Weak, called from TIM2 ISR */
+
+#endif /* INC_TIMESYNC_H_ */
@@ -0,0 +1,141 @@
+/*
+ * trace.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  RTOS trace recorder. Kernel hooks (FreeRTOSConfig.h), the IRQ
+ *  handlers and a few protocol points write 8-byte timestamped events
+ *  into a RAM ring. A trigger freezes the ring shortly after the
+ *  event of interest; the ring is then dumped over UART or CAN as the
+ *  same 8-byte records, for python/trace_export.py to turn into a
+ *  Chrome/Perfetto timeline.
+ *
+ *  Compiled in for the Debug configuration (DEBUG defined) only, like
+ *  the profiling macros: every received frame records several events.
+ *
+ *  Included by FreeRTOSConfig.h — no RTOS or HAL headers here.
+ */
+
+#ifndef INC_TRACE_H_
+#define INC_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ── Configuration ───────────────────────────── */
+#ifndef TRACE_ENABLE
+#ifdef DEBUG
+#define TRACE_ENABLE            1
+#else
+#define TRACE_ENABLE            0       /* Every hook compiles to nothing */
+#endif
+#endif
+#define TRACE_RING_EVENTS       1024U   /* Power of two, 8 bytes each */
+#define TRACE_POST_TRIGGER      (TRACE_RING_EVENTS / 4U)    /* Kept after a trigger */
+#define TRACE_MAX_QUEUES        8U      /* = configQUEUE_REGISTRY_SIZE */
+#define TRACE_MAX_TASKS         12U
+#define TRACE_CAN_ID_BASE       0x780U  /* + CANopen node ID, dump frames */
+#define TRACE_CAN_FRAMES_PER_MS 2U      /* Dump pacing, ~25% of a 500k bus */
+
+/* ── Event Record ────────────────────────────── */
+/* Stored and dumped as is: little-endian, type first */
+typedef struct {
+    uint8_t  type;
+    uint8_t  id;                /* Task, queue, IRQ or mark number */
+    uint16_t arg;
+    uint32_t timeUs;            /* TSync_LocalUs — runs on in sleep */
+} Trace_Event_t;
+
+typedef enum {
+    TRACE_EV_SWITCH = 1,        /* id: task switched in, arg: task switched out */
+    TRACE_EV_QUEUE_SEND,        /* arg: items waiting before the send */
+    TRACE_EV_QUEUE_RECEIVE,     /* arg: items waiting before the receive */
+    TRACE_EV_QUEUE_FULL,        /* Send failed */
+    TRACE_EV_ISR_ENTER,
+    TRACE_EV_ISR_EXIT,          /* arg: DWT cycles in the handler, saturated */
+    TRACE_EV_MARK,              /* arg: mark specific, e.g. the node */
+} Trace_EventType_t;
+
+/* ── Traced Interrupts ───────────────────────── */
+typedef enum {
+    TRACE_IRQ_CAN_RX0 = 1,
+    TRACE_IRQ_CAN_TX,
+    TRACE_IRQ_TIM2,
+    TRACE_IRQ_TIM3,
+    TRACE_IRQ_COUNT,
+} Trace_Irq_t;
+
+/* ── Protocol Marks ──────────────────────────── */
+typedef enum {
+    TRACE_MARK_CMD = 1,         /* Command sent (controller) or received (sensor) */
+    TRACE_MARK_ACK,             /* ACK received (controller) or sent (sensor) */
+    TRACE_MARK_ACK_TIMEOUT,     /* Triggers a freeze on the controller */
+    TRACE_MARK_COUNT,
+} Trace_Mark_t;
+
+/* ── Dump Requests (OD 0x2700) ───────────────── */
+typedef enum {
+    TRACE_SINK_NONE = 0,
+    TRACE_SINK_UART,
+    TRACE_SINK_CAN,
+} Trace_Sink_t;
+
+typedef struct {
+    uint8_t  request;           /* Trace_Sink_t, cleared when the dump is done */
+    uint8_t  autoDump;          /* Sink for a dump once a trigger has frozen the ring */
+    uint8_t  frozen;
+    uint32_t recorded;          /* Events since the ring was last armed */
+} Trace_Ctrl_t;
+
+extern Trace_Ctrl_t Trace_Ctrl;
+
+/* ── Dump Record Kinds (events use 1–0x7F) ───── */
+#define TRACE_REC_HEADER        0x80U   /* [1] version [2] node [4..7] recorded */
+#define TRACE_REC_TASK_NAME     0x81U   /* [1] id [2] chunk [3..7] name */
+#define TRACE_REC_QUEUE_NAME    0x82U
+#define TRACE_REC_IRQ_NAME      0x83U
+#define TRACE_REC_MARK_NAME     0x84U
+#define TRACE_REC_END           0x8FU   /* [4..7] events dumped */
+#define TRACE_FORMAT_VERSION    1U
+
+/* ── Function Declarations ───────────────────── */
+void Trace_Init(void);
+void Trace_Record(uint8_t type, uint8_t id, uint16_t arg);
+void Trace_TaskSwitchedOut(uint32_t task);
+void Trace_TaskSwitchedIn(uint32_t task);
+void Trace_QueueRegistered(void *queue, const char *name);
+void Trace_IsrEnter(uint8_t irq);
+void Trace_IsrExit(uint8_t irq);
+void Trace_Trigger(uint8_t mark, uint16_t arg);
+void Trace_Service(void);
+
+/* ── Hooks ───────────────────────────────────── */
+/* TRACE_QUEUE expands inside queue.c; only queues registered with a
+ * name (every osMessageQueueNew here) carry a trace number */
+#if TRACE_ENABLE
+#define TRACE_TASK_OUT(task)        Trace_TaskSwitchedOut(task)
+#define TRACE_TASK_IN(task)         Trace_TaskSwitchedIn(task)
+#define TRACE_QUEUE(type, q)                                                \
+    do {                                                                    \
+        if ((q)->uxQueueNumber != 0U)                                       \
+            Trace_Record((type), (uint8_t)(q)->uxQueueNumber,               \
+                         (uint16_t)(q)->uxMessagesWaiting);                 \
+    } while (0)
+#define TRACE_QUEUE_NAME(q, name)   Trace_QueueRegistered((q), (name))
+#define TRACE_ISR_ENTER(irq)        Trace_IsrEnter(irq)
+#define TRACE_ISR_EXIT(irq)         Trace_IsrExit(irq)
+#define TRACE_MARK(mark, arg)       Trace_Record(TRACE_EV_MARK, (mark), (arg))
+#define TRACE_TRIGGER(mark, arg)    Trace_Trigger((mark), (arg))
+#else
+#define TRACE_TASK_OUT(task)
+#define TRACE_TASK_IN(task)
+#define TRACE_QUEUE(type, q)
+#define TRACE_QUEUE_NAME(q, name)
+#define TRACE_ISR_ENTER(irq)
+#define TRACE_ISR_EXIT(irq)
+#define TRACE_MARK(mark, arg)
+#define TRACE_TRIGGER(mark, arg)
+#endif
+
+#endif /* INC_TRACE_H_ */
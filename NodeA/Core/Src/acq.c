@@ -0,0 +1,163 @@
+/*
+ * acq.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "acq.h"
+#include "co_od.h"
+#include "sensor_sim.h"
+#include "uart_log.h"
+#include "prof.h"
+#include <stdio.h>
+
+/* ── State ───────────────────────────────────── */
+static TIM_HandleTypeDef *_htim;
+static Dec_Window_t       Windows[ACQ_CH_COUNT];   /* Filled by the ISR */
+static uint32_t           _ticks;                  /* Samples since boot = ms */
+static Filt_t             Filters[ACQ_CH_COUNT];
+static uint8_t            AppliedKind[ACQ_CH_COUNT];
+static uint16_t           AppliedParam[ACQ_CH_COUNT];
+
+Acq_Stats_t Acq_Stats;
+
+/* Defaults: light smoothing that keeps short RPM peaks, slow
+ * low-pass on TEMP. Median rejects spikes — use it only where
+ * spikes are sensor glitches rather than events */
+Acq_FilterStage_t Acq_Filters[ACQ_CH_COUNT] = {
+    [ACQ_CH_RPM]  = { .kind = FILT_MOVAVG, .param = 4  },
+    [ACQ_CH_TEMP] = { .kind = FILT_IIR,    .param = 10 },
+};
+
+static const char *const ChannelNames[ACQ_CH_COUNT] = { "RPM", "TEMP" };
+
+/* ─────────────────────────────────────────────────
+ * Acq_Init — TIM3 already configured for ACQ_RATE_HZ
+ * ───────────────────────────────────────────────── */
+void Acq_Init(TIM_HandleTypeDef *htim)
+{
+    _htim = htim;
+
+    /* DWT cycle counter — filter cost per sample */
+    Prof_CycleCounterEnable();
+
+    for (int ch = 0; ch < ACQ_CH_COUNT; ch++)
+    {
+        Dec_Reset(&Windows[ch]);
+        AppliedKind[ch] = FILT_KIND_COUNT;     /* Force the first apply */
+    }
+    Acq_ApplyFilters();
+
+    HAL_TIM_Base_Start_IT(_htim);
+}
+
+/* ─────────────────────────────────────────────────
+ * Acq_ReadSensors (weak)
+ * No sensors on the board — the synthetic trace stands in
+ * ───────────────────────────────────────────────── */
+__weak void Acq_ReadSensors(int32_t out[ACQ_CH_COUNT])
+{
+    Sim_Sample(_ticks, OD_txPeriodMs, &out[ACQ_CH_RPM], &out[ACQ_CH_TEMP]);
+}
+
+/* ─────────────────────────────────────────────────
+ * Acq_SampleISR (TIM3 update)
+ * ───────────────────────────────────────────────── */
+void Acq_SampleISR(void)
+{
+    int32_t sample[ACQ_CH_COUNT];
+
+    Acq_ReadSensors(sample);
+
+    for (int ch = 0; ch < ACQ_CH_COUNT; ch++)
+    {
+        Acq_FilterStage_t *st = &Acq_Filters[ch];
+        uint32_t cycles = DWT->CYCCNT;
+
+        q15_t y = Filt_Process(&Filters[ch], (q15_t)__SSAT(sample[ch], 16));
+
+        cycles = DWT->CYCCNT - cycles;
+        st->cyclesAvg += ((int32_t)(cycles - st->cyclesAvg)) / 16;
+        if (cycles > st->cyclesMax) st->cyclesMax = cycles;
+
+        Dec_Push(&Windows[ch], y);
+    }
+
+    _ticks++;
+    Acq_Stats.samples++;
+}
+
+/* ─────────────────────────────────────────────────
+ * Acq_Take
+ * Hands over everything sampled since the last call and
+ * starts new windows — a few word copies with IRQs off
+ * ───────────────────────────────────────────────── */
+bool Acq_Take(Dec_Window_t out[ACQ_CH_COUNT])
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    for (int ch = 0; ch < ACQ_CH_COUNT; ch++)
+    {
+        out[ch] = Windows[ch];
+        Dec_Reset(&Windows[ch]);
+    }
+
+    __set_PRIMASK(primask);
+
+    Acq_Stats.takes++;
+    return out[0].count != 0;
+}
+
+/* ─────────────────────────────────────────────────
+ * Acq_ApplyFilters
+ * Task context. A changed kind/param rebuilds that
+ * channel's filter with the ISR held off
+ * ───────────────────────────────────────────────── */
+void Acq_ApplyFilters(void)
+{
+    for (int ch = 0; ch < ACQ_CH_COUNT; ch++)
+    {
+        Acq_FilterStage_t *st = &Acq_Filters[ch];
+
+        if (st->kind == AppliedKind[ch] && st->param == AppliedParam[ch]) continue;
+
+        AppliedKind[ch]  = st->kind;
+        AppliedParam[ch] = st->param;
+
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        st->active    = Filt_Configure(&Filters[ch], st->kind, st->param);
+        st->cyclesAvg = 0;
+        st->cyclesMax = 0;
+        __set_PRIMASK(primask);
+
+        if (st->active != st->kind)
+        {
+            UART_Log_Int("ACQ", "Invalid filter, using none on channel", ch);
+        }
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Acq_LogStats
+ * Filter cost per sample, to size the filter against
+ * the 1 ms sample budget (180k cycles)
+ * ───────────────────────────────────────────────── */
+void Acq_LogStats(void)
+{
+    char msg[80];
+
+    for (int ch = 0; ch < ACQ_CH_COUNT; ch++)
+    {
+        const Acq_FilterStage_t *st = &Acq_Filters[ch];
+
+        snprintf(msg, sizeof(msg), "%s %s/%u: avg %lu max %lu cyc/sample, %lu samples",
+                 ChannelNames[ch], Filt_Name(st->active), st->param,
+                 (unsigned long)st->cyclesAvg, (unsigned long)st->cyclesMax,
+                 (unsigned long)Acq_Stats.samples);
+        UART_Log("ACQ", msg);
+    }
+}
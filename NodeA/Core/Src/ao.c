@@ -0,0 +1,232 @@
+/*
+ * ao.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "ao.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "freertos_mpool.h"
+#include "uart_log.h"
+#include <stdio.h>
+
+/* Time events count kernel ticks as milliseconds */
+_Static_assert(configTICK_RATE_HZ == 1000, "AO time events assume a 1 ms tick");
+
+static const AO_Event_t EntryEvt = { AO_SIG_ENTRY, 0 };
+static const AO_Event_t ExitEvt  = { AO_SIG_EXIT,  0 };
+
+/* ── Event Pool Storage (static — no heap) ───── */
+static StaticMemPool_t  _poolCb;
+static uint32_t         _poolMem[MEMPOOL_ARR_SIZE(AO_EVENT_POOL_SIZE, AO_EVENT_SIZE) / 4];
+static osMemoryPoolId_t _pool;
+
+/* ─────────────────────────────────────────────────
+ * AO_Init — before any thread starts or event is posted
+ * ───────────────────────────────────────────────── */
+void AO_Init(void)
+{
+    static const osMemoryPoolAttr_t attr = {
+        .name    = "AO_EVENTS",
+        .cb_mem  = &_poolCb,
+        .cb_size = sizeof(_poolCb),
+        .mp_mem  = _poolMem,
+        .mp_size = sizeof(_poolMem),
+    };
+
+    _pool = osMemoryPoolNew(AO_EVENT_POOL_SIZE, AO_EVENT_SIZE, &attr);
+    if (_pool == NULL)
+    {
+        Error_Handler();
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Events
+ * ───────────────────────────────────────────────── */
+void *AO_NewEvent(uint16_t sig, size_t size)
+{
+    if (size > AO_EVENT_SIZE) return NULL;
+
+    AO_Event_t *e = osMemoryPoolAlloc(_pool, 0);
+    if (e != NULL)
+    {
+        e->sig    = sig;
+        e->pooled = 1;
+    }
+    return e;
+}
+
+__RAM_FUNC bool AO_Post(AO_Active_t *me, const AO_Event_t *e)
+{
+    AO_Msg_t msg = { me, e };
+
+    if (osMessageQueuePut(me->thread->queue, &msg, 0, 0) == osOK) return true;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    me->thread->stats.dropped++;
+    __set_PRIMASK(primask);
+
+    if (e->pooled) osMemoryPoolFree(_pool, (void *)e);
+    return false;
+}
+
+/* ─────────────────────────────────────────────────
+ * AO_Dispatch
+ * Runs the handler to completion, then any transition
+ * it asked for: exit the old state, enter the new one
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void AO_Dispatch(AO_Active_t *me, const AO_Event_t *e)
+{
+    me->next = NULL;
+    me->state(me, e);
+
+    while (me->next != NULL)
+    {
+        AO_State_t target = me->next;
+
+        me->next = NULL;
+        me->state(me, &ExitEvt);
+        me->state = target;
+        me->state(me, &EntryEvt);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Time Events
+ * A sorted list per thread — arming is a short walk,
+ * the thread only ever looks at the head
+ * ───────────────────────────────────────────────── */
+static void AO_Insert(AO_Thread_t *t, AO_TimeEvt_t *te)
+{
+    AO_TimeEvt_t **link = &t->timers;
+
+    while (*link != NULL && (int32_t)((*link)->due - te->due) <= 0)
+    {
+        link = &(*link)->next;
+    }
+    te->next  = *link;
+    *link     = te;
+    te->armed = true;
+}
+
+void AO_Disarm(AO_TimeEvt_t *te)
+{
+    if (!te->armed) return;
+
+    for (AO_TimeEvt_t **link = &te->ao->thread->timers; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == te)
+        {
+            *link = te->next;
+            break;
+        }
+    }
+    te->armed = false;
+}
+
+void AO_Arm(AO_TimeEvt_t *te, uint32_t delayMs, uint32_t intervalMs)
+{
+    AO_Disarm(te);
+
+    te->due      = osKernelGetTickCount() + delayMs;
+    te->interval = intervalMs;
+    AO_Insert(te->ao->thread, te);
+}
+
+/* Dispatches every due time event; returns ticks until the next */
+static uint32_t AO_FireDue(AO_Thread_t *t)
+{
+    uint32_t now = osKernelGetTickCount();
+
+    while (t->timers != NULL && (int32_t)(t->timers->due - now) <= 0)
+    {
+        AO_TimeEvt_t *te = t->timers;
+
+        t->timers = te->next;
+        te->armed = false;
+
+        if (te->interval != 0)
+        {
+            /* Re-armed before dispatch, so the handler may disarm it */
+            te->due += te->interval;
+            if ((int32_t)(te->due - now) <= 0) te->due = now + te->interval;
+            AO_Insert(t, te);
+        }
+
+        t->stats.timeouts++;
+        AO_Dispatch(te->ao, &te->evt);
+        now = osKernelGetTickCount();
+    }
+
+    return (t->timers != NULL) ? t->timers->due - now : osWaitForever;
+}
+
+/* ─────────────────────────────────────────────────
+ * AO_Run — the thread shared by one priority level.
+ * Enters each object's initial state, then sleeps on
+ * the queue until an event or the next time event
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void AO_Run(void *argument)
+{
+    AO_Thread_t *t = argument;
+    AO_Msg_t     msg;
+
+    for (uint8_t i = 0; i < t->count; i++)
+    {
+        AO_Dispatch(t->ao[i], &EntryEvt);
+    }
+
+    for (;;)
+    {
+        uint32_t timeout = AO_FireDue(t);
+
+        if (osMessageQueueGet(t->queue, &msg, NULL, timeout) != osOK) continue;
+
+        t->stats.dispatched++;
+
+        AO_Dispatch(msg.ao, msg.evt);
+        if (msg.evt->pooled) osMemoryPoolFree(_pool, (void *)msg.evt);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Setup — attach every object, then start the thread;
+ * both before the scheduler starts
+ * ───────────────────────────────────────────────── */
+void AO_Attach(AO_Thread_t *t, AO_Active_t *me)
+{
+    if (t->count == AO_MAX_PER_THREAD)
+    {
+        Error_Handler();
+    }
+    me->thread = t;
+    t->ao[t->count++] = me;
+}
+
+osThreadId_t AO_ThreadStart(AO_Thread_t *t, uint32_t depth,
+                            const osMessageQueueAttr_t *queueAttr, const osThreadAttr_t *threadAttr)
+{
+    t->queue = osMessageQueueNew(depth, sizeof(AO_Msg_t), queueAttr);
+    if (t->queue == NULL) return NULL;
+
+    t->id = osThreadNew(AO_Run, t, threadAttr);
+    return t->id;
+}
+
+/* ─────────────────────────────────────────────────
+ * AO_LogStats — one line per thread
+ * ───────────────────────────────────────────────── */
+void AO_LogStats(AO_Thread_t *t)
+{
+    char msg[96];
+
+    snprintf(msg, sizeof(msg), "%s events %lu timeouts %lu dropped %lu",
+             osThreadGetName(t->id), (unsigned long)t->stats.dispatched,
+             (unsigned long)t->stats.timeouts, (unsigned long)t->stats.dropped);
+    UART_Log("AO", msg);
+}
@@ -7,70 +7,291 @@
 
 
 #include "can_app.h"
+#include "can_bittiming.h"
 #include "uart_log.h"
+#include "timesync.h"
+#include "prof.h"
+#include "canopen.h"
+#include "main.h"
 
 /* ── Private Variables ───────────────────────── */
 static CAN_HandleTypeDef *_hcan;
+static uint8_t _nodeId;         /* Our node field in data / ACK IDs */
 static CAN_TxHeaderTypeDef TxHeader;
 static uint32_t TxMailbox;
 
-/* ── RX Queue ────────────────────────────────── */
-osMessageQueueId_t canRxQueueHandle;
+/* ── RX Active Object (frames posted by pointer) ── */
+static AO_Active_t *_rxAo;
+static uint16_t     _rxSig;
 
-/* ── Received Frame Structure ────────────────── */
+/* ── Remote-frame (RTR) Poll Responses ───────── */
 typedef struct {
     uint32_t id;
-    uint8_t  data[8];
     uint8_t  dlc;
-} CAN_Frame_t;
+    uint8_t  data[8];
+} CAN_PollSlot_t;
+
+static CAN_PollSlot_t PollSlots[CAN_POLL_MAX_SLOTS];
+static uint8_t        PollCount;
+static volatile uint32_t PollServed;
+static volatile uint32_t PollDropped;
+
+/* ── Frame Latency ───────────────────────────── */
+static const uint32_t LatEdgeUs[CAN_LAT_BUCKETS - 1] = { 50, 100, 250, 500, 1000, 2500, 5000 };
+
+CAN_Latency_t CAN_RxLatency;    /* Written by the RX active object only */
+CAN_Latency_t CAN_TxLatency;    /* Written by the TX interrupt only */
+
+static uint32_t         TxLoadUs[3];    /* Per mailbox, when it was loaded */
+static volatile uint32_t TxLoaded;      /* CAN_TX_MAILBOXx bits awaiting completion */
+
+/* ── Bitrate ─────────────────────────────────── */
+#define CAN_DRAIN_TRIES         10      /* 1 ms sleeps waiting for the TX mailboxes */
+
+_Static_assert(CAN_BT_NTQ(CAN_CLOCK_HZ, CAN_BITRATE, CAN_SAMPLE_POINT_PERMILLE) != 0U,
+               "CAN_BITRATE has no bit timing at CAN_CLOCK_HZ");
+
+CAN_Bitrate_t CAN_Bitrate;
 
 /* ─────────────────────────────────────────────────
- * CAN_App_Init
+ * CAN_LoadBitTiming
+ * Controller must be stopped. HAL_CAN_Init then only
+ * rewrites MCR/BTR — filters and interrupt enables stay
  * ───────────────────────────────────────────────── */
-void CAN_App_Init(CAN_HandleTypeDef *hcan)
+static HAL_StatusTypeDef CAN_LoadBitTiming(const CAN_BitTiming_t *bt)
 {
-    _hcan = hcan;
+    if (bt == NULL) return HAL_ERROR;
 
-    /* Create the RX queue */
-    canRxQueueHandle = osMessageQueueNew(10, sizeof(CAN_Frame_t), NULL);
+    _hcan->Init.Prescaler     = bt->prescaler;
+    _hcan->Init.TimeSeg1      = (uint32_t)(bt->tseg1 - 1U) << CAN_BTR_TS1_Pos;
+    _hcan->Init.TimeSeg2      = (uint32_t)(bt->tseg2 - 1U) << CAN_BTR_TS2_Pos;
+    _hcan->Init.SyncJumpWidth = (uint32_t)(bt->sjw - 1U)   << CAN_BTR_SJW_Pos;
 
-    /* Configure RX Filter — accept ALL messages */
+    return HAL_CAN_Init(_hcan);
+}
+
+/* ─────────────────────────────────────────────────
+ * RX filter banks — 16-bit scale, so a bank holds two
+ * id/mask pairs or four exact IDs. A frame nobody here
+ * handles never reaches FIFO0, and a bus backend that
+ * filters ahead of the controller sees the same rules
+ * ───────────────────────────────────────────────── */
+#define CAN_F16(id)             ((uint16_t)((id) << 5))     /* STID[10:0] RTR IDE EXID[17:15] */
+#define CAN_F16_RTR             0x0010U
+#define CAN_F16_IDE             0x0008U
+
+typedef struct {
+    uint16_t id;                /* CAN_F16 layout */
+    uint16_t mask;
+} CAN_IdMask_t;
+
+/* Standard IDs only; data and remote frames alike */
+#define CAN_MATCH(id, mask)     { CAN_F16(id), (uint16_t)(CAN_F16(mask) | CAN_F16_IDE) }
+
+static uint8_t _filterBank;
+
+static void CAN_FilterBank16(uint32_t mode, const uint16_t r[4])
+{
     CAN_FilterTypeDef filter;
-    filter.FilterBank           = 0;
-    filter.FilterMode           = CAN_FILTERMODE_IDMASK;
-    filter.FilterScale          = CAN_FILTERSCALE_32BIT;
-    filter.FilterIdHigh         = 0x0000;
-    filter.FilterIdLow          = 0x0000;
-    filter.FilterMaskIdHigh     = 0x0000;
-    filter.FilterMaskIdLow      = 0x0000;
+    filter.FilterBank           = _filterBank++;
+    filter.FilterMode           = mode;
+    filter.FilterScale          = CAN_FILTERSCALE_16BIT;
+    filter.FilterIdLow          = r[0];
+    filter.FilterMaskIdLow      = r[1];
+    filter.FilterIdHigh         = r[2];
+    filter.FilterMaskIdHigh     = r[3];
     filter.FilterFIFOAssignment = CAN_RX_FIFO0;
     filter.FilterActivation     = ENABLE;
+    filter.SlaveStartFilterBank = 14;   /* CAN2 keeps 14..27 */
     HAL_CAN_ConfigFilter(_hcan, &filter);
+}
+
+/* Two pairs to a bank; an odd count repeats the last pair */
+static void CAN_FilterMasks(const CAN_IdMask_t *m, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i += 2)
+    {
+        const CAN_IdMask_t *b = &m[(i + 1 < count) ? i + 1 : i];
+        uint16_t r[4] = { m[i].id, m[i].mask, b->id, b->mask };
+        CAN_FilterBank16(CAN_FILTERMODE_IDMASK, r);
+    }
+}
+
+/* Exact standard IDs, data frames only; four to a bank */
+static void CAN_FilterList(const uint16_t *ids, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i += 4)
+    {
+        uint16_t r[4];
+        for (uint8_t k = 0; k < 4; k++) r[k] = CAN_F16(ids[(i + k < count) ? i + k : count - 1]);
+        CAN_FilterBank16(CAN_FILTERMODE_IDLIST, r);
+    }
+}
+
+/* What HandleFrame and the ISR act on: this node's
+ * commands and subscriptions, SYNC and its follow-up,
+ * the controller heartbeat, SDO; and remote requests
+ * for this node's data IDs, which the ISR serves */
+static void CAN_ConfigFilters(void)
+{
+    const CAN_IdMask_t rtr = {
+        (uint16_t)(CAN_F16(CAN_ID_DATA(_nodeId, 0)) | CAN_F16_RTR),
+        (uint16_t)(CAN_F16(0x7F8U) | CAN_F16_RTR | CAN_F16_IDE)
+    };
+    const uint16_t ids[] = {
+        CAN_ID_CMD(_nodeId, CAN_FN_COMMAND),
+        CAN_ID_CMD(_nodeId, CAN_FN_SUBSCRIBE),
+        CAN_ID_SYNC,
+        CAN_ID_SYNC_FOLLOWUP,
+        CAN_ID_CTRL_HEARTBEAT,
+        CO_COBID_RSDO + CO_Node.nodeId,
+    };
+
+    _filterBank = 0;
+    CAN_FilterMasks(&rtr, 1);
+    CAN_FilterList(ids, sizeof(ids) / sizeof(ids[0]));
+}
+
+/* ─────────────────────────────────────────────────
+ * CAN_App_Init
+ * ───────────────────────────────────────────────── */
+void CAN_App_Init(CAN_HandleTypeDef *hcan, uint8_t nodeId)
+{
+    _hcan   = hcan;
+    _nodeId = nodeId & (CAN_MAX_SENSOR_NODES - 1);
+
+    /* DWT cycle counter — RX ISR cost measurement */
+    Prof_CycleCounterEnable();
+
+    /* Frame pool — the RX thread's queue holds one event per pool
+     * block, so the queue can never be the bottleneck */
+    CAN_Frame_PoolInit();
+
+    /* Bit timing from the solver replaces the CubeMX values */
+    if (HAL_RCC_GetPCLK1Freq() != CAN_CLOCK_HZ ||
+        CAN_LoadBitTiming(CAN_BitTiming_Find(CAN_BITRATE)) != HAL_OK)
+    {
+        Error_Handler();
+    }
+    CAN_Bitrate.request = CAN_BITRATE;
+    CAN_Bitrate.active  = CAN_BITRATE;
+
+    /* RX filter banks — only the IDs this node handles */
+    CAN_ConfigFilters();
 
     /* Start CAN */
     HAL_CAN_Start(_hcan);
 
-    /* Enable RX interrupt */
-    HAL_CAN_ActivateNotification(_hcan, CAN_IT_RX_FIFO0_MSG_PENDING);
+    /* Enable RX interrupt, TX-complete for SYNC time-stamping */
+    HAL_CAN_ActivateNotification(_hcan, CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_TX_MAILBOX_EMPTY);
 
     UART_Log("CAN", "Initialized OK");
 }
 
+/* ─────────────────────────────────────────────────
+ * Frame latency — one bucket scan per frame
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void CAN_LatencyRecord(CAN_Latency_t *lat, uint32_t us)
+{
+    uint8_t b = 0;
+
+    while (b < CAN_LAT_BUCKETS - 1 && us > LatEdgeUs[b]) b++;
+    lat->hist[b]++;
+    lat->count++;
+    lat->lastUs = us;
+    if (us > lat->maxUs) lat->maxUs = us;
+}
+
+/* Interrupts masked — the TX-complete interrupt must not see the bit first */
+__RAM_FUNC static void CAN_TxLoaded(uint32_t mailbox)
+{
+    TxLoadUs[__builtin_ctz(mailbox)] = TSync_LocalUs();
+    TxLoaded |= mailbox;
+}
+
+__RAM_FUNC static void CAN_TxDone(uint32_t mailbox, uint32_t nowUs)
+{
+    if ((TxLoaded & mailbox) == 0U) return;
+
+    TxLoaded &= ~mailbox;
+    CAN_LatencyRecord(&CAN_TxLatency, nowUs - TxLoadUs[__builtin_ctz(mailbox)]);
+}
+
+/* ─────────────────────────────────────────────────
+ * RX active object — frames the ISR does not handle
+ * itself are posted to it, sig as given here
+ * ───────────────────────────────────────────────── */
+void CAN_App_SetRxActive(AO_Active_t *ao, uint16_t sig)
+{
+    _rxAo  = ao;
+    _rxSig = sig;
+}
+
+/* ISR safe. On false the frame is still the caller's */
+__RAM_FUNC bool CAN_App_PostFrame(CAN_Frame_t *frame)
+{
+    if (_rxAo == NULL) return false;
+
+    frame->evt.sig    = _rxSig;
+    frame->evt.pooled = 0;
+    return AO_Post(_rxAo, &frame->evt);
+}
+
+/* Called by the RX active object for every frame dispatched to it */
+__RAM_FUNC void CAN_App_RxDequeued(const CAN_Frame_t *frame)
+{
+    CAN_LatencyRecord(&CAN_RxLatency, TSync_LocalUs() - frame->rxUs);
+}
+
 /* ─────────────────────────────────────────────────
  * Internal helper — sends a CAN frame
  * ───────────────────────────────────────────────── */
-static void CAN_Send(uint32_t id, uint8_t *data, uint8_t len)
+static HAL_StatusTypeDef CAN_SendTracked(uint32_t id, const uint8_t *data, uint8_t len,
+                                         uint32_t *mailbox)
 {
+    PROF_BEGIN(PROF_CAN_SEND);
+
     TxHeader.StdId              = id;
     TxHeader.IDE                = CAN_ID_STD;
     TxHeader.RTR                = CAN_RTR_DATA;
     TxHeader.DLC                = len;
     TxHeader.TransmitGlobalTime = DISABLE;
 
-    if (HAL_CAN_AddTxMessage(_hcan, &TxHeader, data, &TxMailbox) != HAL_OK)
+    /* The RX ISR may also load a mailbox (RTR replies) — keep it out */
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    HAL_StatusTypeDef status = HAL_CAN_AddTxMessage(_hcan, &TxHeader, (uint8_t *)data, mailbox);
+    if (status == HAL_OK) CAN_TxLoaded(*mailbox);
+    __set_PRIMASK(primask);
+    PROF_END(PROF_CAN_SEND);
+
+    if (status != HAL_OK)
     {
         UART_Log("CAN", "TX ERROR");
     }
+    return status;
+}
+
+static HAL_StatusTypeDef CAN_Send(uint32_t id, const uint8_t *data, uint8_t len)
+{
+    return CAN_SendTracked(id, data, len, &TxMailbox);
+}
+
+/* ─────────────────────────────────────────────────
+ * CAN_App_Transmit
+ * Raw frame TX for protocol layers (CANopen etc.)
+ * No per-frame UART log — used on high-rate paths
+ * ───────────────────────────────────────────────── */
+HAL_StatusTypeDef CAN_App_Transmit(uint32_t id, const uint8_t *data, uint8_t len)
+{
+    return CAN_Send(id, data, len);
+}
+
+/* As above, but reports which TX mailbox (CAN_TX_MAILBOXx) took the frame */
+HAL_StatusTypeDef CAN_App_TransmitTracked(uint32_t id, const uint8_t *data, uint8_t len,
+                                          uint32_t *mailbox)
+{
+    return CAN_SendTracked(id, data, len, mailbox);
 }
 
 /* ─────────────────────────────────────────────────
@@ -81,7 +302,7 @@ void CAN_App_TransmitRPM(uint16_t rpm)
     uint8_t data[2];
     data[0] = (rpm >> 8) & 0xFF;
     data[1] = rpm & 0xFF;
-    CAN_Send(CAN_ID_RPM, data, 2);
+    CAN_Send(CAN_ID_DATA(_nodeId, CAN_FN_RPM), data, 2);
     UART_Log_Int("CAN_TX", "RPM", rpm);
 }
 
@@ -90,22 +311,43 @@ void CAN_App_TransmitTemp(int16_t temp)
     uint8_t data[2];
     data[0] = (temp >> 8) & 0xFF;
     data[1] = temp & 0xFF;
-    CAN_Send(CAN_ID_TEMP, data, 2);
+    CAN_Send(CAN_ID_DATA(_nodeId, CAN_FN_TEMP), data, 2);
     UART_Log_Int("CAN_TX", "TEMP", temp);
 }
 
+/* Four big-endian 16-bit values — RPM unsigned, TEMP signed */
+void CAN_App_TransmitAggregate(uint8_t signal, int32_t min, int32_t max, int32_t mean, int32_t last)
+{
+    const int32_t values[4] = { min, max, mean, last };
+    uint8_t data[8];
+    char msg[64];
+
+    for (int i = 0; i < 4; i++)
+    {
+        data[2 * i]     = (values[i] >> 8) & 0xFF;
+        data[2 * i + 1] = values[i] & 0xFF;
+    }
+
+    CAN_Send(CAN_ID_DATA(_nodeId, signal == CAN_SIG_RPM ? CAN_FN_RPM_AGG : CAN_FN_TEMP_AGG), data, 8);
+
+    snprintf(msg, sizeof(msg), "%s %ld..%ld mean %ld last %ld",
+             signal == CAN_SIG_RPM ? "RPM" : "TEMP",
+             (long)min, (long)max, (long)mean, (long)last);
+    UART_Log("CAN_TX", msg);
+}
+
 void CAN_App_TransmitHeartbeat(void)
 {
     uint8_t data[1] = {0xAA};  // Arbitrary alive signal
-    CAN_Send(CAN_ID_HEARTBEAT, data, 1);
+    CAN_Send(CAN_ID_DATA(_nodeId, CAN_FN_HEARTBEAT), data, 1);
     UART_Log("CAN_TX", "Heartbeat");
 }
 
-void CAN_App_TransmitCommand(uint8_t cmdCode)
+void CAN_App_TransmitCommand(uint8_t node, uint8_t cmdCode)
 {
     uint8_t data[1];
     data[0] = cmdCode;
-    CAN_Send(CAN_ID_COMMAND, data, 1);
+    CAN_Send(CAN_ID_CMD(node, CAN_FN_COMMAND), data, 1);
     UART_Log_Int("CAN_TX", "COMMAND", cmdCode);
 }
 
@@ -113,23 +355,321 @@ void CAN_App_TransmitAck(uint8_t ackedCmd)
 {
     uint8_t data[1];
     data[0] = ackedCmd;
-    CAN_Send(CAN_ID_ACK, data, 1);
+    CAN_Send(CAN_ID_CMD(_nodeId, CAN_FN_ACK), data, 1);
     UART_Log_Int("CAN_TX", "ACK", ackedCmd);
 }
 
+void CAN_App_TransmitSubscribe(uint8_t node, uint8_t subscriberId, uint8_t signal, uint16_t periodMs)
+{
+    uint8_t data[4];
+    data[0] = subscriberId;
+    data[1] = signal;
+    data[2] = (periodMs >> 8) & 0xFF;
+    data[3] = periodMs & 0xFF;
+    CAN_Send(CAN_ID_CMD(node, CAN_FN_SUBSCRIBE), data, 4);
+    UART_Log_Int("CAN_TX", "SUBSCRIBE signal", signal);
+}
+
+void CAN_App_TransmitCtrlHeartbeat(uint8_t nodeId)
+{
+    uint8_t data[1];
+    data[0] = nodeId;
+    CAN_Send(CAN_ID_CTRL_HEARTBEAT, data, 1);
+}
+
+/* ─────────────────────────────────────────────────
+ * Remote-frame polling
+ * ───────────────────────────────────────────────── */
+
+/* Register (first call) or refresh the payload returned when a
+ * remote frame for this ID arrives. Called from task context. */
+void CAN_App_ServeRemote(uint32_t id, const uint8_t *data, uint8_t len)
+{
+    uint8_t i;
+
+    for (i = 0; i < PollCount; i++)
+    {
+        if (PollSlots[i].id == id) break;
+    }
+    if (i == CAN_POLL_MAX_SLOTS)
+    {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    PollSlots[i].id  = id;
+    PollSlots[i].dlc = len;
+    memcpy(PollSlots[i].data, data, len);
+    if (i == PollCount) PollCount++;
+    __set_PRIMASK(primask);
+}
+
+void CAN_App_LatchRPM(uint16_t rpm)
+{
+    uint8_t data[2];
+    data[0] = (rpm >> 8) & 0xFF;
+    data[1] = rpm & 0xFF;
+    CAN_App_ServeRemote(CAN_ID_DATA(_nodeId, CAN_FN_RPM), data, 2);
+}
+
+void CAN_App_LatchTemp(int16_t temp)
+{
+    uint8_t data[2];
+    data[0] = (temp >> 8) & 0xFF;
+    data[1] = temp & 0xFF;
+    CAN_App_ServeRemote(CAN_ID_DATA(_nodeId, CAN_FN_TEMP), data, 2);
+}
+
+/* Ask another node for a signal — the answer arrives as a normal data frame */
+void CAN_App_RequestRemote(uint32_t id, uint8_t dlc)
+{
+    CAN_TxHeaderTypeDef hdr;
+    uint8_t dummy[8] = {0};
+
+    hdr.StdId              = id;
+    hdr.IDE                = CAN_ID_STD;
+    hdr.RTR                = CAN_RTR_REMOTE;
+    hdr.DLC                = dlc;
+    hdr.TransmitGlobalTime = DISABLE;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    HAL_StatusTypeDef status = HAL_CAN_AddTxMessage(_hcan, &hdr, dummy, &TxMailbox);
+    if (status == HAL_OK) CAN_TxLoaded(TxMailbox);
+    __set_PRIMASK(primask);
+
+    if (status != HAL_OK)
+    {
+        UART_Log("CAN", "RTR TX ERROR");
+    }
+}
+
+void CAN_App_GetPollStats(uint32_t *served, uint32_t *dropped)
+{
+    *served  = PollServed;
+    *dropped = PollDropped;
+}
+
+/* Answer a remote frame straight from the ISR — bounded by PollCount */
+__RAM_FUNC static void CAN_ServeRemoteFromISR(CAN_HandleTypeDef *hcan, uint32_t id)
+{
+    for (uint8_t i = 0; i < PollCount; i++)
+    {
+        if (PollSlots[i].id == id)
+        {
+            CAN_TxHeaderTypeDef hdr;
+            uint32_t mailbox;
+
+            hdr.StdId              = id;
+            hdr.IDE                = CAN_ID_STD;
+            hdr.RTR                = CAN_RTR_DATA;
+            hdr.DLC                = PollSlots[i].dlc;
+            hdr.TransmitGlobalTime = DISABLE;
+
+            if (HAL_CAN_AddTxMessage(hcan, &hdr, PollSlots[i].data, &mailbox) == HAL_OK)
+            {
+                CAN_TxLoaded(mailbox);
+                PollServed++;
+            }
+            else
+                PollDropped++;      /* All three mailboxes busy */
+            return;
+        }
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * ISR fast path hooks (weak — default: everything queued)
+ * A node overrides these to consume "pure data" frames
+ * in the ISR instead of paying for the task hop
+ * ───────────────────────────────────────────────── */
+__weak bool CAN_App_RxIsFastPath(uint32_t id)
+{
+    return false;
+}
+
+__weak void CAN_App_RxFastPathISR(uint32_t id, const uint8_t *data, uint8_t dlc, uint32_t rxUs)
+{
+}
+
+/* ─────────────────────────────────────────────────
+ * CAN_App_SetBitrate
+ * Re-initialises the controller at a supported bitrate.
+ * Nodes still on the old rate see only error frames until
+ * they switch too
+ * ───────────────────────────────────────────────── */
+HAL_StatusTypeDef CAN_App_SetBitrate(uint32_t bitrate)
+{
+    const CAN_BitTiming_t *bt = CAN_BitTiming_Find(bitrate);
+    if (bt == NULL) return HAL_ERROR;
+
+    /* Let queued frames out first — usually the SDO answer to
+     * the write that asked for the switch. Runs on the RX thread,
+     * so sleep between polls rather than spin */
+    for (uint8_t tries = 0; tries < CAN_DRAIN_TRIES && HAL_CAN_GetTxMailboxesFreeLevel(_hcan) < 3; tries++)
+    {
+        osDelay(1);
+    }
+
+    HAL_CAN_Stop(_hcan);
+    HAL_StatusTypeDef status = CAN_LoadBitTiming(bt);
+    HAL_CAN_Start(_hcan);
+
+    if (status == HAL_OK)
+    {
+        CAN_Bitrate.active = bitrate;
+        UART_Log_Int("CAN", "Bitrate", (int)bitrate);
+    }
+    return status;
+}
+
+/* Called after each received frame — picks up OD writes to 0x2600 */
+void CAN_App_ApplyBitrate(void)
+{
+    if (CAN_Bitrate.request == CAN_Bitrate.active) return;
+
+    if (CAN_App_SetBitrate(CAN_Bitrate.request) != HAL_OK)
+    {
+        UART_Log_Int("CAN", "Unsupported bitrate", (int)CAN_Bitrate.request);
+        CAN_Bitrate.request = CAN_Bitrate.active;
+    }
+}
+
+/* RX callback cost — compare builds with and without the RAM hot path.
+ * Read from the PROF_CAN_RX_ISR site, so a Debug build only */
+void CAN_App_LogRxIsrStats(void)
+{
+#if PROF_ENABLE
+    Prof_Stats_t s;
+    char msg[80];
+
+    Prof_Get(PROF_CAN_RX_ISR, &s);
+    if (s.count == 0U) return;
+
+    snprintf(msg, sizeof(msg), "RX ISR mean %lu max %lu cyc, %lu frames",
+             (unsigned long)(s.total / s.count), (unsigned long)s.max, (unsigned long)s.count);
+    UART_Log("CANISR", msg);
+#endif
+}
+
+/* Frame latency — count, last and max-ever, then the buckets on a
+ * second line so neither can outgrow the UART_Log buffer */
+void CAN_App_LogLatency(void)
+{
+    const CAN_Latency_t *lat[2] = { &CAN_RxLatency, &CAN_TxLatency };
+    const char *name[2] = { "RX isr->task", "TX load->done" };
+    char msg[112];
+
+    for (int i = 0; i < 2; i++)
+    {
+        const uint32_t *h = lat[i]->hist;
+
+        snprintf(msg, sizeof(msg), "%s n %lu, last %luus, max %luus", name[i],
+                 (unsigned long)lat[i]->count, (unsigned long)lat[i]->lastUs,
+                 (unsigned long)lat[i]->maxUs);
+        UART_Log("CANLAT", msg);
+
+        snprintf(msg, sizeof(msg), "%s hist %lu/%lu/%lu/%lu/%lu/%lu/%lu/%lu", name[i],
+                 (unsigned long)h[0], (unsigned long)h[1], (unsigned long)h[2], (unsigned long)h[3],
+                 (unsigned long)h[4], (unsigned long)h[5], (unsigned long)h[6], (unsigned long)h[7]);
+        UART_Log("CANLAT", msg);
+    }
+}
+
 /* ─────────────────────────────────────────────────
  * CAN RX Interrupt Callback
+ * The ID is peeked from the FIFO mailbox first, so frames
+ * handled right here never touch the pool; the rest are
+ * read once, straight into a pool block, and only the
+ * pointer is queued
  * ───────────────────────────────────────────────── */
-void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
+__RAM_FUNC void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)
 {
+    uint32_t rxUs = TSync_LocalUs();    /* Stamp first — before any other work */
+    PROF_BEGIN(PROF_CAN_RX_ISR);
+
     CAN_RxHeaderTypeDef RxHeader;
-    CAN_Frame_t frame;
+    CAN_Frame_t *frame = NULL;
+    uint8_t scratch[8];
+    uint8_t *data = scratch;
+
+    uint32_t rir    = hcan->Instance->sFIFOMailBox[CAN_RX_FIFO0].RIR;
+    uint32_t peekId = (rir & CAN_RI0R_STID) >> CAN_TI0R_STID_Pos;
+    bool     inIsr  = (rir & CAN_RI0R_IDE) == 0 &&
+                      ((rir & CAN_RI0R_RTR) != 0 || peekId == CAN_ID_SYNC ||
+                       CAN_App_RxIsFastPath(peekId));
+
+    if (!inIsr)
+    {
+        /* Pool empty — still drain the FIFO below */
+        frame = CAN_Frame_Alloc();
+        if (frame != NULL) data = frame->data;
+    }
 
-    if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &RxHeader, frame.data) == HAL_OK)
+    if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &RxHeader, data) != HAL_OK)
     {
-        frame.id  = RxHeader.StdId;
-        frame.dlc = RxHeader.DLC;
+        if (frame != NULL) CAN_Frame_Free(frame);
+        return;
+    }
 
-        osMessageQueuePut(canRxQueueHandle, &frame, 0, 0);
+    if (RxHeader.RTR == CAN_RTR_REMOTE)
+    {
+        CAN_ServeRemoteFromISR(hcan, RxHeader.StdId);
+    }
+    else if (RxHeader.StdId == CAN_ID_SYNC)
+    {
+        TSync_OnSyncRxISR(data, rxUs);
+    }
+    else if (inIsr)
+    {
+        CAN_App_RxFastPathISR(RxHeader.StdId, data, RxHeader.DLC, rxUs);
     }
+    else if (frame != NULL)
+    {
+        frame->id   = RxHeader.StdId;
+        frame->dlc  = RxHeader.DLC;
+        frame->rxUs = rxUs;
+
+        if (CAN_App_PostFrame(frame))
+        {
+            frame = NULL;   /* Ownership passed to the RX active object */
+        }
+        else
+        {
+            CAN_FramePoolStats.queueFull++;
+        }
+    }
+
+    if (frame != NULL) CAN_Frame_Free(frame);
+
+    PROF_END(PROF_CAN_RX_ISR);
+}
+
+/* ─────────────────────────────────────────────────
+ * CAN TX-complete Callbacks — SYNC egress time-stamp,
+ * TX latency
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    uint32_t nowUs = TSync_LocalUs();
+
+    TSync_OnTxCompleteISR(CAN_TX_MAILBOX0, nowUs);
+    CAN_TxDone(CAN_TX_MAILBOX0, nowUs);
+}
+
+__RAM_FUNC void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    uint32_t nowUs = TSync_LocalUs();
+
+    TSync_OnTxCompleteISR(CAN_TX_MAILBOX1, nowUs);
+    CAN_TxDone(CAN_TX_MAILBOX1, nowUs);
+}
+
+__RAM_FUNC void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+    uint32_t nowUs = TSync_LocalUs();
+
+    TSync_OnTxCompleteISR(CAN_TX_MAILBOX2, nowUs);
+    CAN_TxDone(CAN_TX_MAILBOX2, nowUs);
 }
@@ -0,0 +1,35 @@
+/*
+ * can_bittiming.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "can_bittiming.h"
+
+#define CAN_BT_SOLVABLE(br) \
+    (CAN_BT_NTQ(CAN_CLOCK_HZ, br, CAN_SAMPLE_POINT_PERMILLE) != 0U)
+
+_Static_assert(CAN_BT_SOLVABLE(125000U),  "125 kbit/s not reachable from CAN_CLOCK_HZ");
+_Static_assert(CAN_BT_SOLVABLE(250000U),  "250 kbit/s not reachable from CAN_CLOCK_HZ");
+_Static_assert(CAN_BT_SOLVABLE(500000U),  "500 kbit/s not reachable from CAN_CLOCK_HZ");
+_Static_assert(CAN_BT_SOLVABLE(1000000U), "1 Mbit/s not reachable from CAN_CLOCK_HZ");
+
+const CAN_BitTiming_t CAN_BitTimings[] = {
+    CAN_BIT_TIMING(CAN_CLOCK_HZ, 125000U,  CAN_SAMPLE_POINT_PERMILLE),
+    CAN_BIT_TIMING(CAN_CLOCK_HZ, 250000U,  CAN_SAMPLE_POINT_PERMILLE),
+    CAN_BIT_TIMING(CAN_CLOCK_HZ, 500000U,  CAN_SAMPLE_POINT_PERMILLE),
+    CAN_BIT_TIMING(CAN_CLOCK_HZ, 1000000U, CAN_SAMPLE_POINT_PERMILLE),
+};
+
+const uint8_t CAN_BitTimingCount = sizeof(CAN_BitTimings) / sizeof(CAN_BitTimings[0]);
+
+const CAN_BitTiming_t *CAN_BitTiming_Find(uint32_t bitrate)
+{
+    for (uint8_t i = 0; i < CAN_BitTimingCount; i++)
+    {
+        if (CAN_BitTimings[i].bitrate == bitrate) return &CAN_BitTimings[i];
+    }
+    return NULL;
+}
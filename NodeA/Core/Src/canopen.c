@@ -0,0 +1,583 @@
+/*
+ * canopen.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "canopen.h"
+#include "can_app.h"
+#include "uart_log.h"
+#include "main.h"
+#include "cmsis_os.h"
+#include "FreeRTOS.h"
+#include <string.h>
+
+/* ── Configuration ───────────────────────────── */
+#define CO_MAX_TPDO             4
+#define CO_SDO_BUF_SIZE         32      /* Largest OD object */
+#define CO_SDO_TIMEOUT_MS       1000
+#define CO_IDLE_POLL_MS         100     /* Re-check when no TPDO is enabled */
+
+/* ── PDO Scratch Byte (target of unused plan slots) ── */
+uint8_t CO_PDO_Scratch;
+
+/* ── SDO Transfer State ──────────────────────── */
+typedef struct {
+    const CO_OD_Entry_t *entry;
+    uint16_t size;
+    uint16_t offset;
+    uint32_t lastMs;
+    uint8_t  toggle;
+    bool     upload;
+    bool     active;
+    uint8_t  buf[CO_SDO_BUF_SIZE];
+} CO_SDO_Transfer_t;
+
+/* Frames arrive on the RX thread, the timeout runs on the one that
+ * calls CANopen_Process — the mutex covers _sdo and _nowMs. Each
+ * SDO frame stamps _nowMs itself, so lastMs doesn't depend on how
+ * often CANopen_Process runs */
+static CO_SDO_Transfer_t _sdo;
+static StaticSemaphore_t _sdoMutexCb;
+static osMutexId_t       _sdoMutex;
+
+/* ── TPDO Scheduling ─────────────────────────── */
+static uint32_t _tpdoDue[CO_MAX_TPDO];
+static uint16_t _tpdoPeriod[CO_MAX_TPDO];
+static uint32_t _nowMs;
+
+/* ─────────────────────────────────────────────────
+ * Little-endian helpers
+ * ───────────────────────────────────────────────── */
+static uint32_t CO_GetU32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void CO_PutU32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+/* ─────────────────────────────────────────────────
+ * Object Dictionary lookup — binary search on key
+ * ───────────────────────────────────────────────── */
+static uint16_t CO_LowerBound(uint32_t key)
+{
+    uint16_t lo = 0;
+    uint16_t hi = CO_Node.odCount;
+
+    while (lo < hi)
+    {
+        uint16_t mid = (lo + hi) / 2;
+        if (CO_Node.od[mid].key < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+const CO_OD_Entry_t *CANopen_Find(uint16_t index, uint8_t sub)
+{
+    uint32_t key = CO_KEY(index, sub);
+    uint16_t pos = CO_LowerBound(key);
+
+    if (pos < CO_Node.odCount && CO_Node.od[pos].key == key)
+    {
+        return &CO_Node.od[pos];
+    }
+    return NULL;
+}
+
+static uint32_t CO_LookupAbort(uint16_t index)
+{
+    uint16_t pos = CO_LowerBound(CO_KEY(index, 0));
+
+    if (pos < CO_Node.odCount && (CO_Node.od[pos].key >> 8) == index)
+    {
+        return CO_SDO_ABORT_NO_SUB;
+    }
+    return CO_SDO_ABORT_NO_OBJECT;
+}
+
+static uint16_t CO_EntryLength(const CO_OD_Entry_t *entry)
+{
+    if (entry->attr & CO_ATTR_STR)
+    {
+        const char *s = (const char *)entry->data;
+        uint16_t len = 0;
+        while (len < entry->size && s[len] != '\0') len++;
+        return len;
+    }
+    return entry->size;
+}
+
+/* ─────────────────────────────────────────────────
+ * Range check of a downloaded value — entries without
+ * a row take any value; the node's check comes last
+ * ───────────────────────────────────────────────── */
+static bool CO_InRange(const CO_OD_Entry_t *entry, const uint8_t *src, uint16_t len)
+{
+    for (uint8_t i = 0; i < CO_Node.rangeCount; i++)
+    {
+        const CO_OD_Range_t *range = &CO_Node.ranges[i];
+        if (range->key != entry->key) continue;
+
+        uint32_t raw = 0;
+        for (uint16_t b = 0; b < len && b < 4; b++)
+        {
+            raw |= (uint32_t)src[b] << (8 * b);
+        }
+        if (range->isSigned && len < 4 && (raw & (1UL << (8 * len - 1))))
+        {
+            raw |= ~0UL << (8 * len);     /* Sign-extend */
+        }
+
+        int64_t value = range->isSigned ? (int64_t)(int32_t)raw : (int64_t)raw;
+        if (value < range->min || value > range->max) return false;
+        break;
+    }
+    return CO_Node.check == NULL || CO_Node.check(entry, src, len);
+}
+
+/* ─────────────────────────────────────────────────
+ * Commit downloaded bytes into the OD object
+ * Scheduler locked so readers never see a half-written value;
+ * the node is told afterwards
+ * ───────────────────────────────────────────────── */
+static void CO_Commit(const CO_OD_Entry_t *entry, const uint8_t *src, uint16_t len)
+{
+    uint8_t *dst = (uint8_t *)entry->data;
+
+    osKernelLock();
+    memcpy(dst, src, len);
+    if (entry->attr & CO_ATTR_STR)
+    {
+        memset(dst + len, 0, entry->size - len);
+    }
+    osKernelUnlock();
+
+    if (CO_Node.written != NULL)
+    {
+        CO_Node.written(entry);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * PDO pack / unpack — eight unconditional byte moves
+ * ───────────────────────────────────────────────── */
+static void CO_PackPDO(const CO_PDO_Plan_t *plan, uint8_t *frame)
+{
+    uint8_t *const *b = plan->bytes;
+
+    frame[0] = *b[0]; frame[1] = *b[1]; frame[2] = *b[2]; frame[3] = *b[3];
+    frame[4] = *b[4]; frame[5] = *b[5]; frame[6] = *b[6]; frame[7] = *b[7];
+}
+
+static void CO_UnpackPDO(const CO_PDO_Plan_t *plan, const uint8_t *frame)
+{
+    uint8_t *const *b = plan->bytes;
+
+    *b[0] = frame[0]; *b[1] = frame[1]; *b[2] = frame[2]; *b[3] = frame[3];
+    *b[4] = frame[4]; *b[5] = frame[5]; *b[6] = frame[6]; *b[7] = frame[7];
+}
+
+void CANopen_SendTPDO(uint8_t n)
+{
+    uint8_t frame[8];
+    const CO_PDO_Plan_t *plan = &CO_Node.tpdo[n];
+
+    CO_PackPDO(plan, frame);
+    CAN_App_Transmit(plan->cobId, frame, plan->dlc);
+}
+
+/* ─────────────────────────────────────────────────
+ * SDO server
+ * ───────────────────────────────────────────────── */
+static void CO_SDO_Send(uint8_t *resp)
+{
+    CAN_App_Transmit(CO_COBID_TSDO + CO_Node.nodeId, resp, 8);
+}
+
+static void CO_SDO_Abort(uint32_t key, uint32_t code)
+{
+    uint8_t resp[8];
+
+    resp[0] = 0x80;
+    resp[1] = (key >> 8) & 0xFF;
+    resp[2] = (key >> 16) & 0xFF;
+    resp[3] = key & 0xFF;
+    CO_PutU32(&resp[4], code);
+    CO_SDO_Send(resp);
+
+    _sdo.active = false;
+    UART_Log_Int("SDO", "Abort", (int)code);
+}
+
+static void CO_SDO_InitiateDownload(const uint8_t *req, const CO_OD_Entry_t *entry)
+{
+    uint8_t  resp[8] = {0x60, req[1], req[2], req[3], 0, 0, 0, 0};
+    bool     sizeGiven = req[0] & 0x01;
+    bool     strType   = entry->attr & CO_ATTR_STR;
+    uint16_t len;
+
+    if (req[0] & 0x02)
+    {
+        /* Expedited — up to four bytes in this frame */
+        len = sizeGiven ? 4 - ((req[0] >> 2) & 0x03) : entry->size;
+        if ((strType && len > entry->size) || (!strType && len != entry->size) || len > 4)
+        {
+            CO_SDO_Abort(entry->key, CO_SDO_ABORT_TYPE_LEN);
+            return;
+        }
+        if (!CO_InRange(entry, &req[4], len))
+        {
+            CO_SDO_Abort(entry->key, CO_SDO_ABORT_RANGE);
+            return;
+        }
+        CO_Commit(entry, &req[4], len);
+        CO_SDO_Send(resp);
+        UART_Log_Int("SDO", "Write index", (int)(entry->key >> 8));
+        return;
+    }
+
+    /* Segmented — stage in the transfer buffer, commit on last segment.
+     * The declared size is checked at full width, then narrowed */
+    uint32_t size = sizeGiven ? CO_GetU32(&req[4]) : entry->size;
+    if ((strType && size > entry->size) || (!strType && size != entry->size) || size > CO_SDO_BUF_SIZE)
+    {
+        CO_SDO_Abort(entry->key, CO_SDO_ABORT_TYPE_LEN);
+        return;
+    }
+    len = (uint16_t)size;
+
+    _sdo.entry  = entry;
+    _sdo.size   = len;
+    _sdo.offset = 0;
+    _sdo.toggle = 0;
+    _sdo.upload = false;
+    _sdo.active = true;
+    _sdo.lastMs = _nowMs;
+    CO_SDO_Send(resp);
+}
+
+static void CO_SDO_DownloadSegment(const uint8_t *req)
+{
+    uint8_t resp[8] = {0};
+    uint8_t toggle  = (req[0] >> 4) & 0x01;
+    uint8_t n       = 7 - ((req[0] >> 1) & 0x07);
+    bool    last    = req[0] & 0x01;
+
+    if (!_sdo.active || _sdo.upload)
+    {
+        CO_SDO_Abort(_sdo.active ? _sdo.entry->key : 0, CO_SDO_ABORT_CMD);
+        return;
+    }
+    if (toggle != _sdo.toggle)
+    {
+        CO_SDO_Abort(_sdo.entry->key, CO_SDO_ABORT_TOGGLE);
+        return;
+    }
+    if (_sdo.offset + n > _sdo.size)
+    {
+        CO_SDO_Abort(_sdo.entry->key, CO_SDO_ABORT_TYPE_LEN);
+        return;
+    }
+
+    memcpy(&_sdo.buf[_sdo.offset], &req[1], n);
+    _sdo.offset += n;
+    _sdo.toggle ^= 1;
+    _sdo.lastMs  = _nowMs;
+
+    if (last)
+    {
+        if (_sdo.offset != _sdo.size)
+        {
+            CO_SDO_Abort(_sdo.entry->key, CO_SDO_ABORT_TYPE_LEN);
+            return;
+        }
+        if (!CO_InRange(_sdo.entry, _sdo.buf, _sdo.size))
+        {
+            CO_SDO_Abort(_sdo.entry->key, CO_SDO_ABORT_RANGE);
+            return;
+        }
+        CO_Commit(_sdo.entry, _sdo.buf, _sdo.size);
+        _sdo.active = false;
+        UART_Log_Int("SDO", "Write index", (int)(_sdo.entry->key >> 8));
+    }
+
+    resp[0] = 0x20 | (toggle << 4);
+    CO_SDO_Send(resp);
+}
+
+static void CO_SDO_InitiateUpload(const uint8_t *req, const CO_OD_Entry_t *entry)
+{
+    uint8_t  resp[8] = {0, req[1], req[2], req[3], 0, 0, 0, 0};
+    uint16_t len = CO_EntryLength(entry);
+
+    if (len <= 4)
+    {
+        /* Expedited, size indicated */
+        resp[0] = 0x43 | ((4 - len) << 2);
+        osKernelLock();
+        memcpy(&resp[4], entry->data, len);
+        osKernelUnlock();
+        CO_SDO_Send(resp);
+        return;
+    }
+
+    /* Segmented — snapshot the object so segments stay consistent */
+    osKernelLock();
+    memcpy(_sdo.buf, entry->data, len);
+    osKernelUnlock();
+
+    _sdo.entry  = entry;
+    _sdo.size   = len;
+    _sdo.offset = 0;
+    _sdo.toggle = 0;
+    _sdo.upload = true;
+    _sdo.active = true;
+    _sdo.lastMs = _nowMs;
+
+    resp[0] = 0x41;
+    CO_PutU32(&resp[4], len);
+    CO_SDO_Send(resp);
+}
+
+static void CO_SDO_UploadSegment(const uint8_t *req)
+{
+    uint8_t resp[8] = {0};
+    uint8_t toggle  = (req[0] >> 4) & 0x01;
+    uint8_t n;
+    bool    last;
+
+    if (!_sdo.active || !_sdo.upload)
+    {
+        CO_SDO_Abort(_sdo.active ? _sdo.entry->key : 0, CO_SDO_ABORT_CMD);
+        return;
+    }
+    if (toggle != _sdo.toggle)
+    {
+        CO_SDO_Abort(_sdo.entry->key, CO_SDO_ABORT_TOGGLE);
+        return;
+    }
+
+    n    = (_sdo.size - _sdo.offset > 7) ? 7 : (uint8_t)(_sdo.size - _sdo.offset);
+    last = (_sdo.offset + n) == _sdo.size;
+
+    resp[0] = (toggle << 4) | ((7 - n) << 1) | (last ? 0x01 : 0x00);
+    memcpy(&resp[1], &_sdo.buf[_sdo.offset], n);
+    _sdo.offset += n;
+    _sdo.toggle ^= 1;
+    _sdo.lastMs  = _nowMs;
+    if (last)
+    {
+        _sdo.active = false;
+    }
+
+    CO_SDO_Send(resp);
+}
+
+static void CO_SDO_Server(const uint8_t *req)
+{
+    uint8_t  ccs   = req[0] >> 5;
+    uint16_t index = (uint16_t)req[1] | ((uint16_t)req[2] << 8);
+    uint8_t  sub   = req[3];
+    uint32_t key   = CO_KEY(index, sub);
+    const CO_OD_Entry_t *entry;
+
+    switch (ccs)
+    {
+        case 1:     /* Initiate download */
+        case 2:     /* Initiate upload */
+            _sdo.active = false;
+            entry = CANopen_Find(index, sub);
+            if (entry == NULL)
+            {
+                CO_SDO_Abort(key, CO_LookupAbort(index));
+            }
+            else if (ccs == 1)
+            {
+                if (!(entry->attr & CO_ATTR_WO))
+                    CO_SDO_Abort(key, CO_SDO_ABORT_READONLY);
+                else
+                    CO_SDO_InitiateDownload(req, entry);
+            }
+            else
+            {
+                if (!(entry->attr & CO_ATTR_RO))
+                    CO_SDO_Abort(key, CO_SDO_ABORT_WRITEONLY);
+                else
+                    CO_SDO_InitiateUpload(req, entry);
+            }
+            break;
+
+        case 0:     /* Download segment */
+            CO_SDO_DownloadSegment(req);
+            break;
+
+        case 3:     /* Upload segment */
+            CO_SDO_UploadSegment(req);
+            break;
+
+        case 4:     /* Abort from client — no response */
+            _sdo.active = false;
+            break;
+
+        default:
+            CO_SDO_Abort(key, CO_SDO_ABORT_CMD);
+            break;
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * CANopen_Init
+ * Checks the generated tables and sends the boot-up frame
+ * ───────────────────────────────────────────────── */
+void CANopen_Init(void)
+{
+    static const osMutexAttr_t mutexAttr = {
+        .name      = "CO_SDO",
+        .attr_bits = osMutexPrioInherit,
+        .cb_mem    = &_sdoMutexCb,
+        .cb_size   = sizeof(_sdoMutexCb),
+    };
+    uint8_t bootup = 0x00;
+
+    for (uint16_t i = 1; i < CO_Node.odCount; i++)
+    {
+        if (CO_Node.od[i - 1].key >= CO_Node.od[i].key)
+        {
+            UART_Log_Int("CANOPEN", "OD not sorted at row", i);
+            Error_Handler();
+        }
+    }
+
+    _sdoMutex = osMutexNew(&mutexAttr);
+    if (_sdoMutex == NULL)
+    {
+        Error_Handler();
+    }
+
+    _sdo.active = false;
+    for (uint8_t n = 0; n < CO_Node.tpdoCount && n < CO_MAX_TPDO; n++)
+    {
+        _tpdoPeriod[n] = 0;
+    }
+
+    CAN_App_Transmit(CO_COBID_BOOTUP + CO_Node.nodeId, &bootup, 1);
+    UART_Log_Int("CANOPEN", "Node ID", CO_Node.nodeId);
+}
+
+/* ─────────────────────────────────────────────────
+ * CANopen_ProcessFrame
+ * Returns true if the frame belonged to the CANopen layer
+ * ───────────────────────────────────────────────── */
+bool CANopen_ProcessFrame(uint32_t id, const uint8_t *data, uint8_t dlc)
+{
+    if (id == CO_COBID_RSDO + CO_Node.nodeId)
+    {
+        if (dlc == 8)
+        {
+            osMutexAcquire(_sdoMutex, osWaitForever);
+            _nowMs = osKernelGetTickCount();
+            CO_SDO_Server(data);
+            osMutexRelease(_sdoMutex);
+        }
+        return true;
+    }
+
+    for (uint8_t n = 0; n < CO_Node.rpdoCount; n++)
+    {
+        const CO_PDO_Plan_t *plan = &CO_Node.rpdo[n];
+        if (id == plan->cobId)
+        {
+            if (dlc >= plan->dlc)
+            {
+                CO_UnpackPDO(plan, data);
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* ─────────────────────────────────────────────────
+ * CANopen_SdoDueMs
+ * Milliseconds until the open SDO transfer times out,
+ * 0 if none is open — for a one-shot time event
+ * ───────────────────────────────────────────────── */
+uint32_t CANopen_SdoDueMs(uint32_t nowMs)
+{
+    uint32_t dueMs = 0;
+
+    osMutexAcquire(_sdoMutex, osWaitForever);
+    if (_sdo.active)
+    {
+        uint32_t elapsed = nowMs - _sdo.lastMs;
+        dueMs = (elapsed < CO_SDO_TIMEOUT_MS) ? CO_SDO_TIMEOUT_MS - elapsed + 1 : 1;
+    }
+    osMutexRelease(_sdoMutex);
+
+    return dueMs;
+}
+
+/* ─────────────────────────────────────────────────
+ * CANopen_Process
+ * Runs TPDO event timers and the SDO timeout.
+ * Returns milliseconds until the next TPDO is due.
+ * ───────────────────────────────────────────────── */
+uint32_t CANopen_Process(uint32_t nowMs)
+{
+    uint32_t sleepMs = CO_IDLE_POLL_MS;
+
+    osMutexAcquire(_sdoMutex, osWaitForever);
+    _nowMs = nowMs;
+    if (_sdo.active && (nowMs - _sdo.lastMs) > CO_SDO_TIMEOUT_MS)
+    {
+        CO_SDO_Abort(_sdo.entry->key, CO_SDO_ABORT_TIMEOUT);
+    }
+    osMutexRelease(_sdoMutex);
+
+    for (uint8_t n = 0; n < CO_Node.tpdoCount && n < CO_MAX_TPDO; n++)
+    {
+        uint16_t period = CO_Node.tpdoEventTimer[n];
+
+        if (period == 0)
+        {
+            _tpdoPeriod[n] = 0;
+            continue;
+        }
+        if (period != _tpdoPeriod[n])
+        {
+            /* Newly enabled or re-timed over SDO — start now */
+            _tpdoPeriod[n] = period;
+            _tpdoDue[n]    = nowMs;
+        }
+
+        if ((int32_t)(_tpdoDue[n] - nowMs) <= 0)
+        {
+            CANopen_SendTPDO(n);
+            _tpdoDue[n] += period;
+            if ((int32_t)(_tpdoDue[n] - nowMs) <= 0)
+            {
+                /* Fell behind by a full period — resynchronise */
+                _tpdoDue[n] = nowMs + period;
+            }
+        }
+
+        if (_tpdoDue[n] - nowMs < sleepMs)
+        {
+            sleepMs = _tpdoDue[n] - nowMs;
+        }
+    }
+
+    return sleepMs;
+}
@@ -0,0 +1,164 @@
+/*
+ * co_od.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Object dictionary and PDO copy plans for Node A.
+ *  Everything here is const and linked into flash; only the
+ *  objects the rows point at live in RAM.
+ */
+
+
+#include "co_od.h"
+#include "can_frame.h"
+#include "cov.h"
+#include "timesync.h"
+#include "acq.h"
+#include "power.h"
+#include "can_app.h"
+#include "trace.h"
+#include "prof.h"
+
+/* ── Process Data ────────────────────────────── */
+uint16_t OD_rpm;
+int16_t  OD_temp;
+
+/* ── Parameters ──────────────────────────────── */
+uint16_t OD_txPeriodMs = 100;
+static char OD_location[24] = "bench";
+
+/* ── Communication Objects ───────────────────── */
+uint16_t OD_tpdoEventTimer[1] = {0};    /* Disabled until set over SDO */
+
+static const uint32_t OD_deviceType     = 0x00000000;
+static uint8_t        OD_errorRegister  = 0x00;
+static const char     OD_deviceName[]   = "NodeA-Sensor";
+static const char     OD_swVersion[]    = "1.1";
+static const uint32_t OD_tpdo1CobId     = CO_COBID_TPDO1 + CO_NODE_ID;
+static const uint8_t  OD_tpdo1Type      = 0xFE;                 /* Event driven */
+static const uint8_t  OD_tpdo1MapCount  = 2;
+static const uint32_t OD_tpdo1Map[2]    = { 0x20000110, 0x20000210 };
+
+/* ─────────────────────────────────────────────────
+ * Object Dictionary — MUST stay sorted by index/sub
+ * ───────────────────────────────────────────────── */
+static const CO_OD_Entry_t OD_Table[] = {
+    CO_OD(0x1000, 0, CO_ATTR_RO,               OD_deviceType),
+    CO_OD(0x1001, 0, CO_ATTR_RO,               OD_errorRegister),
+    CO_OD(0x1008, 0, CO_ATTR_RO | CO_ATTR_STR, OD_deviceName),
+    CO_OD(0x100A, 0, CO_ATTR_RO | CO_ATTR_STR, OD_swVersion),
+    CO_OD(0x1800, 1, CO_ATTR_RO,               OD_tpdo1CobId),
+    CO_OD(0x1800, 2, CO_ATTR_RO,               OD_tpdo1Type),
+    CO_OD(0x1800, 5, CO_ATTR_RW,               OD_tpdoEventTimer[0]),
+    CO_OD(0x1A00, 0, CO_ATTR_RO,               OD_tpdo1MapCount),
+    CO_OD(0x1A00, 1, CO_ATTR_RO,               OD_tpdo1Map[0]),
+    CO_OD(0x1A00, 2, CO_ATTR_RO,               OD_tpdo1Map[1]),
+    CO_OD(0x2000, 1, CO_ATTR_RO,               OD_rpm),
+    CO_OD(0x2000, 2, CO_ATTR_RO,               OD_temp),
+    CO_OD(0x2100, 1, CO_ATTR_RW,               OD_txPeriodMs),
+    CO_OD(0x2100, 2, CO_ATTR_RW | CO_ATTR_STR, OD_location),
+    CO_OD(0x2101, 1, CO_ATTR_RW,               COV_Signals[COV_SIG_RPM].cfg.deadband),
+    CO_OD(0x2101, 2, CO_ATTR_RW,               COV_Signals[COV_SIG_RPM].cfg.inhibitMs),
+    CO_OD(0x2101, 3, CO_ATTR_RW,               COV_Signals[COV_SIG_RPM].cfg.refreshMs),
+    CO_OD(0x2101, 4, CO_ATTR_RO,               COV_Signals[COV_SIG_RPM].sentChange),
+    CO_OD(0x2101, 5, CO_ATTR_RO,               COV_Signals[COV_SIG_RPM].sentRefresh),
+    CO_OD(0x2101, 6, CO_ATTR_RO,               COV_Signals[COV_SIG_RPM].baseline),
+    CO_OD(0x2102, 1, CO_ATTR_RW,               COV_Signals[COV_SIG_TEMP].cfg.deadband),
+    CO_OD(0x2102, 2, CO_ATTR_RW,               COV_Signals[COV_SIG_TEMP].cfg.inhibitMs),
+    CO_OD(0x2102, 3, CO_ATTR_RW,               COV_Signals[COV_SIG_TEMP].cfg.refreshMs),
+    CO_OD(0x2102, 4, CO_ATTR_RO,               COV_Signals[COV_SIG_TEMP].sentChange),
+    CO_OD(0x2102, 5, CO_ATTR_RO,               COV_Signals[COV_SIG_TEMP].sentRefresh),
+    CO_OD(0x2102, 6, CO_ATTR_RO,               COV_Signals[COV_SIG_TEMP].baseline),
+    CO_OD(0x2200, 1, CO_ATTR_RO,               TSync_Stats.offsetUs),
+    CO_OD(0x2200, 2, CO_ATTR_RO,               TSync_Stats.driftPpb),
+    CO_OD(0x2200, 3, CO_ATTR_RO,               TSync_Stats.maxAbsOffsetUs),
+    CO_OD(0x2200, 4, CO_ATTR_RO,               TSync_Stats.locked),
+    CO_OD(0x2300, 1, CO_ATTR_RO,               CAN_FramePoolStats.allocs),
+    CO_OD(0x2300, 2, CO_ATTR_RO,               CAN_FramePoolStats.exhausted),
+    CO_OD(0x2300, 3, CO_ATTR_RO,               CAN_FramePoolStats.queueFull),
+    CO_OD(0x2300, 4, CO_ATTR_RO,               CAN_FramePoolStats.inUse),
+    CO_OD(0x2300, 5, CO_ATTR_RO,               CAN_FramePoolStats.highWater),
+    CO_OD(0x2400, 1, CO_ATTR_RW,               Acq_Filters[ACQ_CH_RPM].kind),
+    CO_OD(0x2400, 2, CO_ATTR_RW,               Acq_Filters[ACQ_CH_RPM].param),
+    CO_OD(0x2400, 3, CO_ATTR_RO,               Acq_Filters[ACQ_CH_RPM].active),
+    CO_OD(0x2400, 4, CO_ATTR_RO,               Acq_Filters[ACQ_CH_RPM].cyclesAvg),
+    CO_OD(0x2400, 5, CO_ATTR_RO,               Acq_Filters[ACQ_CH_RPM].cyclesMax),
+    CO_OD(0x2401, 1, CO_ATTR_RW,               Acq_Filters[ACQ_CH_TEMP].kind),
+    CO_OD(0x2401, 2, CO_ATTR_RW,               Acq_Filters[ACQ_CH_TEMP].param),
+    CO_OD(0x2401, 3, CO_ATTR_RO,               Acq_Filters[ACQ_CH_TEMP].active),
+    CO_OD(0x2401, 4, CO_ATTR_RO,               Acq_Filters[ACQ_CH_TEMP].cyclesAvg),
+    CO_OD(0x2401, 5, CO_ATTR_RO,               Acq_Filters[ACQ_CH_TEMP].cyclesMax),
+    CO_OD(0x2500, 1, CO_ATTR_RO,               Power_Stats.switchesPerSec),
+    CO_OD(0x2500, 2, CO_ATTR_RO,               Power_Stats.idlePermille),
+    CO_OD(0x2500, 3, CO_ATTR_RO,               Power_Stats.sleepPermille),
+    CO_OD(0x2600, 1, CO_ATTR_RW,               CAN_Bitrate.request),
+    CO_OD(0x2600, 2, CO_ATTR_RO,               CAN_Bitrate.active),
+    CO_OD(0x2700, 1, CO_ATTR_RW,               Trace_Ctrl.request),
+    CO_OD(0x2700, 2, CO_ATTR_RW,               Trace_Ctrl.autoDump),
+    CO_OD(0x2700, 3, CO_ATTR_RO,               Trace_Ctrl.frozen),
+    CO_OD(0x2700, 4, CO_ATTR_RO,               Trace_Ctrl.recorded),
+    CO_OD(0x2800, 1, CO_ATTR_RW,               Prof_Ctrl.request),
+    CO_OD(0x2900, 1, CO_ATTR_RO,               CAN_RxLatency.maxUs),
+    CO_OD(0x2900, 2, CO_ATTR_RO,               CAN_TxLatency.maxUs),
+    CO_OD(0x2900, 3, CO_ATTR_RO,               CAN_RxLatency.count),
+    CO_OD(0x2900, 4, CO_ATTR_RO,               CAN_TxLatency.count),
+};
+
+/* ─────────────────────────────────────────────────
+ * Value ranges for SDO writes
+ * ───────────────────────────────────────────────── */
+static const CO_OD_Range_t OD_Ranges[] = {
+    CO_RANGE(0x2100, 1, 0, 10, 10000),      /* OD_txPeriodMs */
+    CO_RANGE(0x2101, 1, 0, 0, 6000),        /* RPM deadband, up to full scale */
+    CO_RANGE(0x2101, 2, 0, 0, 60000),       /* RPM inhibitMs, also <= refreshMs */
+    CO_RANGE(0x2101, 3, 0, COV_SAMPLE_PERIOD_MS, 60000),    /* RPM refreshMs */
+    CO_RANGE(0x2102, 1, 0, 0, 100),         /* TEMP deadband */
+    CO_RANGE(0x2102, 2, 0, 0, 60000),       /* TEMP inhibitMs, also <= refreshMs */
+    CO_RANGE(0x2102, 3, 0, COV_SAMPLE_PERIOD_MS, 60000),    /* TEMP refreshMs */
+};
+
+/* A COV signal's inhibit may not exceed its refresh; to widen
+ * both, raise refresh first */
+static bool OD_Check(const CO_OD_Entry_t *entry, const uint8_t *src, uint16_t len)
+{
+    if (len != sizeof(uint16_t)) return true;
+
+    uint16_t value = (uint16_t)(src[0] | (src[1] << 8));
+
+    for (uint8_t s = 0; s < COV_SIG_COUNT; s++)
+    {
+        const COV_Config_t *cfg = &COV_Signals[s].cfg;
+
+        if (entry->data == &cfg->inhibitMs) return value <= cfg->refreshMs;
+        if (entry->data == &cfg->refreshMs) return value >= cfg->inhibitMs;
+    }
+    return true;
+}
+
+/* ─────────────────────────────────────────────────
+ * TPDO copy plans — must match the 0x1A00 mapping above
+ * ───────────────────────────────────────────────── */
+static const CO_PDO_Plan_t OD_Tpdo[] = {
+    {
+        .cobId = CO_COBID_TPDO1 + CO_NODE_ID,
+        .dlc   = 4,
+        .bytes = { CO_MAP_U16(OD_rpm), CO_MAP_U16(OD_temp),
+                   CO_MAP_PAD, CO_MAP_PAD, CO_MAP_PAD, CO_MAP_PAD },
+    },
+};
+
+const CO_Node_t CO_Node = {
+    .nodeId         = CO_NODE_ID,
+    .od             = OD_Table,
+    .odCount        = sizeof(OD_Table) / sizeof(OD_Table[0]),
+    .ranges         = OD_Ranges,
+    .rangeCount     = sizeof(OD_Ranges) / sizeof(OD_Ranges[0]),
+    .tpdo           = OD_Tpdo,
+    .tpdoEventTimer = OD_tpdoEventTimer,
+    .tpdoCount      = sizeof(OD_Tpdo) / sizeof(OD_Tpdo[0]),
+    .rpdo           = NULL,
+    .rpdoCount      = 0,
+    .written        = NULL,
+    .check          = OD_Check,
+};
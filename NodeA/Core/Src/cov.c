@@ -0,0 +1,118 @@
+/*
+ * cov.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "cov.h"
+#include "acq.h"
+#include "uart_log.h"
+
+/* Nominal bits on the wire for one RPM/TEMP broadcast as the node
+ * sends it, including interframe space but not stuff bits */
+#define COV_FRAME_BITS          (47 + 8 * ACQ_FRAME_DLC)
+
+/* ── Defaults ────────────────────────────────── */
+COV_Signal_t COV_Signals[COV_SIG_COUNT] = {
+    [COV_SIG_RPM]  = { .cfg = { .deadband = 50, .inhibitMs = 20,  .refreshMs = 1000 } },
+    [COV_SIG_TEMP] = { .cfg = { .deadband = 1,  .inhibitMs = 100, .refreshMs = 1000 } },
+};
+
+static const char *const COV_Names[COV_SIG_COUNT] = { "RPM", "TEMP" };
+
+/* ─────────────────────────────────────────────────
+ * COV_Update
+ * Offers a new sample; returns true if it must be transmitted.
+ * A change that arrives inside the inhibit window is not lost:
+ * it is compared against lastSent again on the next sample.
+ * maxIntervalMs (subscriber rate) tightens refresh and inhibit.
+ * ───────────────────────────────────────────────── */
+bool COV_Update(COV_SignalId_t id, int32_t value, uint32_t nowMs, uint16_t maxIntervalMs)
+{
+    COV_Signal_t *sig = &COV_Signals[id];
+    uint32_t elapsed  = nowMs - sig->lastTxMs;
+    int32_t  delta    = value - sig->lastSent;
+    uint16_t refresh  = sig->cfg.refreshMs;
+    uint16_t inhibit  = sig->cfg.inhibitMs;
+    bool     send     = false;
+
+    if (maxIntervalMs != 0 && maxIntervalMs < refresh) refresh = maxIntervalMs;
+    if (inhibit > refresh) inhibit = refresh;
+
+    sig->samples++;
+    if (nowMs - sig->baselineMs >= COV_BASELINE_PERIOD_MS)
+    {
+        sig->baseline++;
+        sig->baselineMs += COV_BASELINE_PERIOD_MS;
+    }
+
+    if (!sig->primed)
+    {
+        sig->primed     = true;
+        sig->baseline   = 1;
+        sig->baselineMs = nowMs;
+        sig->sentChange++;
+        send = true;
+    }
+    else if (elapsed < inhibit)
+    {
+        send = false;
+    }
+    else if (delta > (int32_t)sig->cfg.deadband || -delta > (int32_t)sig->cfg.deadband)
+    {
+        sig->sentChange++;
+        send = true;
+    }
+    else if (elapsed >= refresh)
+    {
+        sig->sentRefresh++;
+        send = true;
+    }
+
+    if (send)
+    {
+        sig->lastSent = value;
+        sig->lastTxMs = nowMs;
+    }
+    else
+    {
+        sig->suppressed++;
+    }
+    return send;
+}
+
+/* ─────────────────────────────────────────────────
+ * Savings against the fixed-rate broadcast
+ * ───────────────────────────────────────────────── */
+uint32_t COV_FramesSaved(COV_SignalId_t id)
+{
+    const COV_Signal_t *sig = &COV_Signals[id];
+    uint32_t sent = sig->sentChange + sig->sentRefresh;
+
+    return (sig->baseline > sent) ? sig->baseline - sent : 0;
+}
+
+uint32_t COV_BitsSaved(COV_SignalId_t id)
+{
+    return COV_FramesSaved(id) * COV_FRAME_BITS;
+}
+
+void COV_LogStats(void)
+{
+    char msg[96];
+
+    for (int i = 0; i < COV_SIG_COUNT; i++)
+    {
+        const COV_Signal_t *sig = &COV_Signals[i];
+        snprintf(msg, sizeof(msg), "%s sent %lu (chg %lu, refresh %lu) saved %lu frames / %lu bits",
+                 COV_Names[i],
+                 (unsigned long)(sig->sentChange + sig->sentRefresh),
+                 (unsigned long)sig->sentChange,
+                 (unsigned long)sig->sentRefresh,
+                 (unsigned long)COV_FramesSaved(i),
+                 (unsigned long)COV_BitsSaved(i));
+        UART_Log("COV", msg);
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * decimate.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "decimate.h"
+
+void Dec_Reset(Dec_Window_t *w)
+{
+    w->sum   = 0;
+    w->min   = 0;
+    w->max   = 0;
+    w->last  = 0;
+    w->count = 0;
+}
+
+/* ─────────────────────────────────────────────────
+ * Dec_Merge
+ * Folds a later window into dst — min/max/sum combine
+ * exactly, so merging 10 ms windows into a broadcast
+ * window gives the same result as pushing every sample
+ * ───────────────────────────────────────────────── */
+void Dec_Merge(Dec_Window_t *dst, const Dec_Window_t *src)
+{
+    if (src->count == 0) return;
+
+    if (dst->count == 0)
+    {
+        *dst = *src;
+        return;
+    }
+
+    if (src->min < dst->min) dst->min = src->min;
+    if (src->max > dst->max) dst->max = src->max;
+    dst->last   = src->last;
+    dst->sum   += src->sum;
+    dst->count += src->count;
+}
+
+/* Rounded half away from zero, in the sample's own units */
+int32_t Dec_Mean(const Dec_Window_t *w)
+{
+    if (w->count == 0) return 0;
+
+    int64_t half = w->count / 2;
+
+    return (int32_t)((w->sum >= 0 ? w->sum + half : w->sum - half) / (int64_t)w->count);
+}
+
+/* ─────────────────────────────────────────────────
+ * Dec_Extreme
+ * Whichever of min/max is further from ref — what a
+ * change-of-value check should see, so a spike inside
+ * the window counts as a change even if it is over
+ * ───────────────────────────────────────────────── */
+int32_t Dec_Extreme(const Dec_Window_t *w, int32_t ref)
+{
+    int64_t below = (int64_t)ref - w->min;
+    int64_t above = (int64_t)w->max - ref;
+
+    return (below > above) ? w->min : w->max;
+}
@@ -0,0 +1,215 @@
+/*
+ * filter.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "filter.h"
+#include <string.h>
+
+#if defined(__ARM_ARCH)
+#include "stm32f4xx.h"          /* __SSAT */
+#else
+#define __SSAT(x, bits)         ((x) > 32767 ? 32767 : (x) < -32768 ? -32768 : (x))
+#endif
+
+/* ── Butterworth Low-pass, fs = FILT_FS_HZ ───── */
+/* b0 b1 b2 −a1 −a2 in Q30 — |a1| < 2, so Q30 rather than Q31 */
+typedef struct {
+    uint16_t cutoffHz;
+    q31_t    coef[5];
+#if FILT_USE_FLOAT
+    float    coefF[5];
+#endif
+} Filt_Biquad_t;
+
+static const Filt_Biquad_t Biquads[] = {
+#if FILT_USE_FLOAT
+#define FILT_BQ(fc, b0, b1, b2, a1, a2, fb0, fb1, fb2, fa1, fa2) \
+    { fc, { b0, b1, b2, a1, a2 }, { fb0, fb1, fb2, fa1, fa2 } }
+#else
+#define FILT_BQ(fc, b0, b1, b2, a1, a2, fb0, fb1, fb2, fa1, fa2) \
+    { fc, { b0, b1, b2, a1, a2 } }
+#endif
+    FILT_BQ(5,     259157,    518315,    259157, 2099786147, -1027080952,
+            0.000241359f, 0.000482718f, 0.000241359f, 1.955578240f, -0.956543677f),
+    FILT_BQ(10,   1014355,   2028710,   1014355, 2052132225,  -982447822,
+            0.000944692f, 0.001889384f, 0.000944692f, 1.911197067f, -0.914975835f),
+    FILT_BQ(20,   3888751,   7777502,   3888751, 1957103774,  -898916953,
+            0.003621682f, 0.007243363f, 0.003621682f, 1.822694925f, -0.837181651f),
+    FILT_BQ(50,  21564350,  43128699,  21564350, 1676130396,  -688645970,
+            0.020083366f, 0.040166731f, 0.020083366f, 1.561018076f, -0.641351538f),
+    FILT_BQ(100, 72429549, 144859098,  72429549, 1227265970,  -443242341,
+            0.067455274f, 0.134910548f, 0.067455274f, 1.142980503f, -0.412801598f),
+    FILT_BQ(200, 221805086, 443610172, 221805086, 396777000,  -210255520,
+            0.206572084f, 0.413144168f, 0.206572084f, 0.369527377f, -0.195815713f),
+#undef FILT_BQ
+};
+
+#define FILT_BIQUAD_COUNT       (sizeof(Biquads) / sizeof(Biquads[0]))
+
+static const char *const Names[FILT_KIND_COUNT] = { "none", "movavg", "iir", "median" };
+
+/* ─────────────────────────────────────────────────
+ * Filt_Configure
+ * Clears all history — the first output of a new filter
+ * is its first input
+ * ───────────────────────────────────────────────── */
+Filt_Kind_t Filt_Configure(Filt_t *f, Filt_Kind_t kind, uint16_t param)
+{
+    memset(f, 0, sizeof(*f));
+
+    switch (kind)
+    {
+        case FILT_MOVAVG:
+            if (param < 1 || param > FILT_MOVAVG_MAX) return FILT_NONE;
+            f->length = param;
+            f->recip  = (32768 + param / 2) / param;
+            break;
+
+        case FILT_IIR:
+            if (param < Biquads[0].cutoffHz) return FILT_NONE;
+            for (uint8_t i = 0; i < FILT_BIQUAD_COUNT && Biquads[i].cutoffHz <= param; i++)
+            {
+                f->coef = Biquads[i].coef;
+#if FILT_USE_FLOAT
+                f->coefF = Biquads[i].coefF;
+#endif
+            }
+            break;
+
+        case FILT_MEDIAN:
+            if (param < 3 || param > FILT_MEDIAN_MAX || (param & 1U) == 0) return FILT_NONE;
+            f->length = param;
+            break;
+
+        default:
+            return FILT_NONE;
+    }
+
+    f->kind = kind;
+    return kind;
+}
+
+/* ─────────────────────────────────────────────────
+ * Kernels
+ * ───────────────────────────────────────────────── */
+
+/* O(1): add the new sample, drop the oldest, scale by 1/N */
+static q15_t MovAvg(Filt_t *f, q15_t x)
+{
+    if (f->fill < f->length)
+    {
+        f->fill++;
+    }
+    else
+    {
+        f->sum -= f->ring[f->pos];
+    }
+
+    f->ring[f->pos] = x;
+    f->sum += x;
+    if (++f->pos == f->length) f->pos = 0;
+
+    /* Until the window is full, average what is there */
+    if (f->fill < f->length)
+    {
+        return (q15_t)(f->sum / f->fill);
+    }
+
+    int32_t y = (int32_t)(((int64_t)f->sum * f->recip + (1 << 14)) >> 15);
+    return (q15_t)__SSAT(y, 16);
+}
+
+/* DF1 biquad, q31 state with 16 fraction bits, 64-bit MAC —
+ * low cutoffs keep their DC gain */
+static q15_t Biquad(Filt_t *f, q15_t x)
+{
+#if FILT_USE_FLOAT
+    const float *c = f->coefF;
+    float xf = x;
+    float yf = c[0] * xf + c[1] * f->fx1 + c[2] * f->fx2 + c[3] * f->fy1 + c[4] * f->fy2;
+
+    if (f->fill == 0)
+    {
+        /* Start at steady state instead of ramping up from zero */
+        f->fill = 1;
+        f->fx1 = f->fx2 = f->fy1 = f->fy2 = yf = xf;
+    }
+    f->fx2 = f->fx1;  f->fx1 = xf;
+    f->fy2 = f->fy1;  f->fy1 = yf;
+
+    int32_t y = (int32_t)(yf + (yf >= 0 ? 0.5f : -0.5f));
+#else
+    const q31_t *c = f->coef;
+    q31_t x16 = (q31_t)x << 16;
+
+    if (f->fill == 0)
+    {
+        /* Start at steady state instead of ramping up from zero */
+        f->fill = 1;
+        f->x1 = f->x2 = f->y1 = f->y2 = x16;
+    }
+
+    int64_t acc = (int64_t)c[0] * x16 + (int64_t)c[1] * f->x1 + (int64_t)c[2] * f->x2 +
+                  (int64_t)c[3] * f->y1 + (int64_t)c[4] * f->y2;
+    int64_t y64 = acc >> 30;
+
+    /* A near full-scale step overshoots past Q16 — clamp the state
+     * rather than let it wrap */
+    q31_t y16 = (y64 > INT32_MAX) ? INT32_MAX : (y64 < INT32_MIN) ? INT32_MIN : (q31_t)y64;
+
+    f->x2 = f->x1;  f->x1 = x16;
+    f->y2 = f->y1;  f->y1 = y16;
+
+    int32_t y = (int32_t)((y64 + (1 << 15)) >> 16);
+#endif
+    return (q15_t)__SSAT(y, 16);
+}
+
+/* Sorted window kept incrementally: one remove, one insert */
+static q15_t Median(Filt_t *f, q15_t x)
+{
+    uint8_t n = f->fill;
+    uint8_t i;
+
+    if (n == f->length)
+    {
+        /* Remove the oldest sample from the sorted copy */
+        q15_t old = f->ring[f->pos];
+        for (i = 0; f->sorted[i] != old; i++) { }
+        for (; i + 1 < n; i++) f->sorted[i] = f->sorted[i + 1];
+        n--;
+    }
+
+    for (i = n; i > 0 && f->sorted[i - 1] > x; i--)
+    {
+        f->sorted[i] = f->sorted[i - 1];
+    }
+    f->sorted[i] = x;
+    n++;
+
+    f->ring[f->pos] = x;
+    if (++f->pos == f->length) f->pos = 0;
+    f->fill = n;
+
+    return f->sorted[n / 2];
+}
+
+q15_t Filt_Process(Filt_t *f, q15_t x)
+{
+    switch (f->kind)
+    {
+        case FILT_MOVAVG: return MovAvg(f, x);
+        case FILT_IIR:    return Biquad(f, x);
+        case FILT_MEDIAN: return Median(f, x);
+        default:          return x;
+    }
+}
+
+const char *Filt_Name(Filt_Kind_t kind)
+{
+    return (kind < FILT_KIND_COUNT) ? Names[kind] : "?";
+}
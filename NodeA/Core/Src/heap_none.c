@@ -0,0 +1,34 @@
+/*
+ * heap_none.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Stands in for heap_4. Every RTOS object is statically allocated
+ *  (rtos_config.h) and configSUPPORT_DYNAMIC_ALLOCATION is 0, so
+ *  the kernel never allocates. The CMSIS-RTOS2 wrapper still links
+ *  pvPortMalloc for calls made without static memory (osTimerNew,
+ *  osThreadEnumerate, a pool without attributes). Reaching one is a
+ *  bug, so it traps instead of allocating.
+ */
+
+
+#include "FreeRTOS.h"
+#include "main.h"
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+    (void)xWantedSize;
+    Error_Handler();
+    return NULL;
+}
+
+void vPortFree(void *pv)
+{
+    (void)pv;
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return 0;
+}
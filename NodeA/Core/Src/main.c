@@ -25,6 +25,13 @@
 #include "can_app.h"
 #include "uart_log.h"
 #include "tasks.h"
+#include "rtos_config.h"
+#include "canopen.h"
+#include "co_od.h"
+#include "timesync.h"
+#include "trace.h"
+#include "prof.h"
+#include "acq.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -47,18 +54,13 @@ CAN_HandleTypeDef hcan1;
 
 UART_HandleTypeDef huart2;
 
-/* Definitions for defaultTask */
-osThreadId_t defaultTaskHandle;
-const osThreadAttr_t defaultTask_attributes = {
-  .name = "defaultTask",
-  .stack_size = 128 * 4,
-  .priority = (osPriority_t) osPriorityNormal,
-};
 /* USER CODE BEGIN PV */
-osThreadId_t heartbeatTaskHandle;
-osThreadId_t canTxTaskHandle;
-osThreadId_t canRxTaskHandle;
-osThreadId_t uartLogTaskHandle;
+osThreadId_t highThreadHandle;
+osThreadId_t aboveThreadHandle;
+osThreadId_t normalThreadHandle;
+osThreadId_t lowThreadHandle;
+TIM_HandleTypeDef htim2;
+TIM_HandleTypeDef htim3;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -66,14 +68,80 @@ void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_CAN1_Init(void);
 static void MX_USART2_UART_Init(void);
-void StartDefaultTask(void *argument);
 
 /* USER CODE BEGIN PFP */
+static void MX_TIM2_Init(void);
+static void MX_TIM3_Init(void);
+static void Flash_CheckAccel(void);
 
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+/**
+  * @brief Verifies the flash interface for 180 MHz: 5 wait states with
+  *        prefetch and the ART instruction and data caches on. HAL_Init
+  *        enables them from stm32f4xx_hal_conf.h and SystemClock_Config
+  *        sets the latency; anything else is a configuration regression.
+  */
+static void Flash_CheckAccel(void)
+{
+  const uint32_t mask = FLASH_ACR_LATENCY | FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+  const uint32_t want = FLASH_LATENCY_5 | FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+
+  if ((FLASH->ACR & mask) != want)
+  {
+    Error_Handler();
+  }
+  UART_Log("SYSTEM", "Flash 5 WS, prefetch + ART I/D cache on");
+}
+
+/**
+  * @brief TIM2 Initialization Function — free-running 1 MHz, 32-bit
+  *        local clock for time sync. CH1 output compare (no pin) is
+  *        the synchronised sampling trigger.
+  */
+static void MX_TIM2_Init(void)
+{
+  TIM_OC_InitTypeDef sConfigOC = {0};
+
+  htim2.Instance = TIM2;
+  htim2.Init.Prescaler = (2 * HAL_RCC_GetPCLK1Freq()) / 1000000U - 1;
+  htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim2.Init.Period = 0xFFFFFFFF;
+  htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  if (HAL_TIM_OC_Init(&htim2) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  sConfigOC.OCMode = TIM_OCMODE_TIMING;
+  sConfigOC.Pulse = 0;
+  sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+  sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+  if (HAL_TIM_OC_ConfigChannel(&htim2, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+/**
+  * @brief TIM3 Initialization Function — update interrupt at
+  *        ACQ_RATE_HZ drives the oversampled acquisition.
+  */
+static void MX_TIM3_Init(void)
+{
+  htim3.Instance = TIM3;
+  htim3.Init.Prescaler = (2 * HAL_RCC_GetPCLK1Freq()) / 1000000U - 1;
+  htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim3.Init.Period = 1000000U / ACQ_RATE_HZ - 1;
+  htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  if (HAL_TIM_Base_Init(&htim3) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
 
 /* USER CODE END 0 */
 
@@ -110,7 +178,15 @@ int main(void)
   MX_USART2_UART_Init();
   /* USER CODE BEGIN 2 */
   UART_Log_Init(&huart2);
-  CAN_App_Init(&hcan1);
+  Prof_Init();
+  Flash_CheckAccel();
+  MX_TIM2_Init();
+  TSync_Init(&htim2, false);
+  Trace_Init();
+  MX_TIM3_Init();
+  Acq_Init(&htim3);
+  CAN_App_Init(&hcan1, SENSOR_NODE_ID);
+  CANopen_Init();
   UART_Log("SYSTEM", "Node A starting...");
   /* USER CODE END 2 */
 
@@ -130,42 +206,38 @@ int main(void)
   /* USER CODE END RTOS_TIMERS */
 
   /* USER CODE BEGIN RTOS_QUEUES */
-  logQueueHandle = osMessageQueueNew(10, 128, NULL);
+  /* Event pool — the thread event queues come with the threads */
+  AO_Init();
   /* USER CODE END RTOS_QUEUES */
 
   /* Create the thread(s) */
-  /* creation of defaultTask */
-  defaultTaskHandle = osThreadNew(StartDefaultTask, NULL, &defaultTask_attributes);
-
   /* USER CODE BEGIN RTOS_THREADS */
-  static const osThreadAttr_t heartbeatAttr = {
-      .name       = "Heartbeat",
-      .stack_size = 128 * 4,
-      .priority   = osPriorityLow,
-  };
-
-  static const osThreadAttr_t canTxAttr = {
-      .name       = "CAN_TX",
-      .stack_size = 256 * 4,
-      .priority   = osPriorityNormal,
-  };
-
-  static const osThreadAttr_t canRxAttr = {
-      .name       = "CAN_RX",
-      .stack_size = 256 * 4,
-      .priority   = osPriorityAboveNormal,
-  };
-
-  static const osThreadAttr_t uartLogAttr = {
-      .name       = "UART_LOG",
-      .stack_size = 256 * 4,
-      .priority   = osPriorityBelowNormal,
-  };
-
-  heartbeatTaskHandle = osThreadNew(vHeartbeatTask,  NULL, &heartbeatAttr);
-  canTxTaskHandle     = osThreadNew(vCANTransmitTask, NULL, &canTxAttr);
-  canRxTaskHandle     = osThreadNew(vCANReceiveTask,  NULL, &canRxAttr);
-  uartLogTaskHandle   = osThreadNew(vUARTLogTask,     NULL, &uartLogAttr);
+  /* Active objects share one thread per priority level. Control
+   * blocks, stacks and event queues are static — sizes in rtos_config.h */
+  AO_THREAD_ATTR(highAttr,   "AO_HIGH",   THREAD_HIGH_STACK,   THREAD_HIGH_PRIO,   QUEUE_HIGH_DEPTH);
+  AO_THREAD_ATTR(aboveAttr,  "AO_ABOVE",  THREAD_ABOVE_STACK,  THREAD_ABOVE_PRIO,  QUEUE_ABOVE_DEPTH);
+  AO_THREAD_ATTR(normalAttr, "AO_NORMAL", THREAD_NORMAL_STACK, THREAD_NORMAL_PRIO, QUEUE_NORMAL_DEPTH);
+  AO_THREAD_ATTR(lowAttr,    "AO_LOW",    THREAD_LOW_STACK,    THREAD_LOW_PRIO,    QUEUE_LOW_DEPTH);
+
+  AO_Attach(&HighThread,   &CanopenAO);
+  AO_Attach(&AboveThread,  &RxAO);
+  AO_Attach(&NormalThread, &SensorAO);
+  AO_Attach(&LowThread,    &HeartbeatAO);
+  AO_Attach(&LowThread,    &LogAO);
+
+  highThreadHandle   = AO_ThreadStart(&HighThread,   QUEUE_HIGH_DEPTH,   &highAttrQueue,   &highAttr);
+  aboveThreadHandle  = AO_ThreadStart(&AboveThread,  QUEUE_ABOVE_DEPTH,  &aboveAttrQueue,  &aboveAttr);
+  normalThreadHandle = AO_ThreadStart(&NormalThread, QUEUE_NORMAL_DEPTH, &normalAttrQueue, &normalAttr);
+  lowThreadHandle    = AO_ThreadStart(&LowThread,    QUEUE_LOW_DEPTH,    &lowAttrQueue,    &lowAttr);
+
+  if (highThreadHandle == NULL || aboveThreadHandle == NULL ||
+      normalThreadHandle == NULL || lowThreadHandle == NULL)
+  {
+    Error_Handler();
+  }
+
+  /* Frames are posted from here on */
+  Tasks_Init();
   /* USER CODE END RTOS_THREADS */
 
   /* USER CODE BEGIN RTOS_EVENTS */
@@ -274,7 +346,7 @@ static void MX_CAN1_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN CAN1_Init 2 */
-
+  /* Bit timing is re-derived for CAN_BITRATE in CAN_App_Init (can_bittiming.h) */
   /* USER CODE END CAN1_Init 2 */
 
 }
@@ -353,24 +425,6 @@ static void MX_GPIO_Init(void)
 
 /* USER CODE END 4 */
 
-/* USER CODE BEGIN Header_StartDefaultTask */
-/**
-  * @brief  Function implementing the defaultTask thread.
-  * @param  argument: Not used
-  * @retval None
-  */
-/* USER CODE END Header_StartDefaultTask */
-void StartDefaultTask(void *argument)
-{
-  /* USER CODE BEGIN 5 */
-  /* Infinite loop */
-  for(;;)
-  {
-    osDelay(1);
-  }
-  /* USER CODE END 5 */
-}
-
 /**
   * @brief  Period elapsed callback in non blocking mode
   * @note   This function is called  when TIM1 interrupt took place, inside
@@ -388,7 +442,9 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+  if (htim->Instance == TIM3) {
+    Acq_SampleISR();
+  }
   /* USER CODE END Callback 1 */
 }
 
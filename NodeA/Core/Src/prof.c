@@ -0,0 +1,127 @@
+/*
+ * prof.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "prof.h"
+#include "uart_log.h"
+#include <string.h>
+
+/* ── Per-site Stats ──────────────────────────── */
+static Prof_Stats_t _stats[PROF_SITE_COUNT];
+
+Prof_Ctrl_t Prof_Ctrl;
+
+/* Before the first UART_Log — that is a site too */
+void Prof_Init(void)
+{
+    Prof_CycleCounterEnable();
+}
+
+/* ─────────────────────────────────────────────────
+ * Prof_Record — from tasks and ISRs alike. The bin is
+ * the position of the top set bit, so one CLZ
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC void Prof_Record(Prof_Site_t site, uint32_t cycles)
+{
+    Prof_Stats_t *s = &_stats[site];
+    uint32_t bin = cycles == 0U ? 0U : 31U - (uint32_t)__builtin_clz(cycles);
+
+    if (bin >= PROF_HIST_BINS) bin = PROF_HIST_BINS - 1U;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (s->count == 0U || cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    s->count++;
+    s->total += cycles;
+    s->hist[bin]++;
+    __set_PRIMASK(primask);
+}
+
+/* Consistent snapshot of one site */
+void Prof_Get(Prof_Site_t site, Prof_Stats_t *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = _stats[site];
+    __set_PRIMASK(primask);
+}
+
+/* ─────────────────────────────────────────────────
+ * Prof_Dump — two lines per site that has run:
+ *   [PROF] can_send n 1523 min 212 mean 240 max 1910 cyc
+ *   [PROF] can_send hist 7:3 8:1490 9:20 10:10
+ * hist lists the non-empty bins as log2(cycles):count
+ * ───────────────────────────────────────────────── */
+#if PROF_ENABLE
+static const char *const _siteName[PROF_SITE_COUNT] = {
+    [PROF_CAN_SEND]          = "can_send",
+    [PROF_CAN_RX_ISR]        = "can_rx_isr",
+    [PROF_UART_LOG]          = "uart_log",
+    [PROF_RX_COMMAND]        = "rx_command",
+    [PROF_RX_FOLLOWUP]       = "rx_followup",
+    [PROF_RX_SUBSCRIBE]      = "rx_subscribe",
+    [PROF_RX_CTRL_HEARTBEAT] = "rx_ctrl_hb",
+    [PROF_RX_CANOPEN]        = "rx_canopen",
+};
+
+static void Prof_Dump(void)
+{
+    Prof_Stats_t s;
+    char msg[112];
+
+    for (uint32_t site = 0; site < PROF_SITE_COUNT; site++)
+    {
+        Prof_Get((Prof_Site_t)site, &s);
+        if (s.count == 0U) continue;
+
+        snprintf(msg, sizeof(msg), "%s n %lu min %lu mean %lu max %lu cyc", _siteName[site],
+                 (unsigned long)s.count, (unsigned long)s.min,
+                 (unsigned long)(s.total / s.count), (unsigned long)s.max);
+        UART_Log("PROF", msg);
+
+        int len = snprintf(msg, sizeof(msg), "%s hist", _siteName[site]);
+        for (uint32_t bin = 0; bin < PROF_HIST_BINS && len < (int)sizeof(msg); bin++)
+        {
+            if (s.hist[bin] == 0U) continue;
+            len += snprintf(msg + len, sizeof(msg) - len, " %lu:%lu",
+                            (unsigned long)bin, (unsigned long)s.hist[bin]);
+        }
+        UART_Log("PROF", msg);
+    }
+}
+#endif
+
+/* ─────────────────────────────────────────────────
+ * Prof_Service — from a low-priority task. Runs a dump
+ * requested over OD 0x2800:01
+ * ───────────────────────────────────────────────── */
+void Prof_Service(void)
+{
+    uint8_t request = Prof_Ctrl.request;
+
+    if (request != PROF_REQ_DUMP && request != PROF_REQ_DUMP_RESET)
+    {
+        Prof_Ctrl.request = 0;
+        return;
+    }
+
+#if PROF_ENABLE
+    Prof_Dump();
+#else
+    UART_Log("PROF", "Not in this build (PROF_ENABLE 0)");
+#endif
+
+    if (request == PROF_REQ_DUMP_RESET)
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        memset(_stats, 0, sizeof(_stats));
+        __set_PRIMASK(primask);
+    }
+    Prof_Ctrl.request = 0;
+}
@@ -0,0 +1,30 @@
+/*
+ * sensor_sim.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "sensor_sim.h"
+
+/* ─────────────────────────────────────────────────
+ * Sim_Sample
+ * One ramp step every stepMs (RPM +100, TEMP +1, both
+ * wrapping), a little deterministic RPM noise, and a
+ * SIM_SPIKE_WIDTH_MS spike every SIM_SPIKE_PERIOD_MS
+ * ───────────────────────────────────────────────── */
+void Sim_Sample(uint32_t ms, uint16_t stepMs, int32_t *rpm, int32_t *temp)
+{
+    uint32_t step  = ms / (stepMs ? stepMs : 1);
+    int32_t  noise = (int32_t)((ms * 2654435761U) >> 27) - SIM_RPM_NOISE;
+
+    *rpm  = SIM_RPM_MIN + (int32_t)(step % ((SIM_RPM_MAX - SIM_RPM_MIN) / SIM_RPM_STEP + 1)) * SIM_RPM_STEP;
+    *rpm += noise;
+    if (ms % SIM_SPIKE_PERIOD_MS < SIM_SPIKE_WIDTH_MS)
+    {
+        *rpm += SIM_SPIKE_RPM;
+    }
+
+    *temp = SIM_TEMP_MIN + (int32_t)(step % (SIM_TEMP_MAX - SIM_TEMP_MIN + 1));
+}
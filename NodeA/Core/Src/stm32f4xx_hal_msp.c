@@ -112,7 +112,9 @@ void HAL_CAN_MspInit(CAN_HandleTypeDef* hcan)
     HAL_NVIC_SetPriority(CAN1_RX0_IRQn, 5, 0);
     HAL_NVIC_EnableIRQ(CAN1_RX0_IRQn);
   /* USER CODE BEGIN CAN1_MspInit 1 */
-
+    /* TX-complete — time-stamps outgoing SYNC frames */
+    HAL_NVIC_SetPriority(CAN1_TX_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(CAN1_TX_IRQn);
   /* USER CODE END CAN1_MspInit 1 */
 
   }
@@ -217,5 +219,36 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* huart)
 }
 
 /* USER CODE BEGIN 1 */
+/**
+* @brief TIM OC MSP Initialization — TIM2 time-sync clock
+* @param htim: TIM handle pointer
+*/
+void HAL_TIM_OC_MspInit(TIM_HandleTypeDef* htim)
+{
+  if(htim->Instance==TIM2)
+  {
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    /* TIM2 interrupt Init — CC1 sampling trigger */
+    HAL_NVIC_SetPriority(TIM2_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+  }
+}
 
+/**
+* @brief TIM Base MSP Initialization — TIM3 acquisition timer
+*        (TIM1, the HAL timebase, is set up in its own file)
+* @param htim_base: TIM handle pointer
+*/
+void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
+{
+  if(htim_base->Instance==TIM3)
+  {
+    __HAL_RCC_TIM3_CLK_ENABLE();
+
+    /* TIM3 interrupt Init — ACQ_RATE_HZ sampling */
+    HAL_NVIC_SetPriority(TIM3_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(TIM3_IRQn);
+  }
+}
 /* USER CODE END 1 */
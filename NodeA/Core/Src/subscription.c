@@ -0,0 +1,157 @@
+/*
+ * subscription.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "subscription.h"
+#include "can_app.h"
+#include "uart_log.h"
+
+/* ── Subscriber Table ────────────────────────── */
+typedef struct {
+    bool     active;
+    uint8_t  id;
+    uint32_t lastSeenMs;
+    uint16_t periodMs[COV_SIG_COUNT];   /* 0 = not subscribed */
+} SUB_Subscriber_t;
+
+static SUB_Subscriber_t Subscribers[SUB_MAX_SUBSCRIBERS];
+
+/* Fastest requested period per signal — read by the sensor active object each sample */
+static volatile uint16_t EffectivePeriod[COV_SIG_COUNT] = {
+    SUB_DEFAULT_PERIOD_MS, SUB_DEFAULT_PERIOD_MS
+};
+
+/* ─────────────────────────────────────────────────
+ * Recompute the per-signal rate (max rate = min period)
+ * Caller holds the kernel lock
+ * ───────────────────────────────────────────────── */
+static void SUB_Recompute(void)
+{
+    for (int sig = 0; sig < COV_SIG_COUNT; sig++)
+    {
+        uint16_t best = 0;
+
+        for (int i = 0; i < SUB_MAX_SUBSCRIBERS; i++)
+        {
+            uint16_t p = Subscribers[i].periodMs[sig];
+            if (Subscribers[i].active && p != 0 && (best == 0 || p < best))
+            {
+                best = p;
+            }
+        }
+        EffectivePeriod[sig] = best ? best : SUB_DEFAULT_PERIOD_MS;
+    }
+}
+
+static SUB_Subscriber_t *SUB_Find(uint8_t id, bool create)
+{
+    SUB_Subscriber_t *freeSlot = NULL;
+
+    for (int i = 0; i < SUB_MAX_SUBSCRIBERS; i++)
+    {
+        if (Subscribers[i].active && Subscribers[i].id == id)
+        {
+            return &Subscribers[i];
+        }
+        if (!Subscribers[i].active && freeSlot == NULL)
+        {
+            freeSlot = &Subscribers[i];
+        }
+    }
+
+    if (create && freeSlot != NULL)
+    {
+        memset(freeSlot, 0, sizeof(*freeSlot));
+        freeSlot->active = true;
+        freeSlot->id     = id;
+    }
+    return create ? freeSlot : NULL;
+}
+
+/* ─────────────────────────────────────────────────
+ * SUB_HandleSubscribe
+ * [0] subscriber ID, [1] signal, [2..3] period ms (0 = unsubscribe)
+ * ───────────────────────────────────────────────── */
+void SUB_HandleSubscribe(const uint8_t *data, uint8_t dlc, uint32_t nowMs)
+{
+    uint8_t  subId  = data[0];
+    uint8_t  signal = data[1];
+    uint16_t period = ((uint16_t)data[2] << 8) | data[3];
+    char     msg[64];
+
+    if (dlc < 4 || signal >= COV_SIG_COUNT)
+    {
+        UART_Log_Int("SUB", "Bad subscribe for signal", signal);
+        return;
+    }
+
+    osKernelLock();
+    SUB_Subscriber_t *sub = SUB_Find(subId, true);
+    if (sub != NULL)
+    {
+        sub->lastSeenMs       = nowMs;
+        sub->periodMs[signal] = period;
+        SUB_Recompute();
+    }
+    osKernelUnlock();
+
+    if (sub == NULL)
+    {
+        UART_Log_Int("SUB", "Table full, rejected subscriber", subId);
+        return;
+    }
+
+    snprintf(msg, sizeof(msg), "Node %u signal %u period %ums -> effective %ums",
+             subId, signal, period, EffectivePeriod[signal]);
+    UART_Log("SUB", msg);
+}
+
+/* ─────────────────────────────────────────────────
+ * SUB_HandleHeartbeat — keeps a subscriber alive
+ * ───────────────────────────────────────────────── */
+void SUB_HandleHeartbeat(uint8_t subscriberId, uint32_t nowMs)
+{
+    osKernelLock();
+    SUB_Subscriber_t *sub = SUB_Find(subscriberId, false);
+    if (sub != NULL)
+    {
+        sub->lastSeenMs = nowMs;
+    }
+    osKernelUnlock();
+}
+
+/* ─────────────────────────────────────────────────
+ * SUB_Expire — drop subscribers whose heartbeat stopped
+ * ───────────────────────────────────────────────── */
+void SUB_Expire(uint32_t nowMs)
+{
+    for (int i = 0; i < SUB_MAX_SUBSCRIBERS; i++)
+    {
+        bool expired = false;
+        uint8_t id = 0;
+
+        osKernelLock();
+        if (Subscribers[i].active && (nowMs - Subscribers[i].lastSeenMs) > SUB_EXPIRY_MS)
+        {
+            Subscribers[i].active = false;
+            id = Subscribers[i].id;
+            expired = true;
+            SUB_Recompute();
+        }
+        osKernelUnlock();
+
+        if (expired)
+        {
+            UART_Log_Int("SUB", "Heartbeat lost, subscriptions expired for node", id);
+        }
+    }
+}
+
+uint16_t SUB_EffectivePeriod(COV_SignalId_t sig)
+{
+    return EffectivePeriod[sig];
+}
@@ -8,133 +8,468 @@
 
 #include "tasks.h"
 #include "main.h"
+#include "co_od.h"
+#include "cov.h"
+#include "subscription.h"
+#include "timesync.h"
+#include "acq.h"
+#include "power.h"
+#include "trace.h"
+#include "prof.h"
 
-/* ── Log Queue ───────────────────────────────── */
-osMessageQueueId_t logQueueHandle;
+/* ── Threads (one per priority level, started in main.c) ── */
+AO_Thread_t HighThread;
+AO_Thread_t AboveThread;
+AO_Thread_t NormalThread;
+AO_Thread_t LowThread;
+
+/* ── Signals, per active object ──────────────── */
+enum {
+    CO_SIG_PROCESS = AO_SIG_USER,
+};
+
+enum {
+    RX_SIG_FRAME = AO_SIG_USER,     /* CAN_Frame_t from the RX ISR */
+};
+
+enum {
+    SENSOR_SIG_SAMPLE = AO_SIG_USER,    /* Synchronised trigger, TIM2 ISR */
+    SENSOR_SIG_WATCHDOG,                /* No trigger for two periods */
+    SENSOR_SIG_BEAT,
+    SENSOR_SIG_DIAG,
+    SENSOR_SIG_STATS,
+};
+
+enum {
+    BEAT_SIG_TICK = AO_SIG_USER,
+};
+
+enum {
+    LOG_SIG_FRAME = AO_SIG_USER,
+};
+
+/* ── Active Objects ──────────────────────────── */
+static void Canopen_Active(AO_Active_t *me, const AO_Event_t *e);
+static void Rx_Active(AO_Active_t *me, const AO_Event_t *e);
+static void Sensor_Active(AO_Active_t *me, const AO_Event_t *e);
+static void Heartbeat_Active(AO_Active_t *me, const AO_Event_t *e);
+static void Log_Active(AO_Active_t *me, const AO_Event_t *e);
+
+AO_Active_t CanopenAO   = AO_ACTIVE(Canopen_Active,   "CANOPEN");
+AO_Active_t RxAO        = AO_ACTIVE(Rx_Active,        "CAN_RX");
+AO_Active_t SensorAO    = AO_ACTIVE(Sensor_Active,    "CAN_TX");
+AO_Active_t HeartbeatAO = AO_ACTIVE(Heartbeat_Active, "HEARTBEAT");
+AO_Active_t LogAO       = AO_ACTIVE(Log_Active,       "LOG");
+
+/* ── Events ──────────────────────────────────── */
+static const AO_Event_t SampleEvt = { SENSOR_SIG_SAMPLE, 0 };
+
+static AO_TimeEvt_t ProcessEvt  = AO_TIME_EVT(&CanopenAO,   CO_SIG_PROCESS);
+static AO_TimeEvt_t WatchdogEvt = AO_TIME_EVT(&SensorAO,    SENSOR_SIG_WATCHDOG);
+static AO_TimeEvt_t BeatEvt     = AO_TIME_EVT(&SensorAO,    SENSOR_SIG_BEAT);
+static AO_TimeEvt_t DiagEvt     = AO_TIME_EVT(&SensorAO,    SENSOR_SIG_DIAG);
+static AO_TimeEvt_t StatsEvt    = AO_TIME_EVT(&SensorAO,    SENSOR_SIG_STATS);
+static AO_TimeEvt_t LedEvt      = AO_TIME_EVT(&HeartbeatAO, BEAT_SIG_TICK);
+
+#define DIAG_LATCH_MS           1000
+#define STATS_MS                10000
+#define LED_MS                  500
+
+/* ── Sensor State (SensorAO only) ────────────── */
+static uint16_t     rpm;
+static int16_t      temp;
+static Dec_Window_t txWin[ACQ_CH_COUNT];
 
 /* ─────────────────────────────────────────────────
- * vHeartbeatTask
+ * Tasks_Init
+ * After the threads are started — from here on the RX
+ * ISR posts to RxAO
  * ───────────────────────────────────────────────── */
-void vHeartbeatTask(void *argument)
+void Tasks_Init(void)
 {
-    UART_Log("HEARTBEAT", "Task started");
+    CAN_App_SetRxActive(&RxAO, RX_SIG_FRAME);
+}
 
-    for(;;)
+/* ─────────────────────────────────────────────────
+ * Heartbeat_Active
+ * Lowest priority, so it also runs trace dumps — a
+ * dump blocks on the UART for a second or two
+ * ───────────────────────────────────────────────── */
+static void Heartbeat_Active(AO_Active_t *me, const AO_Event_t *e)
+{
+    switch(e->sig)
     {
-        HAL_GPIO_TogglePin(LD2_GPIO_Port, LD2_Pin);
-        osDelay(500);
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            AO_Arm(&LedEvt, 0, LED_MS);
+            break;
+
+        case BEAT_SIG_TICK:
+            HAL_GPIO_TogglePin(LD2_GPIO_Port, LD2_Pin);
+            Trace_Service();
+            Prof_Service();
+            break;
+
+        default:
+            break;
     }
 }
 
 /* ─────────────────────────────────────────────────
- * vCANTransmitTask
- * Node A broadcasts sensor data periodically
+ * LatchDiagnostics
+ * DIAG frame is never broadcast — only served on RTR:
+ * [0..3] uptime s, [4..5] RPM frames saved, [6..7] TEMP frames saved
+ * ───────────────────────────────────────────────── */
+static void LatchDiagnostics(uint32_t nowMs)
+{
+    uint32_t uptime   = nowMs / 1000;
+    uint32_t rpmSaved = COV_FramesSaved(COV_SIG_RPM);
+    uint32_t tmpSaved = COV_FramesSaved(COV_SIG_TEMP);
+    uint8_t  data[8];
+
+    if(rpmSaved > 0xFFFF) rpmSaved = 0xFFFF;
+    if(tmpSaved > 0xFFFF) tmpSaved = 0xFFFF;
+
+    data[0] = (uptime >> 24) & 0xFF;
+    data[1] = (uptime >> 16) & 0xFF;
+    data[2] = (uptime >> 8) & 0xFF;
+    data[3] = uptime & 0xFF;
+    data[4] = (rpmSaved >> 8) & 0xFF;
+    data[5] = rpmSaved & 0xFF;
+    data[6] = (tmpSaved >> 8) & 0xFF;
+    data[7] = tmpSaved & 0xFF;
+
+    CAN_App_ServeRemote(CAN_ID_DATA(SENSOR_NODE_ID, CAN_FN_DIAG), data, 8);
+}
+
+/* ─────────────────────────────────────────────────
+ * TSync_TriggerCallback (TIM2 ISR)
+ * Fires on COV_SAMPLE_PERIOD_MS boundaries of the shared
+ * bus time, so every sensor node samples in phase
+ * ───────────────────────────────────────────────── */
+void TSync_TriggerCallback(void)
+{
+    AO_Post(&SensorAO, &SampleEvt);
+}
+
+/* ─────────────────────────────────────────────────
+ * BroadcastWindow
+ * COV sees the window extreme furthest from the last value
+ * sent, so a spike that is already over still counts as a
+ * change. The window keeps growing until it is sent
  * ───────────────────────────────────────────────── */
-void vCANTransmitTask(void *argument)
+static void BroadcastWindow(COV_SignalId_t sig, Dec_Window_t *win, uint16_t periodMs, uint32_t now)
 {
-    UART_Log("CAN_TX", "Task started");
+    if(win->count == 0)
+    {
+        return;
+    }
 
-    uint16_t rpm  = 800;
-    int16_t  temp = 25;
+    if(periodMs == 0)
+    {
+        /* Nobody subscribed — nothing to accumulate for */
+        Dec_Reset(win);
+        return;
+    }
 
-    for(;;)
+    if(!COV_Update(sig, Dec_Extreme(win, COV_Signals[sig].lastSent), now, periodMs))
     {
-        /* Simulate slowly rising RPM */
-        rpm += 100;
-        if(rpm > 6000) rpm = 800;
+        return;
+    }
 
-        /* Simulate slowly rising temperature */
-        temp += 1;
-        if(temp > 100) temp = 25;
+#if ACQ_AGGREGATE
+    CAN_App_TransmitAggregate(sig, win->min, win->max, Dec_Mean(win), win->last);
+#else
+    if(sig == COV_SIG_RPM) CAN_App_TransmitRPM(win->last);
+    else                   CAN_App_TransmitTemp(win->last);
+#endif
+    Dec_Reset(win);
+}
 
-        /* Broadcast data - no ACK needed */
-        CAN_App_TransmitRPM(rpm);
-        CAN_App_TransmitTemp(temp);
-        CAN_App_TransmitHeartbeat();
+/* ─────────────────────────────────────────────────
+ * Sample
+ * Node A acquires at ACQ_RATE_HZ in the TIM3 ISR. Every
+ * COV_SAMPLE_PERIOD_MS it collects the reduced windows and
+ * broadcasts subscribed signals on change (deadband) or when
+ * the subscriber's requested period expires
+ * ───────────────────────────────────────────────── */
+static void Sample(uint32_t now)
+{
+    Dec_Window_t acq[ACQ_CH_COUNT];
 
-        osDelay(100);
+    /* Filter changes written over SDO */
+    Acq_ApplyFilters();
+
+    /* Everything sampled since the last pass, reduced */
+    if(Acq_Take(acq))
+    {
+        for(int ch = 0; ch < ACQ_CH_COUNT; ch++)
+        {
+            Dec_Merge(&txWin[ch], &acq[ch]);
+        }
+        rpm  = acq[ACQ_CH_RPM].last;
+        temp = acq[ACQ_CH_TEMP].last;
     }
+
+    /* Publish to the object dictionary for TPDO/SDO */
+    OD_rpm  = rpm;
+    OD_temp = temp;
+
+    /* Latest sample answers remote-frame polls from the RX ISR */
+    CAN_App_LatchRPM(rpm);
+    CAN_App_LatchTemp(temp);
+
+    /* Drop subscribers whose controller heartbeat stopped */
+    SUB_Expire(now);
+    uint16_t rpmPeriod  = SUB_EffectivePeriod(COV_SIG_RPM);
+    uint16_t tempPeriod = SUB_EffectivePeriod(COV_SIG_TEMP);
+
+    /* Broadcast subscribed data on change / refresh only - no ACK needed */
+    BroadcastWindow(COV_SIG_RPM,  &txWin[ACQ_CH_RPM],  rpmPeriod,  now);
+    BroadcastWindow(COV_SIG_TEMP, &txWin[ACQ_CH_TEMP], tempPeriod, now);
 }
 
 /* ─────────────────────────────────────────────────
- * vCANReceiveTask
- * Node A receives COMMANDS from Node B and ACKs them
+ * Sensor_Active
+ * Samples on the synchronised trigger — the watchdog keeps
+ * sampling going if TIM2 is ever mis-armed. The heartbeat
+ * stays strictly periodic: it is the liveness signal
  * ───────────────────────────────────────────────── */
-void vCANReceiveTask(void *argument)
+static void Sensor_Active(AO_Active_t *me, const AO_Event_t *e)
 {
-    UART_Log("CAN_RX", "Task started");
+    uint32_t now = osKernelGetTickCount();
+
+    switch(e->sig)
+    {
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            for(int ch = 0; ch < ACQ_CH_COUNT; ch++)
+            {
+                Dec_Reset(&txWin[ch]);
+            }
+            AO_Arm(&BeatEvt,     OD_txPeriodMs, 0);
+            AO_Arm(&DiagEvt,     0,        DIAG_LATCH_MS);
+            AO_Arm(&StatsEvt,    STATS_MS, STATS_MS);
+            AO_Arm(&WatchdogEvt, 2 * COV_SAMPLE_PERIOD_MS, 0);
+            TSync_StartTrigger(COV_SAMPLE_PERIOD_MS * 1000U);
+            break;
+
+        case SENSOR_SIG_SAMPLE:
+        case SENSOR_SIG_WATCHDOG:
+            Sample(now);
+            AO_Arm(&WatchdogEvt, 2 * COV_SAMPLE_PERIOD_MS, 0);
+            break;
 
-    typedef struct {
-        uint32_t id;
-        uint8_t  data[8];
-        uint8_t  dlc;
-    } CAN_Frame_t;
+        case SENSOR_SIG_BEAT:
+            /* Re-armed each time — the period may change over SDO,
+             * within the range in co_od.c */
+            CAN_App_TransmitHeartbeat();
+            AO_Arm(&BeatEvt, OD_txPeriodMs, 0);
+            break;
 
-    CAN_Frame_t frame;
+        case SENSOR_SIG_DIAG:
+            LatchDiagnostics(now);
+            break;
 
-    for(;;)
+        case SENSOR_SIG_STATS:
+            COV_LogStats();
+            CAN_Frame_LogStats();
+            Acq_LogStats();
+            Power_LogStats();
+            CAN_App_LogRxIsrStats();
+            CAN_App_LogLatency();
+            AO_LogStats(&HighThread);
+            AO_LogStats(&AboveThread);
+            AO_LogStats(&NormalThread);
+            AO_LogStats(&LowThread);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * ReleaseFrame
+ * Last stop for a frame RxAO has handled — either
+ * straight back to the pool or on to LogAO
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void ReleaseFrame(CAN_Frame_t *frame)
+{
+#if CAN_FRAME_TRACE
+    frame->evt.sig = LOG_SIG_FRAME;
+    if(AO_Post(&LogAO, &frame->evt))
     {
-        if(osMessageQueueGet(canRxQueueHandle, &frame, NULL, osWaitForever) == osOK)
+        return;
+    }
+#endif
+    CAN_Frame_Free(frame);
+}
+
+/* ─────────────────────────────────────────────────
+ * HandleFrame
+ * Node A receives COMMANDS from Node B and ACKs them
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void HandleFrame(CAN_Frame_t *frame)
+{
+    CAN_App_RxDequeued(frame);
+
+    switch(frame->id)
+    {
+        case CAN_ID_CMD(SENSOR_NODE_ID, CAN_FN_COMMAND):
         {
-            switch(frame.id)
+            PROF_BEGIN(PROF_RX_COMMAND);
+            uint8_t cmd = frame->data[0];
+
+            /* IMMEDIATELY send ACK */
+            TRACE_MARK(TRACE_MARK_CMD, cmd);
+            CAN_App_TransmitAck(cmd);
+            TRACE_MARK(TRACE_MARK_ACK, cmd);
+
+            /* Handle the command */
+            switch(cmd)
             {
-                case CAN_ID_COMMAND:
-                {
-                    uint8_t cmd = frame.data[0];
-
-                    /* IMMEDIATELY send ACK */
-                    CAN_App_TransmitAck(cmd);
-
-                    /* Handle the command */
-                    switch(cmd)
-                    {
-                        case CMD_WARNING_HIGH_RPM:
-                            UART_Log("COMMAND", "Node B detected HIGH RPM!");
-                            // Take action: reduce throttle, log event, etc.
-                            break;
-
-                        case CMD_WARNING_HIGH_TEMP:
-                            UART_Log("COMMAND", "Node B detected HIGH TEMP!");
-                            // Take action: activate cooling, reduce load, etc.
-                            break;
-
-                        case CMD_REDUCE_POWER:
-                            UART_Log("COMMAND", "Reducing power as requested");
-                            break;
-
-                        case CMD_ACTIVATE_COOLING:
-                            UART_Log("COMMAND", "Activating cooling system");
-                            break;
-
-                        default:
-                            UART_Log_Int("COMMAND", "Unknown command", cmd);
-                            break;
-                    }
+                case CMD_WARNING_HIGH_RPM:
+                    UART_Log("COMMAND", "Node B detected HIGH RPM!");
+                    // Take action: reduce throttle, log event, etc.
+                    break;
+
+                case CMD_WARNING_HIGH_TEMP:
+                    UART_Log("COMMAND", "Node B detected HIGH TEMP!");
+                    // Take action: activate cooling, reduce load, etc.
+                    break;
+
+                case CMD_REDUCE_POWER:
+                    UART_Log("COMMAND", "Reducing power as requested");
+                    break;
+
+                case CMD_ACTIVATE_COOLING:
+                    UART_Log("COMMAND", "Activating cooling system");
                     break;
-                }
 
                 default:
-                    // Ignore other messages (Node A doesn't care about HEARTBEAT from B, etc.)
+                    UART_Log_Int("COMMAND", "Unknown command", cmd);
                     break;
             }
+            PROF_END(PROF_RX_COMMAND);
+            break;
+        }
+
+        case CAN_ID_SYNC_FOLLOWUP:
+        {
+            PROF_BEGIN(PROF_RX_FOLLOWUP);
+            TSync_OnFollowUp(frame->data, frame->dlc);
+            PROF_END(PROF_RX_FOLLOWUP);
+            break;
         }
+
+        case CAN_ID_CMD(SENSOR_NODE_ID, CAN_FN_SUBSCRIBE):
+        {
+            PROF_BEGIN(PROF_RX_SUBSCRIBE);
+            SUB_HandleSubscribe(frame->data, frame->dlc, osKernelGetTickCount());
+            PROF_END(PROF_RX_SUBSCRIBE);
+            break;
+        }
+
+        case CAN_ID_CTRL_HEARTBEAT:
+        {
+            PROF_BEGIN(PROF_RX_CTRL_HEARTBEAT);
+            SUB_HandleHeartbeat(frame->data[0], osKernelGetTickCount());
+            PROF_END(PROF_RX_CTRL_HEARTBEAT);
+            break;
+        }
+
+        default:
+        {
+            /* SDO requests; ignore everything else */
+            PROF_BEGIN(PROF_RX_CANOPEN);
+            CANopen_ProcessFrame(frame->id, frame->data, frame->dlc);
+            PROF_END(PROF_RX_CANOPEN);
+            break;
+        }
+    }
+
+    ReleaseFrame(frame);
+    CAN_App_ApplyBitrate();
+}
+
+/* ─────────────────────────────────────────────────
+ * Rx_Active
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void Rx_Active(AO_Active_t *me, const AO_Event_t *e)
+{
+    switch(e->sig)
+    {
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            break;
+
+        case RX_SIG_FRAME:
+            HandleFrame((CAN_Frame_t *)e);
+            break;
+
+        default:
+            break;
     }
 }
 
 /* ─────────────────────────────────────────────────
- * vUARTLogTask
+ * Canopen_Active
+ * Runs TPDO event timers — a one-shot time event re-armed
+ * for whenever the next one is due
  * ───────────────────────────────────────────────── */
-void vUARTLogTask(void *argument)
+static void Canopen_Active(AO_Active_t *me, const AO_Event_t *e)
 {
-    UART_Log("LOG", "Task started");
+    switch(e->sig)
+    {
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            AO_Arm(&ProcessEvt, 0, 0);
+            break;
+
+        case CO_SIG_PROCESS:
+        {
+            uint32_t sleepMs = CANopen_Process(osKernelGetTickCount());
+            AO_Arm(&ProcessEvt, sleepMs ? sleepMs : 1, 0);
+            break;
+        }
 
-    char msg[128];
+        default:
+            break;
+    }
+}
 
-    for(;;)
+/* ─────────────────────────────────────────────────
+ * Log_Active
+ * Prints frames handed over by RxAO (CAN_FRAME_TRACE)
+ * and returns them to the pool
+ * ───────────────────────────────────────────────── */
+static void Log_Active(AO_Active_t *me, const AO_Event_t *e)
+{
+    switch(e->sig)
     {
-        if(osMessageQueueGet(logQueueHandle, msg, NULL, osWaitForever) == osOK)
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            break;
+
+        case LOG_SIG_FRAME:
         {
-            UART_Log("LOG", msg);
+            CAN_Frame_t *frame = (CAN_Frame_t *)e;
+            char msg[64];
+
+            int len = snprintf(msg, sizeof(msg), "0x%03lX [%u]", (unsigned long)frame->id, frame->dlc);
+
+            for(uint8_t i = 0; i < frame->dlc && i < 8; i++)
+            {
+                len += snprintf(msg + len, sizeof(msg) - len, " %02X", frame->data[i]);
+            }
+
+            UART_Log("TRACE", msg);
+            CAN_Frame_Free(frame);
+            break;
         }
+
+        default:
+            break;
     }
 }
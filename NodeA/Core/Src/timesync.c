@@ -0,0 +1,315 @@
+/*
+ * timesync.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "timesync.h"
+#include "can_app.h"
+#include "uart_log.h"
+#include "cmsis_os.h"
+#include <stdio.h>
+
+#define TSYNC_FLAG_TX_DONE      0x0001U
+
+/* SYNC (0x6E0) loses arbitration to every data, command, heartbeat and
+ * SDO frame, so its TX-complete wait is sized on what can be queued
+ * ahead of it: a 32-node bus with all three mailboxes of every node
+ * loaded, 8-byte frames at worst-case stuffing */
+#define TSYNC_QUEUE_FRAMES      (32U * 3U)
+#define TSYNC_FRAME_BITS        135U    /* 108 + 24 stuff bits + 3 IFS */
+
+/* ── Clock Model: global = refGlobal + dt + dt * driftPpb / 1e9 ── */
+typedef struct {
+    uint32_t refLocal;
+    uint32_t refGlobal;
+    int32_t  driftPpb;
+    bool     valid;
+} TSync_Model_t;
+
+/* ── Private Variables ───────────────────────── */
+static TIM_HandleTypeDef *_htim;
+static bool               _master;
+static TSync_Model_t      _model;
+static uint8_t            _goodRun;
+
+/* Master */
+static uint8_t            _txSeq;
+static volatile uint32_t  _txMailbox;
+static volatile uint32_t  _txStampUs;
+static osThreadId_t       _masterThread;
+
+/* Follower */
+static volatile uint8_t   _rxSeq;
+static volatile uint32_t  _rxStampUs;
+static volatile bool      _rxPending;
+
+/* Trigger */
+static uint32_t           _trigPeriodUs;
+
+TSync_Stats_t TSync_Stats;
+
+/* ─────────────────────────────────────────────────
+ * TSync_Init
+ * htim must be a 32-bit timer (TIM2/TIM5) ticking at 1 MHz
+ * ───────────────────────────────────────────────── */
+void TSync_Init(TIM_HandleTypeDef *htim, bool master)
+{
+    _htim   = htim;
+    _master = master;
+
+    _model.refLocal  = 0;
+    _model.refGlobal = 0;
+    _model.driftPpb  = 0;
+    _model.valid     = master;      /* Master's global time is its local time */
+
+    TSync_Stats.locked = master;
+
+    HAL_TIM_Base_Start(_htim);
+    UART_Log("TSYNC", master ? "Master" : "Follower");
+}
+
+__RAM_FUNC uint32_t TSync_LocalUs(void)
+{
+    return __HAL_TIM_GET_COUNTER(_htim);
+}
+
+/* ─────────────────────────────────────────────────
+ * Local ↔ global conversion (safe from ISR)
+ * ───────────────────────────────────────────────── */
+uint32_t TSync_LocalToGlobal(uint32_t localUs)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    TSync_Model_t m = _model;
+    __set_PRIMASK(primask);
+
+    uint32_t dt = localUs - m.refLocal;
+    return m.refGlobal + dt + (int32_t)(((int64_t)dt * m.driftPpb) / 1000000000LL);
+}
+
+uint32_t TSync_GlobalToLocal(uint32_t globalUs)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    TSync_Model_t m = _model;
+    __set_PRIMASK(primask);
+
+    uint32_t dt = globalUs - m.refGlobal;
+    return m.refLocal + dt - (int32_t)(((int64_t)dt * m.driftPpb) / 1000000000LL);
+}
+
+uint32_t TSync_NowUs(void)
+{
+    return TSync_LocalToGlobal(TSync_LocalUs());
+}
+
+/* ─────────────────────────────────────────────────
+ * TSync_TxTimeoutMs — the queueing bound above at the
+ * active bitrate: 27 ms at 500k, 14 ms at 1M. Never past
+ * the next SYNC; at 125k that caps the bound at about
+ * 90 frames, and a SYNC behind more counts as missed
+ * ───────────────────────────────────────────────── */
+static uint32_t TSync_TxTimeoutMs(void)
+{
+    uint32_t bits = TSYNC_QUEUE_FRAMES * TSYNC_FRAME_BITS;
+    uint32_t ms   = (bits * 1000U + CAN_Bitrate.active - 1U) / CAN_Bitrate.active + 1U;
+
+    return ms < TSYNC_PERIOD_MS ? ms : TSYNC_PERIOD_MS;
+}
+
+/* ─────────────────────────────────────────────────
+ * Master
+ * SYNC goes out, its TX-complete interrupt captures the
+ * exact local time, FOLLOW_UP carries that time.
+ * ───────────────────────────────────────────────── */
+void TSync_MasterCycle(void)
+{
+    uint8_t  sync[1];
+    uint8_t  fup[5];
+
+    if (!_master) return;
+
+    _masterThread = osThreadGetId();
+    _txSeq++;
+    sync[0] = _txSeq;
+
+    osThreadFlagsClear(TSYNC_FLAG_TX_DONE);
+
+    /* Mailbox is written with IRQs off, before TX-complete can fire */
+    if (CAN_App_TransmitTracked(CAN_ID_SYNC, sync, 1, (uint32_t *)&_txMailbox) != HAL_OK)
+    {
+        _txMailbox = 0;
+        return;
+    }
+
+    /* SYNC waits behind every lower ID queued on the bus */
+    if (osThreadFlagsWait(TSYNC_FLAG_TX_DONE, osFlagsWaitAny, TSync_TxTimeoutMs()) != TSYNC_FLAG_TX_DONE)
+    {
+        _txMailbox = 0;
+        TSync_Stats.missed++;
+        return;
+    }
+
+    fup[0] = _txSeq;
+    fup[1] = (_txStampUs >> 24) & 0xFF;
+    fup[2] = (_txStampUs >> 16) & 0xFF;
+    fup[3] = (_txStampUs >> 8) & 0xFF;
+    fup[4] = _txStampUs & 0xFF;
+    CAN_App_Transmit(CAN_ID_SYNC_FOLLOWUP, fup, 5);
+    TSync_Stats.syncs++;
+}
+
+__RAM_FUNC void TSync_OnTxCompleteISR(uint32_t mailbox, uint32_t localUs)
+{
+    if (_master && mailbox == _txMailbox)
+    {
+        _txMailbox = 0;
+        _txStampUs = localUs;
+        osThreadFlagsSet(_masterThread, TSYNC_FLAG_TX_DONE);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Follower
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC void TSync_OnSyncRxISR(const uint8_t *data, uint32_t localUs)
+{
+    _rxSeq     = data[0];
+    _rxStampUs = localUs;
+    _rxPending = true;
+}
+
+void TSync_OnFollowUp(const uint8_t *data, uint8_t dlc)
+{
+    if (_master || dlc < 5) return;
+
+    uint8_t  seq      = data[0];
+    uint32_t masterUs = ((uint32_t)data[1] << 24) | ((uint32_t)data[2] << 16) |
+                        ((uint32_t)data[3] << 8)  |  (uint32_t)data[4];
+
+    if (!_rxPending || seq != _rxSeq)
+    {
+        TSync_Stats.missed++;
+        return;
+    }
+    _rxPending = false;
+
+    uint32_t localUs = _rxStampUs;
+
+    if (!_model.valid)
+    {
+        /* First sync — step straight onto master time */
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        _model.refLocal  = localUs;
+        _model.refGlobal = masterUs;
+        _model.valid     = true;
+        __set_PRIMASK(primask);
+        return;
+    }
+
+    int32_t  err      = (int32_t)(masterUs - TSync_LocalToGlobal(localUs));
+    uint32_t interval = localUs - _model.refLocal;
+    int32_t  rateErr  = 0;
+
+    if (interval > 1000)
+    {
+        rateErr = (int32_t)(((int64_t)err * 1000000000LL) / interval);
+    }
+
+    /* Step offset, slew drift — both updated atomically for ISR readers */
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    _model.driftPpb += rateErr >> TSYNC_DRIFT_GAIN_SHIFT;
+    _model.refLocal  = localUs;
+    _model.refGlobal = masterUs;
+    __set_PRIMASK(primask);
+
+    uint32_t absErr = (err < 0) ? (uint32_t)(-err) : (uint32_t)err;
+
+    TSync_Stats.offsetUs = err;
+    TSync_Stats.driftPpb = _model.driftPpb;
+    TSync_Stats.syncs++;
+
+    if (absErr <= TSYNC_LOCK_US)
+    {
+        if (_goodRun < TSYNC_LOCK_COUNT) _goodRun++;
+    }
+    else
+    {
+        _goodRun = 0;
+    }
+
+    if (!TSync_Stats.locked && _goodRun >= TSYNC_LOCK_COUNT)
+    {
+        TSync_Stats.locked         = 1;
+        TSync_Stats.maxAbsOffsetUs = 0;
+        UART_Log("TSYNC", "Locked to master");
+    }
+    else if (TSync_Stats.locked && _goodRun == 0)
+    {
+        TSync_Stats.locked = 0;
+        UART_Log_Int("TSYNC", "Lost lock, offset us", err);
+    }
+
+    if (TSync_Stats.locked && absErr > TSync_Stats.maxAbsOffsetUs)
+    {
+        TSync_Stats.maxAbsOffsetUs = absErr;
+    }
+
+    if (TSync_Stats.syncs % TSYNC_LOG_EVERY == 0)
+    {
+        char msg[80];
+        snprintf(msg, sizeof(msg), "offset %ldus drift %ldppb max %luus %s",
+                 (long)err, (long)_model.driftPpb,
+                 (unsigned long)TSync_Stats.maxAbsOffsetUs,
+                 TSync_Stats.locked ? "locked" : "unlocked");
+        UART_Log("TSYNC", msg);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Synchronised sampling trigger
+ * Fires TSync_TriggerCallback() on every multiple of periodUs
+ * in global time, so all followers sample in phase.
+ * ───────────────────────────────────────────────── */
+static void TSync_ArmNext(void)
+{
+    uint32_t nowG  = TSync_NowUs();
+    uint32_t nextG = (nowG / _trigPeriodUs + 1) * _trigPeriodUs;
+    uint32_t local = TSync_GlobalToLocal(nextG);
+
+    /* Boundary already passed while converting — take the one after */
+    if ((int32_t)(local - TSync_LocalUs()) <= 0)
+    {
+        local = TSync_GlobalToLocal(nextG + _trigPeriodUs);
+    }
+
+    __HAL_TIM_SET_COMPARE(_htim, TIM_CHANNEL_1, local);
+    __HAL_TIM_CLEAR_FLAG(_htim, TIM_FLAG_CC1);
+    __HAL_TIM_ENABLE_IT(_htim, TIM_IT_CC1);
+}
+
+void TSync_StartTrigger(uint32_t periodUs)
+{
+    if (periodUs == 0) return;
+
+    _trigPeriodUs = periodUs;
+    TSync_ArmNext();
+}
+
+__weak void TSync_TriggerCallback(void)
+{
+}
+
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim == _htim)
+    {
+        TSync_TriggerCallback();
+        TSync_ArmNext();
+    }
+}
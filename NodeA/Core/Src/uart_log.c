@@ -7,6 +7,7 @@
 
 
 #include "uart_log.h"
+#include "prof.h"
 
 static UART_HandleTypeDef *_huart;
 
@@ -17,14 +18,18 @@ void UART_Log_Init(UART_HandleTypeDef *huart)
 
 void UART_Log(const char *tag, const char *message)
 {
+    PROF_BEGIN(PROF_UART_LOG);
     char buf[128];
     snprintf(buf, sizeof(buf), "[%s] %s\r\n", tag, message);
     HAL_UART_Transmit(_huart, (uint8_t*)buf, strlen(buf), HAL_MAX_DELAY);
+    PROF_END(PROF_UART_LOG);
 }
 
 void UART_Log_Int(const char *tag, const char *message, int value)
 {
+    PROF_BEGIN(PROF_UART_LOG);
     char buf[128];
     snprintf(buf, sizeof(buf), "[%s] %s: %d\r\n", tag, message, value);
     HAL_UART_Transmit(_huart, (uint8_t*)buf, strlen(buf), HAL_MAX_DELAY);
+    PROF_END(PROF_UART_LOG);
 }
@@ -0,0 +1,117 @@
+/*
+ * ao.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Active objects. Each one is a state machine whose handler runs
+ *  one event to completion and never blocks waiting for the next.
+ *  Several share a thread per priority level: the thread owns one
+ *  event queue of (object, event pointer) pairs and the time events
+ *  of the objects it hosts, and sleeps until whichever comes first.
+ *  Events travel by pointer — static, from the event pool, or a CAN
+ *  frame from the frame pool.
+ */
+
+#ifndef INC_AO_H_
+#define INC_AO_H_
+
+#include "cmsis_os.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ── Configuration ───────────────────────────── */
+#define AO_MAX_PER_THREAD       4
+#define AO_EVENT_SIZE           16U     /* Largest pooled event, header included */
+#define AO_EVENT_POOL_SIZE      8U
+
+/* ── Events ──────────────────────────────────── */
+/* Signals are per active object: each numbers its own from AO_SIG_USER */
+enum {
+    AO_SIG_ENTRY = 1,           /* State entered — also the initial one, once */
+    AO_SIG_EXIT,
+    AO_SIG_USER,
+};
+
+/* Header of every event. A pooled event goes back to the event pool
+ * after dispatch; any other stays with whoever posted it (a CAN frame
+ * is freed by its handler) */
+typedef struct {
+    uint16_t sig;
+    uint8_t  pooled;
+} AO_Event_t;
+
+/* ── Active Object ───────────────────────────── */
+typedef struct AO_Active AO_Active_t;
+typedef struct AO_Thread AO_Thread_t;
+typedef void (*AO_State_t)(AO_Active_t *me, const AO_Event_t *e);
+
+struct AO_Active {
+    AO_State_t   state;
+    AO_State_t   next;          /* Set by AO_TRAN, taken after the handler returns */
+    AO_Thread_t *thread;
+    const char  *name;
+};
+
+#define AO_ACTIVE(initial, aoName)  { .state = (initial), .name = (aoName) }
+
+/* Exit the current state and enter target, once the handler returns */
+#define AO_TRAN(me, target)     ((me)->next = (target))
+
+/* ── Time Events ─────────────────────────────── */
+/* Arm and disarm from the owning thread only — its handlers or
+ * before the scheduler starts. Delays in kernel ticks (ms) */
+typedef struct AO_TimeEvt {
+    AO_Event_t         evt;     /* Dispatched as is */
+    AO_Active_t       *ao;
+    uint32_t           due;
+    uint32_t           interval;    /* 0: one-shot */
+    struct AO_TimeEvt *next;
+    bool               armed;
+} AO_TimeEvt_t;
+
+#define AO_TIME_EVT(owner, signal)  { .evt = { .sig = (signal) }, .ao = (owner) }
+
+/* ── Thread ──────────────────────────────────── */
+typedef struct {
+    AO_Active_t      *ao;
+    const AO_Event_t *evt;
+} AO_Msg_t;
+
+typedef struct {
+    uint32_t dispatched;        /* Posted events */
+    uint32_t timeouts;          /* Time events */
+    uint32_t dropped;           /* Post failed — queue full */
+} AO_Stats_t;
+
+struct AO_Thread {
+    osMessageQueueId_t queue;
+    osThreadId_t       id;
+    AO_Active_t       *ao[AO_MAX_PER_THREAD];
+    uint8_t            count;
+    AO_TimeEvt_t      *timers;  /* Armed, soonest first */
+    AO_Stats_t         stats;
+};
+
+/* Queue and thread attributes for one priority level — storage is
+ * static, from RTOS_STATIC_QUEUE / RTOS_STATIC_THREAD */
+#define AO_THREAD_ATTR(attr, threadName, words, prio, depth)                \
+    RTOS_STATIC_QUEUE(attr##Queue, threadName, depth, sizeof(AO_Msg_t));    \
+    RTOS_STATIC_THREAD(attr, threadName, words, prio)
+
+/* ── Function Declarations ───────────────────── */
+void         AO_Init(void);
+void         AO_Attach(AO_Thread_t *t, AO_Active_t *me);
+osThreadId_t AO_ThreadStart(AO_Thread_t *t, uint32_t depth,
+                            const osMessageQueueAttr_t *queueAttr, const osThreadAttr_t *threadAttr);
+
+bool         AO_Post(AO_Active_t *me, const AO_Event_t *e);    /* ISR safe, never blocks */
+void        *AO_NewEvent(uint16_t sig, size_t size);            /* ISR safe; NULL if none left */
+
+void         AO_Arm(AO_TimeEvt_t *te, uint32_t delayMs, uint32_t intervalMs);
+void         AO_Disarm(AO_TimeEvt_t *te);
+
+void         AO_LogStats(AO_Thread_t *t);
+
+#endif /* INC_AO_H_ */
@@ -10,13 +10,54 @@
 
 #include "stm32f4xx_hal.h"
 #include "cmsis_os.h"
+#include "can_frame.h"
+#include <stdbool.h>
 
-/* ── CAN Message IDs ─────────────────────────── */
-#define CAN_ID_RPM          0x100
-#define CAN_ID_TEMP         0x101
-#define CAN_ID_HEARTBEAT    0x102
-#define CAN_ID_COMMAND      0x200
-#define CAN_ID_ACK          0x201
+/* ── Node-addressed CAN IDs ──────────────────── */
+/* Sensor data:  0x100 | node << 3 | fn   (0x100–0x17F)
+ * Commands:     0x200 | node << 2 | fn   (0x200–0x23F)
+ * Node 0 keeps the original single-node IDs. */
+#define CAN_MAX_SENSOR_NODES    16
+
+#define CAN_ID_DATA_BASE        0x100U
+#define CAN_ID_CMD_BASE         0x200U
+
+#define CAN_ID_DATA(node, fn)   (CAN_ID_DATA_BASE | ((uint32_t)(node) << 3) | (fn))
+#define CAN_ID_CMD(node, fn)    (CAN_ID_CMD_BASE  | ((uint32_t)(node) << 2) | (fn))
+
+#define CAN_ID_IS_DATA(id)      (((id) & 0x780U) == CAN_ID_DATA_BASE)
+#define CAN_ID_IS_CMD(id)       (((id) & 0x7C0U) == CAN_ID_CMD_BASE)
+#define CAN_ID_DATA_NODE(id)    (((id) >> 3) & 0x0FU)
+#define CAN_ID_DATA_FN(id)      ((id) & 0x07U)
+#define CAN_ID_CMD_NODE(id)     (((id) >> 2) & 0x0FU)
+#define CAN_ID_CMD_FN(id)       ((id) & 0x03U)
+
+/* Data functions */
+#define CAN_FN_RPM              0x0
+#define CAN_FN_TEMP             0x1
+#define CAN_FN_HEARTBEAT        0x2
+#define CAN_FN_DIAG             0x3     /* Served on remote request only */
+#define CAN_FN_RPM_AGG          0x4     /* [min, max, mean, last] of a window */
+#define CAN_FN_TEMP_AGG         0x5
+
+/* Command functions */
+#define CAN_FN_COMMAND          0x0
+#define CAN_FN_ACK              0x1
+#define CAN_FN_SUBSCRIBE        0x2
+
+/* ── CAN Message IDs (node 0) ────────────────── */
+#define CAN_ID_RPM          CAN_ID_DATA(0, CAN_FN_RPM)          /* 0x100 */
+#define CAN_ID_TEMP         CAN_ID_DATA(0, CAN_FN_TEMP)         /* 0x101 */
+#define CAN_ID_HEARTBEAT    CAN_ID_DATA(0, CAN_FN_HEARTBEAT)    /* 0x102 */
+#define CAN_ID_DIAG         CAN_ID_DATA(0, CAN_FN_DIAG)         /* 0x103 */
+#define CAN_ID_RPM_AGG      CAN_ID_DATA(0, CAN_FN_RPM_AGG)      /* 0x104 */
+#define CAN_ID_TEMP_AGG     CAN_ID_DATA(0, CAN_FN_TEMP_AGG)     /* 0x105 */
+#define CAN_ID_COMMAND      CAN_ID_CMD(0, CAN_FN_COMMAND)       /* 0x200 */
+#define CAN_ID_ACK          CAN_ID_CMD(0, CAN_FN_ACK)           /* 0x201 */
+#define CAN_ID_SUBSCRIBE    CAN_ID_CMD(0, CAN_FN_SUBSCRIBE)     /* 0x202 */
+#define CAN_ID_CTRL_HEARTBEAT 0x300     /* Broadcast, not node-addressed */
+#define CAN_ID_CONFIG_REQ   0x6E2       /* Tool → controller, read/write a rule parameter */
+#define CAN_ID_CONFIG_RSP   0x6E3       /* Controller → tool, ACK with current value */
 
 /* ── Command Codes ───────────────────────────── */
 #define CMD_WARNING_HIGH_RPM    0x01
@@ -24,15 +65,70 @@
 #define CMD_REDUCE_POWER        0x03
 #define CMD_ACTIVATE_COOLING    0x04
 
-/* ── Queue Handle (ISR → Task communication) ─── */
-extern osMessageQueueId_t canRxQueueHandle;
+/* ── Subscribable Signals ────────────────────── */
+#define CAN_SIG_RPM             0x00
+#define CAN_SIG_TEMP            0x01
+
+/* ── Remote-frame Polling ────────────────────── */
+#define CAN_POLL_MAX_SLOTS      8
+
+/* ── Bitrate ─────────────────────────────────── */
+/* 125k / 250k / 500k / 1M, see can_bittiming.h. Every node on the
+ * bus must use the same value */
+#define CAN_BITRATE             500000U
+
+typedef struct {
+    uint32_t request;           /* OD writable, applied by the RX active object */
+    uint32_t active;
+} CAN_Bitrate_t;
+
+extern CAN_Bitrate_t CAN_Bitrate;
+
+/* ── Frame Latency (µs, TIM2 clock) ──────────── */
+/* RX: interrupt entry stamp → dispatched to the RX active object.
+ * TX: mailbox loaded → TX complete interrupt.
+ * Bucket upper edges in µs: 50, 100, 250, 500, 1000, 2500, 5000, ∞ */
+#define CAN_LAT_BUCKETS         8
+
+typedef struct {
+    uint32_t count;
+    uint32_t lastUs;
+    uint32_t maxUs;             /* Max ever, never reset */
+    uint32_t hist[CAN_LAT_BUCKETS];
+} CAN_Latency_t;
+
+extern CAN_Latency_t CAN_RxLatency;
+extern CAN_Latency_t CAN_TxLatency;
 
 /* ── Function Declarations ───────────────────── */
-void CAN_App_Init(CAN_HandleTypeDef *hcan);
+void CAN_App_Init(CAN_HandleTypeDef *hcan, uint8_t nodeId);
 void CAN_App_TransmitRPM(uint16_t rpm);
 void CAN_App_TransmitTemp(int16_t temp);
+void CAN_App_TransmitAggregate(uint8_t signal, int32_t min, int32_t max, int32_t mean, int32_t last);
 void CAN_App_TransmitHeartbeat(void);
-void CAN_App_TransmitCommand(uint8_t cmdCode);
+void CAN_App_TransmitCommand(uint8_t node, uint8_t cmdCode);
 void CAN_App_TransmitAck(uint8_t ackedCmd);
+void CAN_App_TransmitSubscribe(uint8_t node, uint8_t subscriberId, uint8_t signal, uint16_t periodMs);
+void CAN_App_TransmitCtrlHeartbeat(uint8_t nodeId);
+HAL_StatusTypeDef CAN_App_Transmit(uint32_t id, const uint8_t *data, uint8_t len);
+HAL_StatusTypeDef CAN_App_TransmitTracked(uint32_t id, const uint8_t *data, uint8_t len,
+                                          uint32_t *mailbox);
+
+void CAN_App_ServeRemote(uint32_t id, const uint8_t *data, uint8_t len);
+void CAN_App_LatchRPM(uint16_t rpm);
+void CAN_App_LatchTemp(int16_t temp);
+void CAN_App_RequestRemote(uint32_t id, uint8_t dlc);
+void CAN_App_GetPollStats(uint32_t *served, uint32_t *dropped);
+void CAN_App_SetRxActive(AO_Active_t *ao, uint16_t sig);
+bool CAN_App_PostFrame(CAN_Frame_t *frame);
+void CAN_App_RxDequeued(const CAN_Frame_t *frame);
+void CAN_App_LogLatency(void);
+
+HAL_StatusTypeDef CAN_App_SetBitrate(uint32_t bitrate);
+void CAN_App_ApplyBitrate(void);
+
+/* ISR fast path — weak, override to decode frames in the RX ISR */
+bool CAN_App_RxIsFastPath(uint32_t id);
+void CAN_App_RxFastPathISR(uint32_t id, const uint8_t *data, uint8_t dlc, uint32_t rxUs);
 
 #endif /* INC_CAN_APP_H_ */
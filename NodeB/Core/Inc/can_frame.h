@@ -0,0 +1,50 @@
+/*
+ * can_frame.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Received CAN frame and the fixed-block pool frames live in.
+ *  The RX ISR allocates a frame, fills it once, and from then on only
+ *  the pointer moves: posted to the RX active object as an event →
+ *  handler → logger. Whoever holds the pointer last calls
+ *  CAN_Frame_Free() — the event framework never does.
+ */
+
+#ifndef INC_CAN_FRAME_H_
+#define INC_CAN_FRAME_H_
+
+#include "ao.h"
+#include <stdint.h>
+
+/* ── Configuration ───────────────────────────── */
+#define CAN_FRAME_POOL_SIZE     16      /* Frames in flight */
+#define CAN_FRAME_TRACE         0       /* 1 = log task prints every frame */
+
+/* ── Received Frame ──────────────────────────── */
+typedef struct {
+    AO_Event_t evt;         /* First — the frame is posted as is */
+    uint32_t id;
+    uint32_t rxUs;          /* Local µs (TIM2) at RX interrupt entry */
+    uint8_t  data[8];
+    uint8_t  dlc;
+} CAN_Frame_t;
+
+/* ── Pool Statistics ─────────────────────────── */
+typedef struct {
+    uint32_t allocs;
+    uint32_t exhausted;     /* Alloc failed — frame dropped in the ISR */
+    uint32_t queueFull;     /* Alloc OK but the post failed — frame dropped */
+    uint16_t inUse;
+    uint16_t highWater;     /* Most frames ever in flight at once */
+} CAN_FramePoolStats_t;
+
+extern CAN_FramePoolStats_t CAN_FramePoolStats;
+
+/* ── Function Declarations ───────────────────── */
+void         CAN_Frame_PoolInit(void);
+CAN_Frame_t *CAN_Frame_Alloc(void);                 /* ISR safe, O(1), never blocks */
+void         CAN_Frame_Free(CAN_Frame_t *frame);    /* ISR safe, O(1) */
+void         CAN_Frame_LogStats(void);
+
+#endif /* INC_CAN_FRAME_H_ */
@@ -0,0 +1,116 @@
+/*
+ * canopen.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  CANopen-lite: constant object dictionary, PDOs driven by
+ *  precomputed byte-copy plans, expedited + segmented SDO server.
+ *  No NMT state machine — node is always OPERATIONAL.
+ */
+
+#ifndef INC_CANOPEN_H_
+#define INC_CANOPEN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ── COB-ID Function Codes (CiA 301) ─────────── */
+#define CO_COBID_TPDO1          0x180U
+#define CO_COBID_RPDO1          0x200U
+#define CO_COBID_TSDO           0x580U
+#define CO_COBID_RSDO           0x600U
+#define CO_COBID_BOOTUP         0x700U
+
+/* ── OD Entry Attributes ─────────────────────── */
+#define CO_ATTR_RO              0x01
+#define CO_ATTR_WO              0x02
+#define CO_ATTR_RW              (CO_ATTR_RO | CO_ATTR_WO)
+#define CO_ATTR_STR             0x04    /* Variable length, NUL padded */
+
+/* ── SDO Abort Codes ─────────────────────────── */
+#define CO_SDO_ABORT_TOGGLE     0x05030000UL
+#define CO_SDO_ABORT_TIMEOUT    0x05040000UL
+#define CO_SDO_ABORT_CMD        0x05040001UL
+#define CO_SDO_ABORT_WRITEONLY  0x06010001UL
+#define CO_SDO_ABORT_READONLY   0x06010002UL
+#define CO_SDO_ABORT_NO_OBJECT  0x06020000UL
+#define CO_SDO_ABORT_TYPE_LEN   0x06070010UL
+#define CO_SDO_ABORT_NO_SUB     0x06090011UL
+#define CO_SDO_ABORT_RANGE      0x06090030UL
+#define CO_SDO_ABORT_GENERAL    0x08000000UL
+
+/* ── Object Dictionary Entry (flash resident) ── */
+typedef struct {
+    uint32_t key;       /* (index << 8) | subIndex — table sorted on this */
+    void    *data;
+    uint16_t size;      /* Bytes (max length for CO_ATTR_STR) */
+    uint8_t  attr;
+} CO_OD_Entry_t;
+
+#define CO_KEY(index, sub)      (((uint32_t)(index) << 8) | (uint8_t)(sub))
+
+/* One OD row: CO_OD(index, sub, attr, variable) */
+#define CO_OD(index, sub, attr, var) \
+    { CO_KEY(index, sub), (void *)&(var), sizeof(var), (attr) }
+
+/* ── Value Range (written over SDO) ──────────── */
+/* Checked before the write is committed, which is aborted with
+ * CO_SDO_ABORT_RANGE. Numeric entries of up to four bytes only */
+typedef struct {
+    uint32_t key;
+    uint8_t  isSigned;
+    int32_t  min;
+    int32_t  max;
+} CO_OD_Range_t;
+
+#define CO_RANGE(index, sub, isSigned, min, max) \
+    { CO_KEY(index, sub), (isSigned), (min), (max) }
+
+/* ── PDO Copy Plan ───────────────────────────── */
+/* One source/destination byte per frame byte, unused slots point at a
+ * scratch byte. Pack/unpack is then eight unconditional byte moves. */
+typedef struct {
+    uint32_t  cobId;
+    uint8_t   dlc;
+    uint8_t  *bytes[8];
+} CO_PDO_Plan_t;
+
+/* Byte pointers of a little-endian object, for building plans */
+#define CO_MAP_U8(var)          (uint8_t *)&(var)
+#define CO_MAP_U16(var)         (uint8_t *)&(var), (uint8_t *)&(var) + 1
+#define CO_MAP_U32(var)         (uint8_t *)&(var),     (uint8_t *)&(var) + 1, \
+                                (uint8_t *)&(var) + 2, (uint8_t *)&(var) + 3
+#define CO_MAP_PAD              &CO_PDO_Scratch
+
+extern uint8_t CO_PDO_Scratch;
+
+/* ── Node Description (provided by co_od.c) ──── */
+typedef struct {
+    uint8_t               nodeId;
+    const CO_OD_Entry_t  *od;
+    uint16_t              odCount;
+    const CO_OD_Range_t  *ranges;
+    uint8_t               rangeCount;
+    const CO_PDO_Plan_t  *tpdo;
+    uint16_t             *tpdoEventTimer;   /* ms, 0 = disabled, per TPDO */
+    uint8_t               tpdoCount;
+    const CO_PDO_Plan_t  *rpdo;
+    uint8_t               rpdoCount;
+    void                (*written)(const CO_OD_Entry_t *entry);    /* After an SDO download, or NULL */
+    bool                (*check)(const CO_OD_Entry_t *entry, const uint8_t *src, uint16_t len);  /* Limits that depend on other objects, or NULL */
+} CO_Node_t;
+
+extern const CO_Node_t CO_Node;
+
+/* ── Function Declarations ───────────────────── */
+void     CANopen_Init(void);
+bool     CANopen_ProcessFrame(uint32_t id, const uint8_t *data, uint8_t dlc);
+uint32_t CANopen_Process(uint32_t nowMs);
+uint32_t CANopen_SdoDueMs(uint32_t nowMs);
+void     CANopen_SendTPDO(uint8_t n);
+
+const CO_OD_Entry_t *CANopen_Find(uint16_t index, uint8_t sub);
+
+#endif /* INC_CANOPEN_H_ */
@@ -0,0 +1,29 @@
+/*
+ * co_od.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Node B (controller) object dictionary.
+ */
+
+#ifndef INC_CO_OD_H_
+#define INC_CO_OD_H_
+
+#include "canopen.h"
+
+/* ── CANopen Node IDs ────────────────────────── */
+#define CO_NODE_ID_SENSOR       0x40    /* + sensor node number */
+#define CO_NODE_ID_CONTROLLER   0x7F
+#define CO_NODE_ID              CO_NODE_ID_CONTROLLER
+
+/* ── Process Data (0x2000, mapped from sensor TPDO1) ── */
+extern uint16_t OD_rpm;                 /* 0x2000:01 */
+extern int16_t  OD_temp;                /* 0x2000:02 */
+
+/* ── Rule Parameters (0x2100) ────────────────── */
+extern uint16_t OD_rpmLimit;            /* 0x2100:01 */
+extern int16_t  OD_tempLimit;           /* 0x2100:02 */
+extern uint16_t OD_ackTimeoutMs;        /* 0x2100:03 */
+
+#endif /* INC_CO_OD_H_ */
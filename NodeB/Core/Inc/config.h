@@ -0,0 +1,56 @@
+/*
+ * config.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Runtime rule parameters over CAN, persisted in flash_kv.
+ *  Request  0x6E2: [op, key, v3, v2, v1, v0]          (value int32 BE)
+ *  Response 0x6E3: [op, key, status, v3, v2, v1, v0]  (current value)
+ *  Every request is answered — the response is the ACK.
+ */
+
+#ifndef INC_CONFIG_H_
+#define INC_CONFIG_H_
+
+#include "ao.h"
+#include "canopen.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ── Operations ──────────────────────────────── */
+#define CFG_OP_READ             0x01
+#define CFG_OP_WRITE            0x02
+
+/* ── Status Codes ────────────────────────────── */
+#define CFG_STATUS_OK           0x00
+#define CFG_STATUS_NO_KEY       0x01
+#define CFG_STATUS_RANGE        0x02
+#define CFG_STATUS_BAD_OP       0x03
+#define CFG_STATUS_NOT_SAVED    0x04    /* Applied, but no event left to persist it */
+
+/* ── Keys (also the flash_kv keys) ───────────── */
+#define CFG_KEY_RPM_LIMIT       0x01
+#define CFG_KEY_TEMP_LIMIT      0x02
+#define CFG_KEY_ACK_TIMEOUT     0x03
+
+/* ── Ranges (also OD 0x2100:01–03 over SDO) ──── */
+#define CFG_RPM_LIMIT_MIN       0
+#define CFG_RPM_LIMIT_MAX       20000
+#define CFG_TEMP_LIMIT_MIN      (-40)
+#define CFG_TEMP_LIMIT_MAX      200
+#define CFG_ACK_TIMEOUT_MIN     10
+#define CFG_ACK_TIMEOUT_MAX     5000
+
+/* ── Persist Active Object ───────────────────── */
+/* Low priority, so the write is never done on the RX thread. A
+ * program or sector erase still stalls the whole CPU (flash_kv_port_
+ * stm32.c). Takes one pooled event per accepted write */
+extern AO_Active_t Cfg_PersistAO;
+
+/* ── Function Declarations ───────────────────── */
+void Cfg_Init(void);
+void Cfg_HandleRequest(const uint8_t *data, uint8_t dlc);
+void Cfg_OdWritten(const CO_OD_Entry_t *entry);
+
+#endif /* INC_CONFIG_H_ */
@@ -0,0 +1,58 @@
+/*
+ * flash_kv.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Log-structured key/value store in two internal flash sectors.
+ *  Every write appends an 8-byte record to the active sector; when it
+ *  fills, live values are compacted into the other sector, so erases
+ *  alternate between the two. Boot reads the active sector once
+ *  (O(records)) into a RAM cache; reads never touch flash again.
+ *
+ *  No HAL dependency — the flash itself is reached through FKV_Flash,
+ *  provided by flash_kv_port_stm32.c on target or flash_kv_port_ram.c
+ *  (build with FKV_HOST_STANDIN) on a host.
+ */
+
+#ifndef INC_FLASH_KV_H_
+#define INC_FLASH_KV_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ── Configuration ───────────────────────────── */
+#define FKV_MAX_KEYS            16      /* Keys 1 .. FKV_MAX_KEYS-1 */
+
+/* ── Flash Port ──────────────────────────────── */
+/* NOR semantics: erase sets all bits, program can only clear bits,
+ * in 32-bit words. */
+typedef struct {
+    uint8_t  *sector[2];
+    uint32_t  sectorSize;
+    bool    (*erase)(uint8_t index);
+    bool    (*program)(uint32_t *dst, uint32_t word);
+} FKV_Flash_t;
+
+extern const FKV_Flash_t FKV_Flash;
+
+/* ── Statistics ──────────────────────────────── */
+typedef struct {
+    uint32_t records;       /* Used in the active sector */
+    uint32_t capacity;      /* Records per sector */
+    uint32_t writes;
+    uint32_t compactions;
+    uint32_t errors;        /* Program/erase failures, torn records skipped */
+    uint32_t generation;    /* Active sector sequence number */
+    uint32_t maxEraseUs;    /* Longest CPU stall so far — set by the port, 0 on a host */
+    uint32_t maxProgramUs;
+} FKV_Stats_t;
+
+extern FKV_Stats_t FKV_Stats;
+
+/* ── Function Declarations ───────────────────── */
+void FKV_Init(void);
+bool FKV_Get(uint16_t key, uint32_t *value);
+bool FKV_Set(uint16_t key, uint32_t value);     /* Blocks on flash — call from a low-priority task */
+
+#endif /* INC_FLASH_KV_H_ */
@@ -0,0 +1,55 @@
+/*
+ * liveness.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Per-node heartbeat liveness monitor. Every heartbeat re-arms the
+ *  node's deadline in a hashed timer wheel; re-arm, cancel and expiry
+ *  are O(1) per node regardless of how many nodes are tracked. Also
+ *  records the heartbeat inter-arrival jitter distribution per node.
+ *  All calls come from the CAN RX active object — no locking.
+ */
+
+#ifndef INC_LIVENESS_H_
+#define INC_LIVENESS_H_
+
+#include <stdint.h>
+#include "can_app.h"
+
+/* ── Configuration ───────────────────────────── */
+#define LIVE_MAX_NODES          CAN_MAX_SENSOR_NODES
+#define LIVE_TICK_MS            10      /* Wheel resolution */
+#define LIVE_WHEEL_SLOTS        64      /* Power of two */
+#define LIVE_TIMEOUT_MS         350     /* No heartbeat for this long = lost */
+#define LIVE_JITTER_BUCKETS     8
+
+/* ── Events ──────────────────────────────────── */
+typedef enum {
+    LIVE_NODE_LOST,
+    LIVE_NODE_RECOVERED,
+} Live_Event_t;
+
+/* ── Per-node Heartbeat Statistics ───────────── */
+/* Jitter = |interval − running mean|, bucket upper edges in µs:
+ * 50, 100, 250, 500, 1000, 2500, 5000, ∞ */
+typedef struct {
+    uint32_t beats;
+    uint32_t lostCount;
+    uint32_t meanUs;            /* EWMA of the inter-arrival time */
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t jitterHist[LIVE_JITTER_BUCKETS];
+} Live_Stats_t;
+
+extern Live_Stats_t Live_Stats[LIVE_MAX_NODES];
+
+/* ── Function Declarations ───────────────────── */
+void Live_Init(uint32_t nowMs);
+void Live_OnHeartbeat(uint8_t node, uint32_t rxUs, uint32_t nowMs);
+void Live_Advance(uint32_t nowMs);
+uint32_t Live_NextMs(uint32_t nowMs);                        /* 0: nothing armed */
+void Live_LogStats(void);
+void Live_EventCallback(uint8_t node, Live_Event_t event);     /* Weak */
+
+#endif /* INC_LIVENESS_H_ */
@@ -0,0 +1,54 @@
+/*
+ * node_table.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Per-sensor-node state on the controller. One fixed entry (≤ 32
+ *  bytes) per node, indexed directly by the node field of the CAN ID,
+ *  so handling a frame costs the same for 1 node or 16. Signal values
+ *  live in signal_store.
+ */
+
+#ifndef INC_NODE_TABLE_H_
+#define INC_NODE_TABLE_H_
+
+#include "can_app.h"
+#include <stdbool.h>
+
+/* ── Per-node State ──────────────────────────── */
+typedef struct {
+    /* Hot — touched on every frame from this node */
+    uint32_t lastSeenMs;
+
+    /* ACK tracking — one outstanding command per node */
+    uint32_t cmdSentMs;
+    uint8_t  online;
+    uint8_t  awaitingAck;
+    uint8_t  pendingCmd;
+    uint8_t  reserved;
+
+    /* Statistics */
+    uint32_t rxFrames;
+    uint32_t cmdsSent;
+    uint32_t acks;
+    uint32_t ackTimeouts;
+} Node_State_t;
+
+_Static_assert(sizeof(Node_State_t) <= 32, "Node_State_t should fit one 32-byte entry");
+
+extern Node_State_t NodeTable[CAN_MAX_SENSOR_NODES];
+
+static inline Node_State_t *NodeTable_Get(uint8_t node)
+{
+    return &NodeTable[node & (CAN_MAX_SENSOR_NODES - 1)];
+}
+
+/* ── Function Declarations ───────────────────── */
+bool NodeTable_Touch(uint8_t node, uint32_t nowMs);     /* true on first sighting */
+bool NodeTable_SendCommand(uint8_t node, uint8_t cmd, uint32_t nowMs);
+void NodeTable_Ack(uint8_t node, uint8_t cmd);
+uint32_t NodeTable_CheckAckTimeouts(uint32_t nowMs, uint32_t timeoutMs);  /* ms to the next, 0: none */
+void NodeTable_LogStats(void);
+
+#endif /* INC_NODE_TABLE_H_ */
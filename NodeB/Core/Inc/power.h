@@ -0,0 +1,48 @@
+/*
+ * power.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Tickless idle support and CPU load accounting. The kernel stops
+ *  SysTick while every task is blocked and the idle task sleeps in
+ *  WFI until the next timeout or interrupt (CAN RX, TIM2/TIM3).
+ *  Hooks below are wired in through FreeRTOSConfig.h; time is taken
+ *  from the TIM2 microsecond clock, which keeps running in sleep.
+ */
+
+#ifndef INC_POWER_H_
+#define INC_POWER_H_
+
+#include <stdint.h>
+
+/* ── Running Counters ────────────────────────── */
+typedef struct {
+    uint32_t switches;          /* Context switches to a different task */
+    uint32_t idleUs;            /* Time the idle task was running */
+    uint32_t sleepUs;           /* Part of idleUs spent in WFI */
+    uint32_t sleeps;
+    uint32_t wakeCanRx;         /* Woken by CAN1 RX0 */
+    uint32_t wakeTick;          /* Woken by the expected SysTick timeout */
+    uint32_t wakeOther;
+} Power_Counters_t;
+
+/* ── Last Stats Interval (OD readable) ───────── */
+typedef struct {
+    uint32_t switchesPerSec;
+    uint16_t idlePermille;
+    uint16_t sleepPermille;
+} Power_Stats_t;
+
+extern Power_Counters_t Power_Counters;
+extern Power_Stats_t    Power_Stats;
+
+/* ── Kernel Hooks (see FreeRTOSConfig.h) ─────── */
+void Power_TaskSwitchedIn(const void *tcb, uint32_t isIdle);
+void Power_PreSleep(uint32_t *expectedIdleTicks);
+void Power_PostSleep(uint32_t *expectedIdleTicks);
+
+/* ── Function Declarations ───────────────────── */
+void Power_LogStats(void);
+
+#endif /* INC_POWER_H_ */
@@ -0,0 +1,91 @@
+/*
+ * prof.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Cycle-count profiling of the hot paths. PROF_BEGIN/PROF_END around
+ *  a block time it on DWT->CYCCNT into per-site count, min, max, mean
+ *  and a log2 histogram. Task sites count wall cycles, so preemption
+ *  by higher priorities and ISRs is included. Stats are dumped to UART
+ *  on request (OD 0x2800:01).
+ *
+ *  Compiled in for the Debug configuration (DEBUG defined) only;
+ *  a Release build leaves no trace of the macros.
+ */
+
+#ifndef INC_PROF_H_
+#define INC_PROF_H_
+
+#include "stm32f4xx_hal.h"
+#include <stdint.h>
+
+/* ── Configuration ───────────────────────────── */
+#ifndef PROF_ENABLE
+#ifdef DEBUG
+#define PROF_ENABLE             1
+#else
+#define PROF_ENABLE             0
+#endif
+#endif
+#define PROF_HIST_BINS          20U     /* Bin n: 2^n..2^(n+1)-1 cycles, the last open-ended */
+
+/* ── Sites ───────────────────────────────────── */
+typedef enum {
+    PROF_CAN_SEND,              /* CAN_SendTracked — every data/command TX */
+    PROF_CAN_RX_ISR,            /* HAL_CAN_RxFifo0MsgPendingCallback */
+    PROF_UART_LOG,              /* UART_Log / UART_Log_Int, blocking on the UART */
+    PROF_RX_SIGNAL,             /* RX dispatch, per handler; RPM/TEMP decode + rules */
+    PROF_RX_SENSOR,
+    PROF_RX_ACK,
+    PROF_RX_CONFIG,
+    PROF_RX_BOOTUP,
+    PROF_RX_CANOPEN,
+    PROF_SITE_COUNT,
+} Prof_Site_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;             /* Mean = total / count */
+    uint32_t hist[PROF_HIST_BINS];
+} Prof_Stats_t;
+
+/* ── Dump Requests (OD 0x2800) ───────────────── */
+#define PROF_REQ_DUMP           1U
+#define PROF_REQ_DUMP_RESET     2U      /* Dump, then start every site over */
+
+typedef struct {
+    uint8_t request;            /* Cleared when the dump is done */
+} Prof_Ctrl_t;
+
+extern Prof_Ctrl_t Prof_Ctrl;
+
+/* ── DWT Cycle Counter ───────────────────────── */
+/* Profiling, the trace's ISR durations and the RX/filter cost counters
+ * all read CYCCNT; each init calls this, so init order does not matter */
+static inline void Prof_CycleCounterEnable(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* ── Function Declarations ───────────────────── */
+void Prof_Init(void);
+void Prof_Record(Prof_Site_t site, uint32_t cycles);
+void Prof_Get(Prof_Site_t site, Prof_Stats_t *stats);
+void Prof_Service(void);
+
+/* ── Instrumentation ─────────────────────────── */
+/* One begin and one end per site and scope; the end may sit in a
+ * nested block */
+#if PROF_ENABLE
+#define PROF_BEGIN(site)    uint32_t _profStart_##site = DWT->CYCCNT
+#define PROF_END(site)      Prof_Record((site), DWT->CYCCNT - _profStart_##site)
+#else
+#define PROF_BEGIN(site)    do { } while (0)
+#define PROF_END(site)      do { } while (0)
+#endif
+
+#endif /* INC_PROF_H_ */
@@ -0,0 +1,66 @@
+/*
+ * rtos_config.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Every RTOS object on Node B — thread stacks, priorities, queue
+ *  depths — in one place. Control blocks, stacks and queue storage
+ *  are all static, and there is no RTOS heap (heap_none.c), so RAM
+ *  use is fixed at link time.
+ */
+
+#ifndef INC_RTOS_CONFIG_H_
+#define INC_RTOS_CONFIG_H_
+
+#include "FreeRTOS.h"
+#include "cmsis_os.h"
+#include "can_frame.h"
+#include "ao.h"
+
+/* ── Active Object Threads: stack (32-bit words), priority ── */
+/* One thread per priority level, shared by the active objects on it */
+#define THREAD_HIGH_STACK       160     /* Time sync */
+#define THREAD_HIGH_PRIO        osPriorityHigh
+#define THREAD_ABOVE_STACK      256     /* Frame dispatch, rules */
+#define THREAD_ABOVE_PRIO       osPriorityAboveNormal
+#define THREAD_NORMAL_STACK     256     /* Controller heartbeat, polls, stats */
+#define THREAD_NORMAL_PRIO      osPriorityNormal
+#define THREAD_LOW_STACK        256     /* Trace dumps: a hex line under UART_Log */
+#define THREAD_LOW_PRIO         osPriorityLow
+
+/* ── Event Queues: depth in events ───────────── */
+/* Time events never pass through a queue */
+#define QUEUE_HIGH_DEPTH        2
+#define QUEUE_ABOVE_DEPTH       (CAN_FRAME_POOL_SIZE + 2)   /* Every frame + signals updated */
+#define QUEUE_NORMAL_DEPTH      2
+#define QUEUE_LOW_DEPTH         (CAN_FRAME_POOL_SIZE + AO_EVENT_POOL_SIZE)  /* Traced frames + flash writes */
+
+/* ── Static Storage Helpers ──────────────────── */
+/* Control block + stack + attributes for one task. Use at file or
+ * function scope; everything it declares is static */
+#define RTOS_STATIC_THREAD(attr, taskName, words, prio)                     \
+    static StaticTask_t attr##Cb;                                           \
+    static uint32_t     attr##Stack[words];                                 \
+    static const osThreadAttr_t attr = {                                    \
+        .name       = taskName,                                             \
+        .cb_mem     = &attr##Cb,                                            \
+        .cb_size    = sizeof(attr##Cb),                                     \
+        .stack_mem  = attr##Stack,                                          \
+        .stack_size = sizeof(attr##Stack),                                  \
+        .priority   = prio,                                                 \
+    }
+
+/* Control block + ring storage + attributes for one message queue */
+#define RTOS_STATIC_QUEUE(attr, queueName, depth, itemSize)                 \
+    static StaticQueue_t attr##Cb;                                          \
+    static uint8_t       attr##Mem[(depth) * (itemSize)];                   \
+    static const osMessageQueueAttr_t attr = {                              \
+        .name    = queueName,                                               \
+        .cb_mem  = &attr##Cb,                                               \
+        .cb_size = sizeof(attr##Cb),                                        \
+        .mq_mem  = attr##Mem,                                               \
+        .mq_size = sizeof(attr##Mem),                                       \
+    }
+
+#endif /* INC_RTOS_CONFIG_H_ */
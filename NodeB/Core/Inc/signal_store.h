@@ -0,0 +1,102 @@
+/*
+ * signal_store.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Latest-value store for every decoded sensor signal. One flat slot
+ *  per (node, signal) holding value, time-stamps and update count.
+ *  Each slot is a seqlock: one writer per slot never blocks, any
+ *  number of task-context readers get a consistent copy without a
+ *  lock, and retry only if they raced a write.
+ *
+ *  Pure data frames (RPM, TEMP) can be decoded straight into the
+ *  store from the CAN RX ISR (SIG_ISR_DECODE). Updated slots are
+ *  collected in a dirty mask and the listener task is woken with a
+ *  single thread flag instead of a queued frame per update.
+ */
+
+#ifndef INC_SIGNAL_STORE_H_
+#define INC_SIGNAL_STORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "can_app.h"
+#include "cmsis_os.h"
+
+/* ── Signal IDs ──────────────────────────────── */
+#define SIG_RPM                 0
+#define SIG_TEMP                1
+#define SIG_PER_NODE            2
+
+#define SIG_COUNT               (CAN_MAX_SENSOR_NODES * SIG_PER_NODE)
+#define SIG_ID(node, sig)       ((uint16_t)((node) * SIG_PER_NODE + (sig)))
+
+_Static_assert(SIG_COUNT <= 32, "Dirty mask holds one bit per slot");
+
+/* ── ISR Decode ──────────────────────────────── */
+#ifndef SIG_ISR_DECODE
+#define SIG_ISR_DECODE          1       /* 0: decode in the RX task, as before */
+#endif
+
+/* RPM and TEMP frames (point or window aggregate) carry nothing but
+ * values — no reply, no state */
+#define SIG_PURE_FN_MASK        ((1U << CAN_FN_RPM)     | (1U << CAN_FN_TEMP) | \
+                                 (1U << CAN_FN_RPM_AGG) | (1U << CAN_FN_TEMP_AGG))
+
+static inline bool Sig_IsPureData(uint32_t id)
+{
+    return CAN_ID_IS_DATA(id) && ((SIG_PURE_FN_MASK >> CAN_ID_DATA_FN(id)) & 1U);
+}
+
+/* ── Staleness (3 × the subscribed period) ───── */
+#define SIG_RPM_MAX_AGE_MS      300
+#define SIG_TEMP_MAX_AGE_MS     1500
+
+/* ── Reader Copy ─────────────────────────────── */
+/* A point value has min = max = mean = value */
+typedef struct {
+    int32_t  value;             /* Last */
+    int32_t  min;               /* Over the sender's broadcast window */
+    int32_t  max;
+    int32_t  mean;
+    uint32_t timestampMs;       /* Kernel tick at write */
+    uint32_t rxUs;              /* Frame RX time-stamp (TIM2 local µs) */
+    uint32_t updates;
+} Sig_Sample_t;
+
+typedef enum {
+    SIG_NEVER,                  /* Never written */
+    SIG_FRESH,
+    SIG_STALE,                  /* Older than the signal's max age */
+} Sig_Status_t;
+
+/* ── Latency (µs from the RX interrupt stamp) ── */
+typedef struct {
+    uint32_t stores;
+    uint32_t storeAvgUs;        /* EWMA 1/16 — value visible in the store */
+    uint32_t storeMaxUs;
+    uint32_t rules;
+    uint32_t ruleAvgUs;         /* EWMA 1/16 — rules evaluated */
+    uint32_t ruleMaxUs;
+} Sig_Latency_t;
+
+extern volatile uint32_t Sig_ReadRetries;
+extern Sig_Latency_t     Sig_Latency;
+
+/* ── Function Declarations ───────────────────── */
+/* Writer: one context per slot (task or ISR). Readers: tasks only —
+ * a reader that preempts its slot's writer would spin. */
+void         Sig_Write(uint16_t id, int32_t value, uint32_t rxUs);
+void         Sig_WriteRange(uint16_t id, int32_t last, int32_t min, int32_t max,
+                            int32_t mean, uint32_t rxUs);
+Sig_Status_t Sig_Read(uint16_t id, Sig_Sample_t *out, uint32_t nowMs);
+
+/* Decode a pure data frame into the store — ISR or task context */
+bool         Sig_DecodeFrame(uint32_t id, const uint8_t *data, uint8_t dlc, uint32_t rxUs);
+void         Sig_SetListener(AO_Active_t *ao, uint16_t sig);   /* Posted sig on updates */
+uint32_t     Sig_TakeDirty(void);       /* Slots updated since the last call */
+void         Sig_RuleDone(uint32_t rxUs);
+void         Sig_LogStats(void);
+
+#endif /* INC_SIGNAL_STORE_H_ */
@@ -0,0 +1,91 @@
+/*
+ * can_frame.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "can_frame.h"
+#include "main.h"
+#include "cmsis_os.h"
+#include "freertos_mpool.h"
+#include "uart_log.h"
+
+/* ── Pool Storage (static — no heap) ─────────── */
+static StaticMemPool_t _poolCb;
+static uint32_t        _poolMem[MEMPOOL_ARR_SIZE(CAN_FRAME_POOL_SIZE, sizeof(CAN_Frame_t)) / 4];
+static osMemoryPoolId_t _pool;
+
+CAN_FramePoolStats_t CAN_FramePoolStats;
+
+/* ─────────────────────────────────────────────────
+ * CAN_Frame_PoolInit
+ * ───────────────────────────────────────────────── */
+void CAN_Frame_PoolInit(void)
+{
+    static const osMemoryPoolAttr_t attr = {
+        .name    = "CAN_FRAMES",
+        .cb_mem  = &_poolCb,
+        .cb_size = sizeof(_poolCb),
+        .mp_mem  = _poolMem,
+        .mp_size = sizeof(_poolMem),
+    };
+
+    _pool = osMemoryPoolNew(CAN_FRAME_POOL_SIZE, sizeof(CAN_Frame_t), &attr);
+    if (_pool == NULL)
+    {
+        Error_Handler();
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Alloc / Free
+ * Free-list pop/push inside the pool; the stats update
+ * shares one short PRIMASK section so ISR and task agree
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC CAN_Frame_t *CAN_Frame_Alloc(void)
+{
+    CAN_Frame_t *frame = osMemoryPoolAlloc(_pool, 0);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (frame != NULL)
+    {
+        CAN_FramePoolStats.allocs++;
+        CAN_FramePoolStats.inUse++;
+        if (CAN_FramePoolStats.inUse > CAN_FramePoolStats.highWater)
+        {
+            CAN_FramePoolStats.highWater = CAN_FramePoolStats.inUse;
+        }
+    }
+    else
+    {
+        CAN_FramePoolStats.exhausted++;
+    }
+    __set_PRIMASK(primask);
+
+    return frame;
+}
+
+__RAM_FUNC void CAN_Frame_Free(CAN_Frame_t *frame)
+{
+    if (osMemoryPoolFree(_pool, frame) == osOK)
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        CAN_FramePoolStats.inUse--;
+        __set_PRIMASK(primask);
+    }
+}
+
+void CAN_Frame_LogStats(void)
+{
+    char msg[96];
+
+    snprintf(msg, sizeof(msg), "in use %u, high water %u/%u, exhausted %lu, queue full %lu",
+             CAN_FramePoolStats.inUse, CAN_FramePoolStats.highWater, CAN_FRAME_POOL_SIZE,
+             (unsigned long)CAN_FramePoolStats.exhausted,
+             (unsigned long)CAN_FramePoolStats.queueFull);
+    UART_Log("POOL", msg);
+}
@@ -0,0 +1,119 @@
+/*
+ * co_od.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Object dictionary and PDO copy plans for Node B.
+ *  Everything here is const and linked into flash; only the
+ *  objects the rows point at live in RAM.
+ */
+
+
+#include "co_od.h"
+#include "config.h"
+#include "can_frame.h"
+#include "power.h"
+#include "can_app.h"
+#include "trace.h"
+#include "prof.h"
+#include "flash_kv.h"
+
+/* ── Process Data ────────────────────────────── */
+uint16_t OD_rpm;
+int16_t  OD_temp;
+
+/* ── Rule Parameters ─────────────────────────── */
+uint16_t OD_rpmLimit     = 5000;
+int16_t  OD_tempLimit    = 80;
+uint16_t OD_ackTimeoutMs = 200;
+
+/* ── Communication Objects ───────────────────── */
+static const uint32_t OD_deviceType     = 0x00000000;
+static uint8_t        OD_errorRegister  = 0x00;
+static const char     OD_deviceName[]   = "NodeB-Controller";
+static const char     OD_swVersion[]    = "1.1";
+static const uint32_t OD_rpdo1CobId     = CO_COBID_TPDO1 + CO_NODE_ID_SENSOR;
+static const uint8_t  OD_rpdo1Type      = 0xFE;
+static const uint8_t  OD_rpdo1MapCount  = 2;
+static const uint32_t OD_rpdo1Map[2]    = { 0x20000110, 0x20000210 };
+
+/* ─────────────────────────────────────────────────
+ * Object Dictionary — MUST stay sorted by index/sub
+ * ───────────────────────────────────────────────── */
+static const CO_OD_Entry_t OD_Table[] = {
+    CO_OD(0x1000, 0, CO_ATTR_RO,               OD_deviceType),
+    CO_OD(0x1001, 0, CO_ATTR_RO,               OD_errorRegister),
+    CO_OD(0x1008, 0, CO_ATTR_RO | CO_ATTR_STR, OD_deviceName),
+    CO_OD(0x100A, 0, CO_ATTR_RO | CO_ATTR_STR, OD_swVersion),
+    CO_OD(0x1400, 1, CO_ATTR_RO,               OD_rpdo1CobId),
+    CO_OD(0x1400, 2, CO_ATTR_RO,               OD_rpdo1Type),
+    CO_OD(0x1600, 0, CO_ATTR_RO,               OD_rpdo1MapCount),
+    CO_OD(0x1600, 1, CO_ATTR_RO,               OD_rpdo1Map[0]),
+    CO_OD(0x1600, 2, CO_ATTR_RO,               OD_rpdo1Map[1]),
+    CO_OD(0x2000, 1, CO_ATTR_RO,               OD_rpm),
+    CO_OD(0x2000, 2, CO_ATTR_RO,               OD_temp),
+    CO_OD(0x2100, 1, CO_ATTR_RW,               OD_rpmLimit),
+    CO_OD(0x2100, 2, CO_ATTR_RW,               OD_tempLimit),
+    CO_OD(0x2100, 3, CO_ATTR_RW,               OD_ackTimeoutMs),
+    CO_OD(0x2300, 1, CO_ATTR_RO,               CAN_FramePoolStats.allocs),
+    CO_OD(0x2300, 2, CO_ATTR_RO,               CAN_FramePoolStats.exhausted),
+    CO_OD(0x2300, 3, CO_ATTR_RO,               CAN_FramePoolStats.queueFull),
+    CO_OD(0x2300, 4, CO_ATTR_RO,               CAN_FramePoolStats.inUse),
+    CO_OD(0x2300, 5, CO_ATTR_RO,               CAN_FramePoolStats.highWater),
+    CO_OD(0x2500, 1, CO_ATTR_RO,               Power_Stats.switchesPerSec),
+    CO_OD(0x2500, 2, CO_ATTR_RO,               Power_Stats.idlePermille),
+    CO_OD(0x2500, 3, CO_ATTR_RO,               Power_Stats.sleepPermille),
+    CO_OD(0x2600, 1, CO_ATTR_RW,               CAN_Bitrate.request),
+    CO_OD(0x2600, 2, CO_ATTR_RO,               CAN_Bitrate.active),
+    CO_OD(0x2700, 1, CO_ATTR_RW,               Trace_Ctrl.request),
+    CO_OD(0x2700, 2, CO_ATTR_RW,               Trace_Ctrl.autoDump),
+    CO_OD(0x2700, 3, CO_ATTR_RO,               Trace_Ctrl.frozen),
+    CO_OD(0x2700, 4, CO_ATTR_RO,               Trace_Ctrl.recorded),
+    CO_OD(0x2800, 1, CO_ATTR_RW,               Prof_Ctrl.request),
+    CO_OD(0x2900, 1, CO_ATTR_RO,               CAN_RxLatency.maxUs),
+    CO_OD(0x2900, 2, CO_ATTR_RO,               CAN_TxLatency.maxUs),
+    CO_OD(0x2900, 3, CO_ATTR_RO,               CAN_RxLatency.count),
+    CO_OD(0x2900, 4, CO_ATTR_RO,               CAN_TxLatency.count),
+    CO_OD(0x2A00, 1, CO_ATTR_RO,               FKV_Stats.maxEraseUs),
+    CO_OD(0x2A00, 2, CO_ATTR_RO,               FKV_Stats.maxProgramUs),
+    CO_OD(0x2A00, 3, CO_ATTR_RO,               FKV_Stats.writes),
+    CO_OD(0x2A00, 4, CO_ATTR_RO,               FKV_Stats.compactions),
+};
+
+/* ─────────────────────────────────────────────────
+ * Value ranges for SDO writes — the same limits as the
+ * config requests
+ * ───────────────────────────────────────────────── */
+static const CO_OD_Range_t OD_Ranges[] = {
+    CO_RANGE(0x2100, 1, 0, CFG_RPM_LIMIT_MIN,   CFG_RPM_LIMIT_MAX),
+    CO_RANGE(0x2100, 2, 1, CFG_TEMP_LIMIT_MIN,  CFG_TEMP_LIMIT_MAX),
+    CO_RANGE(0x2100, 3, 0, CFG_ACK_TIMEOUT_MIN, CFG_ACK_TIMEOUT_MAX),
+};
+
+/* ─────────────────────────────────────────────────
+ * RPDO copy plans — must match the 0x1600 mapping above
+ * ───────────────────────────────────────────────── */
+static const CO_PDO_Plan_t OD_Rpdo[] = {
+    {
+        .cobId = CO_COBID_TPDO1 + CO_NODE_ID_SENSOR,
+        .dlc   = 4,
+        .bytes = { CO_MAP_U16(OD_rpm), CO_MAP_U16(OD_temp),
+                   CO_MAP_PAD, CO_MAP_PAD, CO_MAP_PAD, CO_MAP_PAD },
+    },
+};
+
+const CO_Node_t CO_Node = {
+    .nodeId         = CO_NODE_ID,
+    .od             = OD_Table,
+    .odCount        = sizeof(OD_Table) / sizeof(OD_Table[0]),
+    .ranges         = OD_Ranges,
+    .rangeCount     = sizeof(OD_Ranges) / sizeof(OD_Ranges[0]),
+    .tpdo           = NULL,
+    .tpdoEventTimer = NULL,
+    .tpdoCount      = 0,
+    .rpdo           = OD_Rpdo,
+    .rpdoCount      = sizeof(OD_Rpdo) / sizeof(OD_Rpdo[0]),
+    .written        = Cfg_OdWritten,
+    .check          = NULL,
+};
@@ -0,0 +1,234 @@
+/*
+ * config.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "config.h"
+#include "co_od.h"
+#include "can_app.h"
+#include "flash_kv.h"
+#include "uart_log.h"
+#include "main.h"
+
+/* ── Parameter Table ─────────────────────────── */
+typedef struct {
+    uint8_t  key;
+    void    *data;
+    uint8_t  isSigned;      /* All parameters are 16-bit */
+    int32_t  min;
+    int32_t  max;
+} Cfg_Param_t;
+
+static const Cfg_Param_t Params[] = {
+    { CFG_KEY_RPM_LIMIT,   &OD_rpmLimit,     0, CFG_RPM_LIMIT_MIN,   CFG_RPM_LIMIT_MAX },
+    { CFG_KEY_TEMP_LIMIT,  &OD_tempLimit,    1, CFG_TEMP_LIMIT_MIN,  CFG_TEMP_LIMIT_MAX },
+    { CFG_KEY_ACK_TIMEOUT, &OD_ackTimeoutMs, 0, CFG_ACK_TIMEOUT_MIN, CFG_ACK_TIMEOUT_MAX },
+};
+
+#define CFG_PARAM_COUNT         (sizeof(Params) / sizeof(Params[0]))
+
+/* ── Persist Events (RX active object → Cfg_PersistAO) ── */
+enum {
+    CFG_SIG_WRITE = AO_SIG_USER,
+};
+
+typedef struct {
+    AO_Event_t super;
+    uint16_t   key;
+    int32_t    value;
+} Cfg_Write_t;
+
+_Static_assert(sizeof(Cfg_Write_t) <= AO_EVENT_SIZE, "Cfg_Write_t must fit an event pool block");
+
+static void Cfg_Persisting(AO_Active_t *me, const AO_Event_t *e);
+
+AO_Active_t Cfg_PersistAO = AO_ACTIVE(Cfg_Persisting, "CONFIG");
+
+/* ─────────────────────────────────────────────────
+ * Helpers
+ * ───────────────────────────────────────────────── */
+static const Cfg_Param_t *Cfg_Find(uint8_t key)
+{
+    for (uint8_t i = 0; i < CFG_PARAM_COUNT; i++)
+    {
+        if (Params[i].key == key) return &Params[i];
+    }
+    return NULL;
+}
+
+static int32_t Cfg_Read(const Cfg_Param_t *p)
+{
+    return p->isSigned ? *(int16_t *)p->data : *(uint16_t *)p->data;
+}
+
+static bool Cfg_Apply(const Cfg_Param_t *p, int32_t value)
+{
+    if (value < p->min || value > p->max) return false;
+
+    /* 16-bit store is atomic — readers see old or new, never half */
+    if (p->isSigned) *(int16_t *)p->data  = (int16_t)value;
+    else             *(uint16_t *)p->data = (uint16_t)value;
+    return true;
+}
+
+/* Queues the flash write — the one persist path for config
+ * requests and SDO writes alike */
+static bool Cfg_Persist(const Cfg_Param_t *p, int32_t value)
+{
+    Cfg_Write_t *w = AO_NewEvent(CFG_SIG_WRITE, sizeof(*w));
+
+    if (w == NULL) return false;
+
+    w->key   = p->key;
+    w->value = value;
+    return AO_Post(&Cfg_PersistAO, &w->super);
+}
+
+static void Cfg_Respond(uint8_t op, uint8_t key, uint8_t status, int32_t value)
+{
+    uint8_t data[7];
+
+    data[0] = op;
+    data[1] = key;
+    data[2] = status;
+    data[3] = ((uint32_t)value >> 24) & 0xFF;
+    data[4] = ((uint32_t)value >> 16) & 0xFF;
+    data[5] = ((uint32_t)value >> 8) & 0xFF;
+    data[6] = (uint32_t)value & 0xFF;
+    CAN_App_Transmit(CAN_ID_CONFIG_RSP, data, 7);
+}
+
+/* ─────────────────────────────────────────────────
+ * Cfg_Init
+ * Call before the scheduler starts — replays flash once
+ * and overrides the compiled-in defaults
+ * ───────────────────────────────────────────────── */
+void Cfg_Init(void)
+{
+    FKV_Init();
+
+    for (uint8_t i = 0; i < CFG_PARAM_COUNT; i++)
+    {
+        uint32_t stored;
+
+        if (FKV_Get(Params[i].key, &stored) && Cfg_Apply(&Params[i], (int32_t)stored))
+        {
+            UART_Log_Int("CONFIG", "Loaded key", Params[i].key);
+        }
+    }
+
+    UART_Log_Int("CONFIG", "Flash KV records", FKV_Stats.records);
+}
+
+/* ─────────────────────────────────────────────────
+ * Cfg_HandleRequest
+ * Runs in the RX active object: applies in RAM, ACKs, and only
+ * queues the flash write — never waits on flash
+ * ───────────────────────────────────────────────── */
+void Cfg_HandleRequest(const uint8_t *data, uint8_t dlc)
+{
+    if (dlc < 2) return;
+
+    uint8_t op  = data[0];
+    uint8_t key = data[1];
+    const Cfg_Param_t *p = Cfg_Find(key);
+
+    if (p == NULL)
+    {
+        Cfg_Respond(op, key, CFG_STATUS_NO_KEY, 0);
+        return;
+    }
+
+    switch (op)
+    {
+        case CFG_OP_READ:
+            Cfg_Respond(op, key, CFG_STATUS_OK, Cfg_Read(p));
+            break;
+
+        case CFG_OP_WRITE:
+        {
+            if (dlc < 6)
+            {
+                Cfg_Respond(op, key, CFG_STATUS_BAD_OP, Cfg_Read(p));
+                break;
+            }
+
+            int32_t value = (int32_t)(((uint32_t)data[2] << 24) | ((uint32_t)data[3] << 16) |
+                                      ((uint32_t)data[4] << 8)  |  (uint32_t)data[5]);
+
+            if (!Cfg_Apply(p, value))
+            {
+                Cfg_Respond(op, key, CFG_STATUS_RANGE, Cfg_Read(p));
+                break;
+            }
+
+            uint8_t status = Cfg_Persist(p, value) ? CFG_STATUS_OK : CFG_STATUS_NOT_SAVED;
+
+            Cfg_Respond(op, key, status, value);
+            UART_Log_Int("CONFIG", "Set key", key);
+            break;
+        }
+
+        default:
+            Cfg_Respond(op, key, CFG_STATUS_BAD_OP, 0);
+            break;
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Cfg_OdWritten — CO_Node.written, after an SDO download.
+ * The value is in RAM and range-checked already
+ * ───────────────────────────────────────────────── */
+void Cfg_OdWritten(const CO_OD_Entry_t *entry)
+{
+    for (uint8_t i = 0; i < CFG_PARAM_COUNT; i++)
+    {
+        if (Params[i].data != entry->data) continue;
+
+        if (!Cfg_Persist(&Params[i], Cfg_Read(&Params[i])))
+        {
+            UART_Log_Int("CONFIG", "Not saved, key", Params[i].key);
+        }
+        return;
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Cfg_Persisting — Cfg_PersistAO's only state
+ * ───────────────────────────────────────────────── */
+static void Cfg_Persisting(AO_Active_t *me, const AO_Event_t *e)
+{
+    if (e->sig == AO_SIG_ENTRY)
+    {
+        UART_Log("CONFIG", "Started");
+        return;
+    }
+    if (e->sig != CFG_SIG_WRITE) return;
+
+    const Cfg_Write_t *w = (const Cfg_Write_t *)e;
+    static uint32_t loggedEraseUs, loggedProgramUs;
+
+    if (FKV_Set(w->key, (uint32_t)w->value))
+    {
+        UART_Log_Int("CONFIG", "Saved key", w->key);
+    }
+    else
+    {
+        UART_Log_Int("CONFIG", "Flash write FAILED, key", w->key);
+    }
+
+    /* Every ISR and thread stood still this long */
+    if (FKV_Stats.maxEraseUs != loggedEraseUs)
+    {
+        loggedEraseUs = FKV_Stats.maxEraseUs;
+        UART_Log_Int("CONFIG", "Max erase stall us", (int)loggedEraseUs);
+    }
+    if (FKV_Stats.maxProgramUs != loggedProgramUs)
+    {
+        loggedProgramUs = FKV_Stats.maxProgramUs;
+        UART_Log_Int("CONFIG", "Max program stall us", (int)loggedProgramUs);
+    }
+}
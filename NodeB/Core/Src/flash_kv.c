@@ -0,0 +1,190 @@
+/*
+ * flash_kv.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "flash_kv.h"
+#include <string.h>
+
+/* ── On-flash Layout ─────────────────────────── */
+/* Sector:  [magic][generation] [record] [record] ... [0xFF...]
+ * Record:  [value][key | ~key << 16]
+ * The value word goes first and the key word last, so a record
+ * torn by a reset has an erased or mismatched key word and is skipped. */
+#define FKV_MAGIC               0x4B563031U     /* "KV01" */
+#define FKV_ERASED              0xFFFFFFFFU
+#define FKV_HEADER_WORDS        2
+#define FKV_RECORD_WORDS        2
+
+#define FKV_KEYWORD(key)        ((uint32_t)(key) | ((uint32_t)(uint16_t)~(key) << 16))
+
+/* ── Private Variables ───────────────────────── */
+static uint32_t _value[FKV_MAX_KEYS];
+static bool     _valid[FKV_MAX_KEYS];
+static uint8_t  _active;
+static uint32_t *_next;             /* Next free record slot */
+
+FKV_Stats_t FKV_Stats;
+
+static uint32_t *FKV_Base(uint8_t s)  { return (uint32_t *)FKV_Flash.sector[s]; }
+static uint32_t *FKV_End(uint8_t s)   { return FKV_Base(s) + FKV_Flash.sectorSize / 4; }
+
+static bool FKV_KeyOk(uint16_t key)
+{
+    return key != 0 && key < FKV_MAX_KEYS;
+}
+
+/* ─────────────────────────────────────────────────
+ * Sector helpers
+ * ───────────────────────────────────────────────── */
+static bool FKV_SectorValid(uint8_t s, uint32_t *generation)
+{
+    uint32_t *base = FKV_Base(s);
+
+    if (base[0] != FKV_MAGIC || base[1] == FKV_ERASED) return false;
+    *generation = base[1];
+    return true;
+}
+
+/* Erase, stamp and fill sector s with every cached value */
+static bool FKV_Format(uint8_t s, uint32_t generation)
+{
+    uint32_t *p = FKV_Base(s) + FKV_HEADER_WORDS;
+
+    if (!FKV_Flash.erase(s)) return false;
+
+    for (uint16_t key = 1; key < FKV_MAX_KEYS; key++)
+    {
+        if (!_valid[key]) continue;
+        if (!FKV_Flash.program(p, _value[key]))       return false;
+        if (!FKV_Flash.program(p + 1, FKV_KEYWORD(key))) return false;
+        p += FKV_RECORD_WORDS;
+    }
+
+    /* Header last — the sector only becomes active once it is complete */
+    if (!FKV_Flash.program(FKV_Base(s), FKV_MAGIC))   return false;
+    if (!FKV_Flash.program(FKV_Base(s) + 1, generation)) return false;
+
+    _active = s;
+    _next   = p;
+    FKV_Stats.generation = generation;
+    return true;
+}
+
+static void FKV_UpdateStats(void)
+{
+    FKV_Stats.capacity = (FKV_Flash.sectorSize / 4 - FKV_HEADER_WORDS) / FKV_RECORD_WORDS;
+    FKV_Stats.records  = (uint32_t)(_next - (FKV_Base(_active) + FKV_HEADER_WORDS)) / FKV_RECORD_WORDS;
+}
+
+/* ─────────────────────────────────────────────────
+ * FKV_Init
+ * Pick the newest valid sector and replay it once
+ * ───────────────────────────────────────────────── */
+void FKV_Init(void)
+{
+    uint32_t gen0 = 0, gen1 = 0;
+    bool     ok0  = FKV_SectorValid(0, &gen0);
+    bool     ok1  = FKV_SectorValid(1, &gen1);
+
+    memset(_valid, 0, sizeof(_valid));
+
+    if (!ok0 && !ok1)
+    {
+        /* Blank or corrupt — start fresh */
+        if (!FKV_Format(0, 1)) FKV_Stats.errors++;
+        FKV_UpdateStats();
+        return;
+    }
+
+    _active = (ok1 && (!ok0 || (int32_t)(gen1 - gen0) > 0)) ? 1 : 0;
+    FKV_Stats.generation = _active ? gen1 : gen0;
+
+    uint32_t *p   = FKV_Base(_active) + FKV_HEADER_WORDS;
+    uint32_t *end = FKV_End(_active);
+
+    while (p + FKV_RECORD_WORDS <= end)
+    {
+        uint32_t value   = p[0];
+        uint32_t keyword = p[1];
+
+        if (keyword == FKV_ERASED)
+        {
+            if (value != FKV_ERASED)
+            {
+                /* Torn append — slot is burnt, keep going after it */
+                FKV_Stats.errors++;
+                p += FKV_RECORD_WORDS;
+                continue;
+            }
+            break;
+        }
+
+        uint16_t key = keyword & 0xFFFF;
+        if (keyword == FKV_KEYWORD(key) && FKV_KeyOk(key))
+        {
+            _value[key] = value;    /* Later records win */
+            _valid[key] = true;
+        }
+        else
+        {
+            FKV_Stats.errors++;
+        }
+        p += FKV_RECORD_WORDS;
+    }
+
+    _next = p;
+    FKV_UpdateStats();
+}
+
+/* ─────────────────────────────────────────────────
+ * Get / Set
+ * ───────────────────────────────────────────────── */
+bool FKV_Get(uint16_t key, uint32_t *value)
+{
+    if (!FKV_KeyOk(key) || !_valid[key]) return false;
+    *value = _value[key];
+    return true;
+}
+
+bool FKV_Set(uint16_t key, uint32_t value)
+{
+    if (!FKV_KeyOk(key)) return false;
+
+    /* Unchanged — don't spend flash on it */
+    if (_valid[key] && _value[key] == value) return true;
+
+    _value[key] = value;
+    _valid[key] = true;
+
+    if (_next + FKV_RECORD_WORDS > FKV_End(_active))
+    {
+        /* Active sector full — compact into the other one */
+        FKV_Stats.compactions++;
+        if (!FKV_Format(_active ^ 1, FKV_Stats.generation + 1))
+        {
+            FKV_Stats.errors++;
+            return false;
+        }
+        FKV_Stats.writes++;
+        FKV_UpdateStats();
+        return true;    /* New value went in with the compaction */
+    }
+
+    if (!FKV_Flash.program(_next, value) ||
+        !FKV_Flash.program(_next + 1, FKV_KEYWORD(key)))
+    {
+        _next += FKV_RECORD_WORDS;      /* Never reuse a half-written slot */
+        FKV_Stats.errors++;
+        FKV_UpdateStats();
+        return false;
+    }
+
+    _next += FKV_RECORD_WORDS;
+    FKV_Stats.writes++;
+    FKV_UpdateStats();
+    return true;
+}
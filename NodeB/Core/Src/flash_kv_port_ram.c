@@ -0,0 +1,63 @@
+/*
+ * flash_kv_port_ram.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Host stand-in for the FKV flash port. Two small RAM "sectors" with
+ *  NOR rules enforced: erase sets every bit, program may only clear
+ *  bits (a 0 → 1 attempt fails like it would on silicon). Build
+ *  flash_kv.c with this file and -DFKV_HOST_STANDIN to exercise the
+ *  store, power-fail cases and compaction on a PC.
+ */
+
+#ifdef FKV_HOST_STANDIN
+
+#include "flash_kv.h"
+#include <string.h>
+
+#ifndef FKV_RAM_SECTOR_SIZE
+#define FKV_RAM_SECTOR_SIZE     256     /* Small, so compaction is easy to hit */
+#endif
+
+static uint32_t FKV_RamSector[2][FKV_RAM_SECTOR_SIZE / 4];
+
+/* Counters a host harness can inspect or use to inject power loss */
+uint32_t FKV_RamEraseCount[2];
+int32_t  FKV_RamFailAfter = -1;     /* Fail the Nth program from now, -1 = never */
+
+static bool FKV_RamErase(uint8_t index)
+{
+    memset(FKV_RamSector[index], 0xFF, sizeof(FKV_RamSector[index]));
+    FKV_RamEraseCount[index]++;
+    return true;
+}
+
+static bool FKV_RamProgram(uint32_t *dst, uint32_t word)
+{
+    if (FKV_RamFailAfter == 0)
+    {
+        return false;
+    }
+    if (FKV_RamFailAfter > 0)
+    {
+        FKV_RamFailAfter--;
+    }
+
+    /* NOR can only clear bits */
+    if ((*dst & word) != word)
+    {
+        return false;
+    }
+    *dst &= word;
+    return true;
+}
+
+const FKV_Flash_t FKV_Flash = {
+    .sector     = { (uint8_t *)FKV_RamSector[0], (uint8_t *)FKV_RamSector[1] },
+    .sectorSize = FKV_RAM_SECTOR_SIZE,
+    .erase      = FKV_RamErase,
+    .program    = FKV_RamProgram,
+};
+
+#endif /* FKV_HOST_STANDIN */
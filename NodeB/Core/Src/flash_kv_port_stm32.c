@@ -0,0 +1,80 @@
+/*
+ * flash_kv_port_stm32.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  FKV flash port for the STM32F446RE: sectors 1 and 2 (2 × 16 KB at
+ *  0x08004000). The F446 has one flash bank, so the CPU stalls on any
+ *  flash fetch while a sector erases or a word programs — every ISR
+ *  and thread with it. The small sectors keep an erase to 250 ms
+ *  typical, 500 ms max (datasheet, x32), against 1–2 s for the 128 KB
+ *  ones. Each erase and program is timed into FKV_Stats. The linker
+ *  script keeps sector 0 for the vectors and starts FLASH at sector 3.
+ */
+
+#ifndef FKV_HOST_STANDIN
+
+#include "flash_kv.h"
+#include "stm32f4xx_hal.h"
+
+#define FKV_SECTOR_A            FLASH_SECTOR_1
+#define FKV_SECTOR_A_ADDR       0x08004000U
+#define FKV_SECTOR_B_ADDR       0x08008000U
+#define FKV_SECTOR_SIZE         (16U * 1024U)
+
+/* Wall time of one flash operation — nothing else runs meanwhile */
+static uint32_t FKV_Stm32Us(uint32_t startCycles)
+{
+    return (DWT->CYCCNT - startCycles) / (SystemCoreClock / 1000000U);
+}
+
+static bool FKV_Stm32Erase(uint8_t index)
+{
+    FLASH_EraseInitTypeDef erase;
+    uint32_t badSector;
+
+    erase.TypeErase    = FLASH_TYPEERASE_SECTORS;
+    erase.Sector       = FKV_SECTOR_A + index;
+    erase.NbSectors    = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;     /* 2.7–3.6 V, x32 */
+
+    uint32_t start = DWT->CYCCNT;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &badSector);
+    HAL_FLASH_Lock();
+
+    uint32_t us = FKV_Stm32Us(start);
+    if (us > FKV_Stats.maxEraseUs) FKV_Stats.maxEraseUs = us;
+
+    return status == HAL_OK;
+}
+
+static bool FKV_Stm32Program(uint32_t *dst, uint32_t word)
+{
+    uint32_t start = DWT->CYCCNT;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, (uint32_t)dst, word);
+    HAL_FLASH_Lock();
+
+    uint32_t us = FKV_Stm32Us(start);
+    if (us > FKV_Stats.maxProgramUs) FKV_Stats.maxProgramUs = us;
+
+    /* Drop any stale cached copy before reading back */
+    __HAL_FLASH_DATA_CACHE_DISABLE();
+    __HAL_FLASH_DATA_CACHE_RESET();
+    __HAL_FLASH_DATA_CACHE_ENABLE();
+
+    return status == HAL_OK && *dst == word;
+}
+
+const FKV_Flash_t FKV_Flash = {
+    .sector     = { (uint8_t *)FKV_SECTOR_A_ADDR, (uint8_t *)FKV_SECTOR_B_ADDR },
+    .sectorSize = FKV_SECTOR_SIZE,
+    .erase      = FKV_Stm32Erase,
+    .program    = FKV_Stm32Program,
+};
+
+#endif /* FKV_HOST_STANDIN */
@@ -0,0 +1,246 @@
+/*
+ * liveness.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "liveness.h"
+#include "uart_log.h"
+#include "main.h"
+
+#define LIVE_NIL                0xFF
+#define LIVE_SLOT_MASK          (LIVE_WHEEL_SLOTS - 1)
+#define LIVE_TIMEOUT_TICKS      ((LIVE_TIMEOUT_MS + LIVE_TICK_MS - 1) / LIVE_TICK_MS)
+
+_Static_assert((LIVE_WHEEL_SLOTS & LIVE_SLOT_MASK) == 0, "LIVE_WHEEL_SLOTS must be a power of two");
+_Static_assert(LIVE_MAX_NODES < LIVE_NIL, "Timer links are 8-bit node indexes");
+
+/* ── Timer Wheel ─────────────────────────────── */
+/* Each node owns exactly one timer, linked into the slot its deadline
+ * hashes to. Deadlines further out than one revolution wait out
+ * 'rounds' extra visits. */
+typedef struct {
+    uint8_t  next;
+    uint8_t  prev;
+    uint8_t  slot;
+    uint8_t  armed;
+    uint8_t  lost;
+    uint8_t  seen;
+    uint16_t rounds;
+    uint32_t lastUs;
+} Live_Timer_t;
+
+static Live_Timer_t Timers[LIVE_MAX_NODES];
+static uint8_t      Wheel[LIVE_WHEEL_SLOTS];
+static uint32_t     WheelTick;
+static uint32_t     WheelMs;
+static uint8_t      ArmedCount;
+
+Live_Stats_t Live_Stats[LIVE_MAX_NODES];
+
+/* Jitter bucket upper edges, µs */
+static const uint32_t JitterEdgeUs[LIVE_JITTER_BUCKETS - 1] = {
+    50, 100, 250, 500, 1000, 2500, 5000
+};
+
+/* ─────────────────────────────────────────────────
+ * Wheel list helpers — O(1)
+ * ───────────────────────────────────────────────── */
+static void Live_Unlink(uint8_t node)
+{
+    Live_Timer_t *t = &Timers[node];
+
+    if (t->prev != LIVE_NIL) Timers[t->prev].next = t->next;
+    else                     Wheel[t->slot]       = t->next;
+    if (t->next != LIVE_NIL) Timers[t->next].prev = t->prev;
+
+    t->armed = 0;
+    ArmedCount--;
+}
+
+static void Live_Arm(uint8_t node, uint32_t ticks)
+{
+    Live_Timer_t *t = &Timers[node];
+
+    if (t->armed) Live_Unlink(node);
+
+    t->slot   = (WheelTick + ticks) & LIVE_SLOT_MASK;
+    t->rounds = (ticks - 1) / LIVE_WHEEL_SLOTS;
+    t->prev   = LIVE_NIL;
+    t->next   = Wheel[t->slot];
+    if (t->next != LIVE_NIL) Timers[t->next].prev = node;
+    Wheel[t->slot] = node;
+    t->armed  = 1;
+    ArmedCount++;
+}
+
+/* ─────────────────────────────────────────────────
+ * Live_Init
+ * ───────────────────────────────────────────────── */
+void Live_Init(uint32_t nowMs)
+{
+    for (int i = 0; i < LIVE_WHEEL_SLOTS; i++) Wheel[i] = LIVE_NIL;
+
+    memset(Timers, 0, sizeof(Timers));
+    memset(Live_Stats, 0, sizeof(Live_Stats));
+    WheelTick  = 0;
+    WheelMs    = nowMs;
+    ArmedCount = 0;
+}
+
+/* ─────────────────────────────────────────────────
+ * Live_OnHeartbeat
+ * rxUs is the RX interrupt time-stamp, so queueing and
+ * task scheduling do not show up as jitter
+ * ───────────────────────────────────────────────── */
+void Live_OnHeartbeat(uint8_t node, uint32_t rxUs, uint32_t nowMs)
+{
+    if (node >= LIVE_MAX_NODES) return;
+
+    Live_Timer_t *t  = &Timers[node];
+    Live_Stats_t *st = &Live_Stats[node];
+
+    /* Catch the wheel up first, with this node's timer off it: a beat
+     * on the tick its deadline falls due still counts as alive */
+    if (t->armed) Live_Unlink(node);
+    Live_Advance(nowMs);
+
+    st->beats++;
+
+    if (t->seen && !t->lost)
+    {
+        uint32_t interval = rxUs - t->lastUs;
+
+        if (st->meanUs == 0)
+        {
+            st->meanUs = interval;
+            st->minUs  = interval;
+            st->maxUs  = interval;
+        }
+        else
+        {
+            /* Mean follows slow period changes (e.g. tx period over SDO) */
+            int32_t  diff   = (int32_t)(interval - st->meanUs);
+            uint32_t jitter = (diff < 0) ? (uint32_t)(-diff) : (uint32_t)diff;
+            uint8_t  b      = 0;
+
+            while (b < LIVE_JITTER_BUCKETS - 1 && jitter > JitterEdgeUs[b]) b++;
+            st->jitterHist[b]++;
+
+            st->meanUs = (uint32_t)((int32_t)st->meanUs + diff / 8);
+            if (interval < st->minUs) st->minUs = interval;
+            if (interval > st->maxUs) st->maxUs = interval;
+        }
+    }
+
+    if (t->lost)
+    {
+        t->lost = 0;
+        UART_Log_Int("LIVE", "Node recovered", node);
+        Live_EventCallback(node, LIVE_NODE_RECOVERED);
+    }
+
+    t->seen   = 1;
+    t->lastUs = rxUs;
+
+    Live_Arm(node, LIVE_TIMEOUT_TICKS);
+}
+
+/* ─────────────────────────────────────────────────
+ * Live_Advance
+ * Turns the wheel up to nowMs; each tick visits one slot
+ * ───────────────────────────────────────────────── */
+void Live_Advance(uint32_t nowMs)
+{
+    if (ArmedCount == 0)
+    {
+        /* Empty wheel — skip the idle stretch in one step */
+        uint32_t ticks = (nowMs - WheelMs) / LIVE_TICK_MS;
+
+        WheelTick += ticks;
+        WheelMs   += ticks * LIVE_TICK_MS;
+        return;
+    }
+
+    while (nowMs - WheelMs >= LIVE_TICK_MS)
+    {
+        WheelMs += LIVE_TICK_MS;
+        WheelTick++;
+
+        uint8_t node = Wheel[WheelTick & LIVE_SLOT_MASK];
+
+        while (node != LIVE_NIL)
+        {
+            Live_Timer_t *t = &Timers[node];
+            uint8_t next = t->next;
+
+            if (t->rounds > 0)
+            {
+                t->rounds--;
+            }
+            else
+            {
+                Live_Unlink(node);
+                t->lost = 1;
+                Live_Stats[node].lostCount++;
+                UART_Log_Int("LIVE", "Node lost", node);
+                Live_EventCallback(node, LIVE_NODE_LOST);
+            }
+            node = next;
+        }
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Live_NextMs
+ * Time until the next occupied slot falls due, 0 when
+ * no timer is armed — the wheel then need not turn
+ * ───────────────────────────────────────────────── */
+uint32_t Live_NextMs(uint32_t nowMs)
+{
+    if (ArmedCount == 0) return 0;
+
+    for (uint32_t k = 1; k <= LIVE_WHEEL_SLOTS; k++)
+    {
+        if (Wheel[(WheelTick + k) & LIVE_SLOT_MASK] != LIVE_NIL)
+        {
+            uint32_t dueMs = WheelMs + k * LIVE_TICK_MS;
+            return ((int32_t)(dueMs - nowMs) > 0) ? dueMs - nowMs : 1;
+        }
+    }
+    return 0;
+}
+
+/* ─────────────────────────────────────────────────
+ * Live_LogStats — two lines per node that ever beat
+ * ───────────────────────────────────────────────── */
+void Live_LogStats(void)
+{
+    char msg[128];
+
+    for (uint8_t node = 0; node < LIVE_MAX_NODES; node++)
+    {
+        Live_Stats_t *st = &Live_Stats[node];
+        const uint32_t *h = st->jitterHist;
+
+        if (!Timers[node].seen) continue;
+
+        snprintf(msg, sizeof(msg), "Node %u %s: hb %lu, mean %luus [%lu..%lu], lost %lu",
+                 node, Timers[node].lost ? "LOST" : "alive",
+                 (unsigned long)st->beats, (unsigned long)st->meanUs,
+                 (unsigned long)st->minUs, (unsigned long)st->maxUs,
+                 (unsigned long)st->lostCount);
+        UART_Log("LIVE", msg);
+
+        snprintf(msg, sizeof(msg), "Node %u jitter %lu/%lu/%lu/%lu/%lu/%lu/%lu/%lu", node,
+                 (unsigned long)h[0], (unsigned long)h[1], (unsigned long)h[2], (unsigned long)h[3],
+                 (unsigned long)h[4], (unsigned long)h[5], (unsigned long)h[6], (unsigned long)h[7]);
+        UART_Log("LIVE", msg);
+    }
+}
+
+__weak void Live_EventCallback(uint8_t node, Live_Event_t event)
+{
+}
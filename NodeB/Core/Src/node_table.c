@@ -0,0 +1,158 @@
+/*
+ * node_table.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "node_table.h"
+#include "signal_store.h"
+#include "uart_log.h"
+#include "trace.h"
+
+/* ── State Table ─────────────────────────────── */
+/* Shared by the CAN RX and rules tasks — updates run under a
+ * scheduler lock, logging and transmit happen outside it */
+Node_State_t NodeTable[CAN_MAX_SENSOR_NODES];
+
+/* ─────────────────────────────────────────────────
+ * NodeTable_Touch
+ * Called for every frame from a node
+ * ───────────────────────────────────────────────── */
+bool NodeTable_Touch(uint8_t node, uint32_t nowMs)
+{
+    Node_State_t *st = NodeTable_Get(node);
+    bool first;
+
+    int32_t lock = osKernelLock();
+    st->lastSeenMs = nowMs;
+    st->rxFrames++;
+    first = !st->online;
+    st->online = 1;
+    osKernelRestoreLock(lock);
+
+    if (first)
+    {
+        UART_Log_Int("NODES", "Sensor node online", node);
+    }
+    return first;
+}
+
+/* ─────────────────────────────────────────────────
+ * Commands and ACKs
+ * A node gets a new command only once it has ACKed
+ * (or timed out on) the previous one
+ * ───────────────────────────────────────────────── */
+bool NodeTable_SendCommand(uint8_t node, uint8_t cmd, uint32_t nowMs)
+{
+    Node_State_t *st = NodeTable_Get(node);
+
+    int32_t lock = osKernelLock();
+    if (st->awaitingAck)
+    {
+        osKernelRestoreLock(lock);
+        return false;
+    }
+    st->pendingCmd  = cmd;
+    st->cmdSentMs   = nowMs;
+    st->awaitingAck = 1;
+    st->cmdsSent++;
+    osKernelRestoreLock(lock);
+
+    TRACE_MARK(TRACE_MARK_CMD, node);
+    CAN_App_TransmitCommand(node, cmd);
+    return true;
+}
+
+void NodeTable_Ack(uint8_t node, uint8_t cmd)
+{
+    Node_State_t *st = NodeTable_Get(node);
+    char msg[48];
+
+    TRACE_MARK(TRACE_MARK_ACK, node);
+
+    int32_t lock = osKernelLock();
+    if (st->awaitingAck && st->pendingCmd == cmd)
+    {
+        st->awaitingAck = 0;
+        st->acks++;
+    }
+    osKernelRestoreLock(lock);
+
+    snprintf(msg, sizeof(msg), "Node %u ACKed command %u", node, cmd);
+    UART_Log("CAN_RX", msg);
+}
+
+/* Returns ms until the next pending ACK times out, 0 if none is pending */
+uint32_t NodeTable_CheckAckTimeouts(uint32_t nowMs, uint32_t timeoutMs)
+{
+    uint32_t nextMs = 0;
+
+    for (uint8_t node = 0; node < CAN_MAX_SENSOR_NODES; node++)
+    {
+        Node_State_t *st = &NodeTable[node];
+        bool expired;
+
+        int32_t lock = osKernelLock();
+        uint32_t waited = nowMs - st->cmdSentMs;
+        expired = st->awaitingAck && waited >= timeoutMs;
+        if (expired)
+        {
+            st->awaitingAck = 0;
+            st->ackTimeouts++;
+        }
+        else if (st->awaitingAck && (nextMs == 0 || timeoutMs - waited < nextMs))
+        {
+            nextMs = timeoutMs - waited;
+        }
+        osKernelRestoreLock(lock);
+
+        if (expired)
+        {
+            /* Keep what the scheduler did around the missed ACK */
+            TRACE_TRIGGER(TRACE_MARK_ACK_TIMEOUT, node);
+            UART_Log_Int("ERROR", "No ACK from sensor node", node);
+        }
+    }
+
+    return nextMs;
+}
+
+/* ─────────────────────────────────────────────────
+ * NodeTable_LogStats — one line per node seen
+ * Values come from the signal store, so a signal that
+ * stopped arriving shows as stale rather than frozen
+ * ───────────────────────────────────────────────── */
+static const char *StatusMark(Sig_Status_t status)
+{
+    return (status == SIG_FRESH) ? "" : (status == SIG_STALE) ? " (stale)" : " (none)";
+}
+
+void NodeTable_LogStats(void)
+{
+    char msg[112];
+    uint32_t now = osKernelGetTickCount();
+
+    for (uint8_t node = 0; node < CAN_MAX_SENSOR_NODES; node++)
+    {
+        Node_State_t *st = &NodeTable[node];
+        Sig_Sample_t rpm, temp;
+
+        if (!st->online) continue;
+
+        Sig_Status_t rpmStatus  = Sig_Read(SIG_ID(node, SIG_RPM),  &rpm,  now);
+        Sig_Status_t tempStatus = Sig_Read(SIG_ID(node, SIG_TEMP), &temp, now);
+
+        snprintf(msg, sizeof(msg), "Node %u: RPM %ld%s TEMP %ld%s",
+                 node, (long)rpm.value, StatusMark(rpmStatus),
+                 (long)temp.value, StatusMark(tempStatus));
+        UART_Log("NODES", msg);
+
+        snprintf(msg, sizeof(msg), "Node %u: rx %lu, cmd %lu, ack %lu, timeout %lu",
+                 node, (unsigned long)st->rxFrames,
+                 (unsigned long)st->cmdsSent, (unsigned long)st->acks,
+                 (unsigned long)st->ackTimeouts);
+        UART_Log("NODES", msg);
+    }
+}
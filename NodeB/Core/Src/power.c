@@ -0,0 +1,139 @@
+/*
+ * power.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "power.h"
+#include "main.h"
+#include "timesync.h"
+#include "uart_log.h"
+#include <stdio.h>
+
+extern TIM_HandleTypeDef htim1;     /* HAL timebase, stm32f4xx_hal_timebase_tim.c */
+
+/* ── State ───────────────────────────────────── */
+static const void *_lastTcb;
+static uint32_t    _inIdle;
+static uint32_t    _switchUs;       /* Local time of the last switch-in */
+static uint32_t    _sleepStartUs;
+static uint32_t    _halTickCarryUs; /* Sleep not yet credited to uwTick */
+
+static Power_Counters_t _prev;      /* Counters at the last Power_LogStats */
+static uint32_t         _prevUs;
+
+Power_Counters_t Power_Counters;
+Power_Stats_t    Power_Stats;
+
+/* ─────────────────────────────────────────────────
+ * Power_TaskSwitchedIn — traceTASK_SWITCHED_IN, runs in
+ * PendSV with the new task already selected
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC void Power_TaskSwitchedIn(const void *tcb, uint32_t isIdle)
+{
+    uint32_t now = TSync_LocalUs();
+
+    /* The scheduler re-selected the running task — not a switch */
+    if (tcb == _lastTcb) return;
+
+    if (_inIdle)
+    {
+        Power_Counters.idleUs += now - _switchUs;
+    }
+
+    _lastTcb  = tcb;
+    _inIdle   = isIdle;
+    _switchUs = now;
+    Power_Counters.switches++;
+}
+
+/* ─────────────────────────────────────────────────
+ * Power_PreSleep — configPRE_SLEEP_PROCESSING
+ * Called from the idle task with interrupts masked and
+ * SysTick reprogrammed for the expected idle time
+ * ───────────────────────────────────────────────── */
+void Power_PreSleep(uint32_t *expectedIdleTicks)
+{
+    (void)expectedIdleTicks;     /* Leave non-zero — the port executes the WFI */
+
+    /* Sleep, not STOP: CAN1, TIM2 and TIM3 stay clocked, so a
+     * received frame or a sample tick wakes the core directly */
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    /* TIM1 (HAL timebase) would otherwise wake the core every ms */
+    HAL_SuspendTick();
+
+    _sleepStartUs = TSync_LocalUs();
+}
+
+/* ─────────────────────────────────────────────────
+ * Power_PostSleep — configPOST_SLEEP_PROCESSING
+ * Interrupts are still masked, so the wake-up source is
+ * the exception pending in ICSR
+ * ───────────────────────────────────────────────── */
+void Power_PostSleep(uint32_t *expectedIdleTicks)
+{
+    (void)expectedIdleTicks;
+
+    uint32_t slept = TSync_LocalUs() - _sleepStartUs;
+    uint32_t vect  = (SCB->ICSR & SCB_ICSR_VECTPENDING_Msk) >> SCB_ICSR_VECTPENDING_Pos;
+
+    if (vect == (uint32_t)CAN1_RX0_IRQn + 16U)       Power_Counters.wakeCanRx++;
+    else if (vect == (uint32_t)SysTick_IRQn + 16U)   Power_Counters.wakeTick++;
+    else                                             Power_Counters.wakeOther++;
+
+    Power_Counters.sleeps++;
+    Power_Counters.sleepUs += slept;
+
+    /* Credit the HAL tick with the milliseconds TIM1 did not count.
+     * The update flag raised while suspended is dropped so the
+     * sleep is not counted twice */
+    _halTickCarryUs += slept;
+    uwTick          += _halTickCarryUs / 1000U;
+    _halTickCarryUs %= 1000U;
+    __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_UPDATE);
+    HAL_ResumeTick();
+}
+
+/* ─────────────────────────────────────────────────
+ * Power_LogStats — rates over the interval since the
+ * previous call
+ * ───────────────────────────────────────────────── */
+void Power_LogStats(void)
+{
+    char msg[96];
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Power_Counters_t c = Power_Counters;
+    uint32_t now = TSync_LocalUs();
+    __set_PRIMASK(primask);
+
+    uint32_t spanUs = now - _prevUs;
+    if (spanUs == 0) return;
+
+    uint32_t wakes = c.sleeps - _prev.sleeps;
+
+    Power_Stats.switchesPerSec = (uint32_t)(((uint64_t)(c.switches - _prev.switches) * 1000000U
+                                             + spanUs / 2) / spanUs);
+    Power_Stats.idlePermille   = (uint16_t)(((uint64_t)(c.idleUs - _prev.idleUs) * 1000U) / spanUs);
+    Power_Stats.sleepPermille  = (uint16_t)(((uint64_t)(c.sleepUs - _prev.sleepUs) * 1000U) / spanUs);
+
+    snprintf(msg, sizeof(msg), "%lu ctxsw/s, idle %u.%u%%, sleep %u.%u%%",
+             (unsigned long)Power_Stats.switchesPerSec,
+             Power_Stats.idlePermille / 10U, Power_Stats.idlePermille % 10U,
+             Power_Stats.sleepPermille / 10U, Power_Stats.sleepPermille % 10U);
+    UART_Log("POWER", msg);
+
+    snprintf(msg, sizeof(msg), "%lu wakes (CAN RX %lu, tick %lu, other %lu)",
+             (unsigned long)wakes,
+             (unsigned long)(c.wakeCanRx - _prev.wakeCanRx),
+             (unsigned long)(c.wakeTick - _prev.wakeTick),
+             (unsigned long)(c.wakeOther - _prev.wakeOther));
+    UART_Log("POWER", msg);
+
+    _prev   = c;
+    _prevUs = now;
+}
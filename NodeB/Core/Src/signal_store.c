@@ -0,0 +1,243 @@
+/*
+ * signal_store.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "signal_store.h"
+#include "main.h"
+#include "timesync.h"
+#include "uart_log.h"
+#include "prof.h"
+#include <stdio.h>
+
+/* ── Slot ────────────────────────────────────── */
+/* seq is odd while a write is in progress */
+typedef struct {
+    volatile uint32_t seq;
+    volatile int32_t  value;
+    volatile int32_t  min;
+    volatile int32_t  max;
+    volatile int32_t  mean;
+    volatile uint32_t timestampMs;
+    volatile uint32_t rxUs;
+    volatile uint32_t updates;
+} Sig_Slot_t;
+
+static Sig_Slot_t Slots[SIG_COUNT];
+
+static const uint16_t MaxAgeMs[SIG_PER_NODE] = {
+    SIG_RPM_MAX_AGE_MS, SIG_TEMP_MAX_AGE_MS
+};
+
+volatile uint32_t Sig_ReadRetries;
+Sig_Latency_t     Sig_Latency;
+
+/* ── Change Notification ─────────────────────── */
+static volatile uint32_t Dirty;
+static volatile bool     Posted;        /* UpdatedEvt waiting for the listener */
+static AO_Active_t      *Listener;
+static AO_Event_t        UpdatedEvt;
+
+/* ─────────────────────────────────────────────────
+ * Sig_WriteRange — never blocks, never retries
+ * ───────────────────────────────────────────────── */
+void Sig_Write(uint16_t id, int32_t value, uint32_t rxUs)
+{
+    Sig_WriteRange(id, value, value, value, value, rxUs);
+}
+
+__RAM_FUNC void Sig_WriteRange(uint16_t id, int32_t last, int32_t min, int32_t max,
+                               int32_t mean, uint32_t rxUs)
+{
+    if (id >= SIG_COUNT) return;
+
+    Sig_Slot_t *s = &Slots[id];
+    uint32_t seq  = s->seq;
+
+    s->seq = seq + 1;           /* Odd: readers back off */
+    __DMB();
+
+    s->value       = last;
+    s->min         = min;
+    s->max         = max;
+    s->mean        = mean;
+    s->timestampMs = osKernelGetTickCount();
+    s->rxUs        = rxUs;
+    s->updates     = s->updates + 1;
+
+    __DMB();
+    s->seq = seq + 2;           /* Even: consistent again */
+}
+
+/* ─────────────────────────────────────────────────
+ * Sig_Read
+ * Copies the slot, retrying only if a write overlapped
+ * ───────────────────────────────────────────────── */
+Sig_Status_t Sig_Read(uint16_t id, Sig_Sample_t *out, uint32_t nowMs)
+{
+    if (id >= SIG_COUNT) return SIG_NEVER;
+
+    const Sig_Slot_t *s = &Slots[id];
+    uint32_t seq;
+
+    for (;;)
+    {
+        seq = s->seq;
+        if (seq & 1U)
+        {
+            Sig_ReadRetries++;
+            continue;
+        }
+        __DMB();
+
+        out->value       = s->value;
+        out->min         = s->min;
+        out->max         = s->max;
+        out->mean        = s->mean;
+        out->timestampMs = s->timestampMs;
+        out->rxUs        = s->rxUs;
+        out->updates     = s->updates;
+
+        __DMB();
+        if (s->seq == seq) break;
+        Sig_ReadRetries++;
+    }
+
+    if (out->updates == 0) return SIG_NEVER;
+
+    return (nowMs - out->timestampMs > MaxAgeMs[id % SIG_PER_NODE]) ? SIG_STALE : SIG_FRESH;
+}
+
+/* ─────────────────────────────────────────────────
+ * Sig_DecodeFrame
+ * Same decode for the ISR and the task path, so the two
+ * modes differ only in where it runs
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void Sig_Average(uint32_t *avg, uint32_t *max, uint32_t us)
+{
+    *avg += ((int32_t)(us - *avg)) / 16;
+    if (us > *max) *max = us;
+}
+
+__RAM_FUNC bool Sig_DecodeFrame(uint32_t id, const uint8_t *data, uint8_t dlc, uint32_t rxUs)
+{
+    if (!Sig_IsPureData(id)) return false;
+
+    uint8_t  fn     = CAN_ID_DATA_FN(id);
+    uint8_t  node   = CAN_ID_DATA_NODE(id);
+    bool     rpm    = (fn == CAN_FN_RPM || fn == CAN_FN_RPM_AGG);
+    bool     point  = (fn == CAN_FN_RPM || fn == CAN_FN_TEMP);
+    int      fields = point ? 1 : 4;
+    uint16_t sig    = SIG_ID(node, rpm ? SIG_RPM : SIG_TEMP);
+    int32_t  v[4];
+
+    if (dlc < 2 * fields) return false;
+
+    /* Big-endian 16-bit fields — RPM unsigned, TEMP signed */
+    for (int i = 0; i < fields; i++)
+    {
+        uint16_t raw = ((uint16_t)data[2 * i] << 8) | data[2 * i + 1];
+        v[i] = rpm ? (int32_t)raw : (int32_t)(int16_t)raw;
+    }
+
+    if (point)
+    {
+        Sig_Write(sig, v[0], rxUs);
+    }
+    else
+    {
+        /* [min, max, mean, last] */
+        Sig_WriteRange(sig, v[3], v[0], v[1], v[2], rxUs);
+    }
+
+    Sig_Latency.stores++;
+    Sig_Average(&Sig_Latency.storeAvgUs, &Sig_Latency.storeMaxUs, TSync_LocalUs() - rxUs);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    bool post = !Posted && Listener != NULL;
+    Dirty |= 1UL << sig;
+    if (post) Posted = true;
+    __set_PRIMASK(primask);
+
+    /* One event however many slots changed before the listener runs;
+     * if its queue was full, the next update tries again */
+    if (post && !AO_Post(Listener, &UpdatedEvt))
+    {
+        Posted = false;
+    }
+    return true;
+}
+
+void Sig_SetListener(AO_Active_t *ao, uint16_t sig)
+{
+    UpdatedEvt.sig = sig;
+    Listener       = ao;
+}
+
+uint32_t Sig_TakeDirty(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t dirty = Dirty;
+    Dirty  = 0;
+    Posted = false;
+    __set_PRIMASK(primask);
+
+    return dirty;
+}
+
+void Sig_RuleDone(uint32_t rxUs)
+{
+    Sig_Latency.rules++;
+    Sig_Average(&Sig_Latency.ruleAvgUs, &Sig_Latency.ruleMaxUs, TSync_LocalUs() - rxUs);
+}
+
+/* ─────────────────────────────────────────────────
+ * Sig_LogStats
+ * RX ISR cost (PROF_CAN_RX_ISR, Debug builds) and
+ * end-to-end latency, for comparing SIG_ISR_DECODE 1
+ * against 0
+ * ───────────────────────────────────────────────── */
+void Sig_LogStats(void)
+{
+    char msg[128];
+
+#if PROF_ENABLE
+    Prof_Stats_t isr;
+
+    Prof_Get(PROF_CAN_RX_ISR, &isr);
+    if (isr.count != 0U)
+    {
+        snprintf(msg, sizeof(msg), "%s decode: ISR mean %lu max %lu cyc",
+                 SIG_ISR_DECODE ? "ISR" : "task",
+                 (unsigned long)(isr.total / isr.count), (unsigned long)isr.max);
+        UART_Log("FASTPATH", msg);
+    }
+#endif
+
+    snprintf(msg, sizeof(msg), "%s decode: store avg %lu max %lu us, rules avg %lu max %lu us",
+             SIG_ISR_DECODE ? "ISR" : "task",
+             (unsigned long)Sig_Latency.storeAvgUs, (unsigned long)Sig_Latency.storeMaxUs,
+             (unsigned long)Sig_Latency.ruleAvgUs, (unsigned long)Sig_Latency.ruleMaxUs);
+    UART_Log("FASTPATH", msg);
+}
+
+#if SIG_ISR_DECODE
+/* ─────────────────────────────────────────────────
+ * CAN RX fast path — pure data frames never reach the
+ * frame pool or the RX queue
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC bool CAN_App_RxIsFastPath(uint32_t id)
+{
+    return Sig_IsPureData(id);
+}
+
+__RAM_FUNC void CAN_App_RxFastPathISR(uint32_t id, const uint8_t *data, uint8_t dlc, uint32_t rxUs)
+{
+    Sig_DecodeFrame(id, data, dlc, rxUs);
+}
+#endif
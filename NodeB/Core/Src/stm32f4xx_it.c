@@ -22,6 +22,7 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "trace.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -59,7 +60,7 @@ extern CAN_HandleTypeDef hcan1;
 extern TIM_HandleTypeDef htim1;
 
 /* USER CODE BEGIN EV */
-
+extern TIM_HandleTypeDef htim2;
 /* USER CODE END EV */
 
 /******************************************************************************/
@@ -166,11 +167,11 @@ void DebugMon_Handler(void)
 void CAN1_RX0_IRQHandler(void)
 {
   /* USER CODE BEGIN CAN1_RX0_IRQn 0 */
-
+  TRACE_ISR_ENTER(TRACE_IRQ_CAN_RX0);
   /* USER CODE END CAN1_RX0_IRQn 0 */
   HAL_CAN_IRQHandler(&hcan1);
   /* USER CODE BEGIN CAN1_RX0_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_IRQ_CAN_RX0);
   /* USER CODE END CAN1_RX0_IRQn 1 */
 }
 
@@ -189,5 +190,23 @@ void TIM1_UP_TIM10_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles CAN1 TX interrupt.
+  */
+void CAN1_TX_IRQHandler(void)
+{
+  TRACE_ISR_ENTER(TRACE_IRQ_CAN_TX);
+  HAL_CAN_IRQHandler(&hcan1);
+  TRACE_ISR_EXIT(TRACE_IRQ_CAN_TX);
+}
 
+/**
+  * @brief This function handles TIM2 global interrupt.
+  */
+void TIM2_IRQHandler(void)
+{
+  TRACE_ISR_ENTER(TRACE_IRQ_TIM2);
+  HAL_TIM_IRQHandler(&htim2);
+  TRACE_ISR_EXIT(TRACE_IRQ_TIM2);
+}
 /* USER CODE END 1 */
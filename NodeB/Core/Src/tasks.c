@@ -8,165 +8,549 @@
 
 #include "tasks.h"
 #include "main.h"
+#include "co_od.h"
+#include "timesync.h"
+#include "node_table.h"
+#include "liveness.h"
+#include "config.h"
+#include "signal_store.h"
+#include "power.h"
+#include "trace.h"
+#include "prof.h"
 #include <stdbool.h>
 
-/* ── Log Queue ───────────────────────────────── */
-osMessageQueueId_t logQueueHandle;
+/* ── Threads (one per priority level, started in main.c) ── */
+AO_Thread_t HighThread;
+AO_Thread_t AboveThread;
+AO_Thread_t NormalThread;
+AO_Thread_t LowThread;
 
-/* ── Latest received data ────────────────────── */
-static uint16_t g_rpm    = 0;
-static int16_t  g_temp   = 0;
+/* ── Signals, per active object ──────────────── */
+enum {
+    TSYNC_SIG_CYCLE = AO_SIG_USER,
+};
 
-/* ── ACK tracking ────────────────────────────── */
-static volatile bool ackReceived = false;
+enum {
+    RX_SIG_FRAME = AO_SIG_USER,     /* CAN_Frame_t from the RX ISR */
+    RX_SIG_SIGNALS,                 /* Signal store updated in the RX ISR */
+    RX_SIG_LIVE_TICK,
+    RX_SIG_ACK_TIMEOUT,
+    RX_SIG_SDO_TIMEOUT,
+};
+
+enum {
+    CTRL_SIG_BEAT = AO_SIG_USER,
+    CTRL_SIG_DIAG_POLL,
+    CTRL_SIG_STATS,
+};
+
+enum {
+    BEAT_SIG_TICK = AO_SIG_USER,
+};
+
+enum {
+    LOG_SIG_FRAME = AO_SIG_USER,
+};
+
+/* ── Active Objects ──────────────────────────── */
+static void TimeSync_Active(AO_Active_t *me, const AO_Event_t *e);
+static void Rx_Active(AO_Active_t *me, const AO_Event_t *e);
+static void Ctrl_Active(AO_Active_t *me, const AO_Event_t *e);
+static void Heartbeat_Active(AO_Active_t *me, const AO_Event_t *e);
+static void Log_Active(AO_Active_t *me, const AO_Event_t *e);
+
+AO_Active_t TimeSyncAO  = AO_ACTIVE(TimeSync_Active,  "TSYNC");
+AO_Active_t RxAO        = AO_ACTIVE(Rx_Active,        "CAN_RX");
+AO_Active_t CtrlAO      = AO_ACTIVE(Ctrl_Active,      "CAN_TX");
+AO_Active_t HeartbeatAO = AO_ACTIVE(Heartbeat_Active, "HEARTBEAT");
+AO_Active_t LogAO       = AO_ACTIVE(Log_Active,       "LOG");
+
+/* ── Time Events ─────────────────────────────── */
+static AO_TimeEvt_t SyncEvt  = AO_TIME_EVT(&TimeSyncAO,  TSYNC_SIG_CYCLE);
+static AO_TimeEvt_t LiveEvt  = AO_TIME_EVT(&RxAO,        RX_SIG_LIVE_TICK);
+static AO_TimeEvt_t AckEvt   = AO_TIME_EVT(&RxAO,        RX_SIG_ACK_TIMEOUT);
+static AO_TimeEvt_t SdoEvt   = AO_TIME_EVT(&RxAO,        RX_SIG_SDO_TIMEOUT);
+static AO_TimeEvt_t BeatEvt  = AO_TIME_EVT(&CtrlAO,      CTRL_SIG_BEAT);
+static AO_TimeEvt_t PollEvt  = AO_TIME_EVT(&CtrlAO,      CTRL_SIG_DIAG_POLL);
+static AO_TimeEvt_t StatsEvt = AO_TIME_EVT(&CtrlAO,      CTRL_SIG_STATS);
+static AO_TimeEvt_t LedEvt   = AO_TIME_EVT(&HeartbeatAO, BEAT_SIG_TICK);
+
+/* ── Remote-frame poll tracking ──────────────── */
+static volatile uint32_t diagRequestTick = 0;
+static volatile uint8_t  diagNode = 0;
+
+/* ── Subscriptions (rates this controller needs) ── */
+#define CTRL_NODE_ID            0x01
+#define CTRL_HEARTBEAT_MS       500
+#define SUB_RPM_PERIOD_MS       100
+#define SUB_TEMP_PERIOD_MS      500
+
+#define DIAG_POLL_MS            2000
+#define STATS_MS                10000
+#define LED_MS                  500
+
+static void SubscribeNode(uint8_t node)
+{
+    CAN_App_TransmitSubscribe(node, CTRL_NODE_ID, CAN_SIG_RPM,  SUB_RPM_PERIOD_MS);
+    CAN_App_TransmitSubscribe(node, CTRL_NODE_ID, CAN_SIG_TEMP, SUB_TEMP_PERIOD_MS);
+}
 
 /* ─────────────────────────────────────────────────
- * vHeartbeatTask
+ * Tasks_Init
+ * After the threads are started — from here on the RX
+ * ISR posts to RxAO
  * ───────────────────────────────────────────────── */
-void vHeartbeatTask(void *argument)
+void Tasks_Init(void)
 {
-    UART_Log("HEARTBEAT", "Task started");
+    CAN_App_SetRxActive(&RxAO, RX_SIG_FRAME);
+#if SIG_ISR_DECODE
+    Sig_SetListener(&RxAO, RX_SIG_SIGNALS);
+#endif
+}
 
-    for(;;)
+/* ─────────────────────────────────────────────────
+ * Heartbeat_Active
+ * Lowest priority, so it also runs trace dumps — a
+ * dump blocks on the UART for a second or two
+ * ───────────────────────────────────────────────── */
+static void Heartbeat_Active(AO_Active_t *me, const AO_Event_t *e)
+{
+    switch(e->sig)
     {
-        HAL_GPIO_TogglePin(LD2_GPIO_Port, LD2_Pin);
-        osDelay(500);
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            AO_Arm(&LedEvt, 0, LED_MS);
+            break;
+
+        case BEAT_SIG_TICK:
+            HAL_GPIO_TogglePin(LD2_GPIO_Port, LD2_Pin);
+            Trace_Service();
+            Prof_Service();
+            break;
+
+        default:
+            break;
     }
 }
 
 /* ─────────────────────────────────────────────────
- * vCANReceiveTask
- * Node B receives data, evaluates, sends commands
+ * ReleaseFrame
+ * Last stop for a frame RxAO has handled — either
+ * straight back to the pool or on to LogAO
  * ───────────────────────────────────────────────── */
-void vCANReceiveTask(void *argument)
+__RAM_FUNC static void ReleaseFrame(CAN_Frame_t *frame)
 {
-    UART_Log("CAN_RX", "Task started");
+#if CAN_FRAME_TRACE
+    frame->evt.sig = LOG_SIG_FRAME;
+    if(AO_Post(&LogAO, &frame->evt))
+    {
+        return;
+    }
+#endif
+    CAN_Frame_Free(frame);
+}
 
-    typedef struct {
-        uint32_t id;
-        uint8_t  data[8];
-        uint8_t  dlc;
-    } CAN_Frame_t;
+/* ─────────────────────────────────────────────────
+ * SendCommand
+ * The first command left waiting for an ACK arms the
+ * timeout; its expiry re-arms for the next one due
+ * ───────────────────────────────────────────────── */
+static bool SendCommand(uint8_t node, uint8_t cmd, uint32_t now)
+{
+    if(!NodeTable_SendCommand(node, cmd, now))
+    {
+        return false;
+    }
+    if(!AckEvt.armed)
+    {
+        AO_Arm(&AckEvt, OD_ackTimeoutMs, 0);
+    }
+    return true;
+}
 
-    CAN_Frame_t frame;
+/* ─────────────────────────────────────────────────
+ * Live_EventCallback
+ * A lost node goes offline so its next frame re-subscribes
+ * ───────────────────────────────────────────────── */
+void Live_EventCallback(uint8_t node, Live_Event_t event)
+{
+    if(event == LIVE_NODE_LOST)
+    {
+        NodeTable_Get(node)->online = 0;
+    }
+}
 
-    for(;;)
+/* ─────────────────────────────────────────────────
+ * ApplyRules
+ * Evaluates every signal slot updated since the last call.
+ * Updates that landed in between are coalesced — rules only
+ * ever need the latest value
+ * ───────────────────────────────────────────────── */
+static void ApplyRules(uint32_t dirty, uint32_t now)
+{
+    char msg[96];
+
+    while(dirty != 0)
     {
-        if(osMessageQueueGet(canRxQueueHandle, &frame, NULL, osWaitForever) == osOK)
+        uint16_t     id   = (uint16_t)__builtin_ctz(dirty);
+        uint8_t      node = id / SIG_PER_NODE;
+        Sig_Sample_t s;
+
+        dirty &= dirty - 1;
+
+        if(Sig_Read(id, &s, now) == SIG_NEVER) continue;
+
+        if(NodeTable_Touch(node, now))
+        {
+            /* First frame from this node — tell it what we need */
+            SubscribeNode(node);
+        }
+
+        /* Thresholds check the window peak, so a spike between
+         * two broadcasts is not missed */
+        if(id % SIG_PER_NODE == SIG_RPM)
         {
-            switch(frame.id)
+            snprintf(msg, sizeof(msg), "Node %u RPM: %ld (%ld..%ld)", node,
+                     (long)s.value, (long)s.min, (long)s.max);
+            UART_Log("CAN_RX", msg);
+
+            /* Threshold check — ACK is tracked per node, never blocks */
+            if(s.max > OD_rpmLimit &&
+               SendCommand(node, CMD_WARNING_HIGH_RPM, now))
             {
-                case CAN_ID_RPM:
-                {
-                    g_rpm = ((uint16_t)frame.data[0] << 8) | frame.data[1];
-                    UART_Log_Int("CAN_RX", "RPM", g_rpm);
-
-                    /* Threshold check */
-                    if(g_rpm > 5000)
-                    {
-                        UART_Log("WARNING", "RPM threshold exceeded!");
-                        CAN_App_TransmitCommand(CMD_WARNING_HIGH_RPM);
-
-                        /* Optional: Wait for ACK with timeout */
-                        ackReceived = false;
-                        uint32_t startTime = osKernelGetTickCount();
-
-                        while(!ackReceived && (osKernelGetTickCount() - startTime) < 200)
-                        {
-                            osDelay(10);
-                        }
-
-                        if(!ackReceived)
-                        {
-                            UART_Log("ERROR", "Node A did not ACK command!");
-                        }
-                    }
-                    break;
-                }
-
-                case CAN_ID_TEMP:
-                {
-                    g_temp = ((int16_t)frame.data[0] << 8) | frame.data[1];
-                    UART_Log_Int("CAN_RX", "TEMP", g_temp);
-
-                    /* Threshold check */
-                    if(g_temp > 80)
-                    {
-                        UART_Log("WARNING", "Temperature threshold exceeded!");
-                        CAN_App_TransmitCommand(CMD_WARNING_HIGH_TEMP);
-
-                        /* Optional: Wait for ACK with timeout */
-                        ackReceived = false;
-                        uint32_t startTime = osKernelGetTickCount();
-
-                        while(!ackReceived && (osKernelGetTickCount() - startTime) < 200)
-                        {
-                            osDelay(10);
-                        }
-
-                        if(!ackReceived)
-                        {
-                            UART_Log("ERROR", "Node A did not ACK command!");
-                        }
-                    }
-                    break;
-                }
-
-                case CAN_ID_HEARTBEAT:
-                {
-                    UART_Log("CAN_RX", "Heartbeat from Node A");
-                    break;
-                }
-
-                case CAN_ID_ACK:
-                {
-                    uint8_t ackedCmd = frame.data[0];
-                    UART_Log_Int("CAN_RX", "ACK received for command", ackedCmd);
-                    ackReceived = true;  // Signal to waiting task
-                    break;
-                }
-
-                default:
-                {
-                    UART_Log_Int("CAN_RX", "Unknown ID", frame.id);
-                    break;
-                }
+                UART_Log_Int("WARNING", "RPM threshold exceeded on node", node);
             }
         }
+        else
+        {
+            snprintf(msg, sizeof(msg), "Node %u TEMP: %ld (%ld..%ld)", node,
+                     (long)s.value, (long)s.min, (long)s.max);
+            UART_Log("CAN_RX", msg);
+
+            if(s.max > OD_tempLimit &&
+               SendCommand(node, CMD_WARNING_HIGH_TEMP, now))
+            {
+                UART_Log_Int("WARNING", "Temperature threshold exceeded on node", node);
+            }
+        }
+
+        Sig_RuleDone(s.rxUs);
     }
 }
 
 /* ─────────────────────────────────────────────────
- * vCANTransmitTask
- * Node B doesn't send periodic data, only commands
- * This task can be used for periodic health checks
+ * ScheduleLiveness
+ * One-shot to the next occupied wheel slot; with no
+ * deadline pending the wheel does not wake the CPU
  * ───────────────────────────────────────────────── */
-void vCANTransmitTask(void *argument)
+__RAM_FUNC static void ScheduleLiveness(uint32_t now)
 {
-    UART_Log("CAN_TX", "Task started");
+    uint32_t nextMs = Live_NextMs(now);
 
-    for(;;)
+    if(nextMs != 0) AO_Arm(&LiveEvt, nextMs, 0);
+    else            AO_Disarm(&LiveEvt);
+}
+
+/* ─────────────────────────────────────────────────
+ * ScheduleSdoTimeout
+ * One-shot to the open SDO transfer's timeout, pushed
+ * back by every segment; idle when no transfer is open
+ * ───────────────────────────────────────────────── */
+static void ScheduleSdoTimeout(void)
+{
+    uint32_t dueMs = CANopen_SdoDueMs(osKernelGetTickCount());
+
+    if(dueMs != 0) AO_Arm(&SdoEvt, dueMs, 0);
+    else           AO_Disarm(&SdoEvt);
+}
+
+/* ─────────────────────────────────────────────────
+ * HandleSensorData
+ * Non-value frames from a sensor. Node and function come
+ * straight from the CAN ID bits, state is one array index
+ * away — no search
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void HandleSensorData(uint8_t node, uint8_t fn, const CAN_Frame_t *frame, uint32_t now)
+{
+    char msg[96];
+
+    if(NodeTable_Touch(node, now))
+    {
+        /* First frame from this node — tell it what we need */
+        SubscribeNode(node);
+    }
+
+    switch(fn)
     {
-        /* Node B could send its own heartbeat if needed */
-        // CAN_App_TransmitHeartbeat();
-        osDelay(2000);
+        case CAN_FN_HEARTBEAT:
+            /* Re-arms this node's liveness deadline */
+            Live_OnHeartbeat(node, frame->rxUs, now);
+            ScheduleLiveness(now);
+            break;
+
+        case CAN_FN_DIAG:
+        {
+            uint32_t uptime = ((uint32_t)frame->data[0] << 24) | ((uint32_t)frame->data[1] << 16) |
+                              ((uint32_t)frame->data[2] << 8)  |  (uint32_t)frame->data[3];
+            uint16_t rpmSaved = ((uint16_t)frame->data[4] << 8) | frame->data[5];
+            uint16_t tmpSaved = ((uint16_t)frame->data[6] << 8) | frame->data[7];
+
+            snprintf(msg, sizeof(msg), "Node %u up %lus, COV saved RPM %u TEMP %u, poll RTT %lums",
+                     node, (unsigned long)uptime, rpmSaved, tmpSaved,
+                     (unsigned long)(now - diagRequestTick));
+            UART_Log("DIAG", msg);
+            break;
+        }
+
+        default:
+            break;
     }
 }
 
 /* ─────────────────────────────────────────────────
- * vUARTLogTask
+ * HandleFrame
+ * Every frame the RX ISR does not handle itself
  * ───────────────────────────────────────────────── */
-void vUARTLogTask(void *argument)
+__RAM_FUNC static void HandleFrame(CAN_Frame_t *frame, uint32_t now)
 {
-    UART_Log("LOG", "Task started");
+    uint32_t id = frame->id;
 
-    char msg[128];
+    CAN_App_RxDequeued(frame);
 
-    for(;;)
+#if !SIG_ISR_DECODE
+    PROF_BEGIN(PROF_RX_SIGNAL);
+    if(Sig_DecodeFrame(id, frame->data, frame->dlc, frame->rxUs))
+    {
+        /* Decoded here — rules run inline, as before */
+        ApplyRules(Sig_TakeDirty(), now);
+        PROF_END(PROF_RX_SIGNAL);
+    }
+    else
+#endif
+    if(CAN_ID_IS_DATA(id))
     {
-        if(osMessageQueueGet(logQueueHandle, msg, NULL, osWaitForever) == osOK)
+        PROF_BEGIN(PROF_RX_SENSOR);
+        HandleSensorData(CAN_ID_DATA_NODE(id), CAN_ID_DATA_FN(id), frame, now);
+        PROF_END(PROF_RX_SENSOR);
+    }
+    else if(CAN_ID_IS_CMD(id) && CAN_ID_CMD_FN(id) == CAN_FN_ACK)
+    {
+        PROF_BEGIN(PROF_RX_ACK);
+        NodeTable_Ack(CAN_ID_CMD_NODE(id), frame->data[0]);
+        PROF_END(PROF_RX_ACK);
+    }
+    else if(id == CAN_ID_CONFIG_REQ)
+    {
+        PROF_BEGIN(PROF_RX_CONFIG);
+        Cfg_HandleRequest(frame->data, frame->dlc);
+        PROF_END(PROF_RX_CONFIG);
+    }
+    else if(id >= CO_COBID_BOOTUP + CO_NODE_ID_SENSOR &&
+            id <  CO_COBID_BOOTUP + CO_NODE_ID_SENSOR + CAN_MAX_SENSOR_NODES)
+    {
+        /* Sensor restarted and forgot us — subscribe again */
+        PROF_BEGIN(PROF_RX_BOOTUP);
+        uint8_t node = id - (CO_COBID_BOOTUP + CO_NODE_ID_SENSOR);
+        UART_Log_Int("CAN_RX", "Boot-up, re-subscribing node", node);
+        SubscribeNode(node);
+        PROF_END(PROF_RX_BOOTUP);
+    }
+    else
+    {
+        PROF_BEGIN(PROF_RX_CANOPEN);
+        if(!CANopen_ProcessFrame(id, frame->data, frame->dlc))
+        {
+            /* RPDO / SDO traffic, otherwise unknown */
+            UART_Log_Int("CAN_RX", "Unknown ID", id);
+        }
+        ScheduleSdoTimeout();
+        PROF_END(PROF_RX_CANOPEN);
+    }
+
+    ReleaseFrame(frame);
+    CAN_App_ApplyBitrate();
+}
+
+/* ─────────────────────────────────────────────────
+ * Rx_Active
+ * Node B receives data from every sensor node, evaluates
+ * it against the rules and sends commands. With
+ * SIG_ISR_DECODE, RPM/TEMP are decoded in the RX ISR and
+ * one RX_SIG_SIGNALS covers any number of updated slots
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC static void Rx_Active(AO_Active_t *me, const AO_Event_t *e)
+{
+    uint32_t now = osKernelGetTickCount();
+
+    switch(e->sig)
+    {
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            Live_Init(now);
+            break;
+
+        case RX_SIG_FRAME:
+            HandleFrame((CAN_Frame_t *)e, now);
+            break;
+
+        case RX_SIG_SIGNALS:
+            ApplyRules(Sig_TakeDirty(), now);
+            break;
+
+        case RX_SIG_LIVE_TICK:
+            /* Expire heartbeat deadlines — only the due wheel slots are visited */
+            Live_Advance(now);
+            ScheduleLiveness(now);
+            break;
+
+        case RX_SIG_ACK_TIMEOUT:
+        {
+            uint32_t nextMs = NodeTable_CheckAckTimeouts(now, OD_ackTimeoutMs);
+            if(nextMs != 0)
+            {
+                AO_Arm(&AckEvt, nextMs, 0);
+            }
+            break;
+        }
+
+        case RX_SIG_SDO_TIMEOUT:
+            /* Node B has no TPDOs, so this only aborts a stalled transfer */
+            CANopen_Process(now);
+            ScheduleSdoTimeout();
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * PollDiagnostics
+ * One online node's diagnostics per round, with a remote
+ * frame — answered from its RX ISR
+ * ───────────────────────────────────────────────── */
+static void PollDiagnostics(void)
+{
+    for(uint8_t i = 0; i < CAN_MAX_SENSOR_NODES; i++)
+    {
+        uint8_t node = (diagNode + i) & (CAN_MAX_SENSOR_NODES - 1);
+
+        if(NodeTable[node].online)
+        {
+            diagNode        = node + 1;
+            diagRequestTick = osKernelGetTickCount();
+            CAN_App_RequestRemote(CAN_ID_DATA(node, CAN_FN_DIAG), 8);
+            break;
+        }
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Ctrl_Active
+ * Node B doesn't send periodic data, only subscriptions and
+ * its heartbeat. Sensors are discovered by their heartbeat
+ * and subscribed to then
+ * ───────────────────────────────────────────────── */
+static void Ctrl_Active(AO_Active_t *me, const AO_Event_t *e)
+{
+    switch(e->sig)
+    {
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            AO_Arm(&BeatEvt,  0,        CTRL_HEARTBEAT_MS);
+            AO_Arm(&PollEvt,  0,        DIAG_POLL_MS);
+            AO_Arm(&StatsEvt, STATS_MS, STATS_MS);
+            break;
+
+        case CTRL_SIG_BEAT:
+            /* Controller heartbeat keeps our subscriptions alive on the sensors */
+            CAN_App_TransmitCtrlHeartbeat(CTRL_NODE_ID);
+            break;
+
+        case CTRL_SIG_DIAG_POLL:
+            PollDiagnostics();
+            break;
+
+        case CTRL_SIG_STATS:
+            /* Cheap insurance in case a sensor boot-up frame was missed */
+            for(uint8_t node = 0; node < CAN_MAX_SENSOR_NODES; node++)
+            {
+                if(NodeTable[node].online) SubscribeNode(node);
+            }
+            CAN_Frame_LogStats();
+            NodeTable_LogStats();
+            Live_LogStats();
+            Sig_LogStats();
+            CAN_App_LogLatency();
+            Power_LogStats();
+            AO_LogStats(&HighThread);
+            AO_LogStats(&AboveThread);
+            AO_LogStats(&NormalThread);
+            AO_LogStats(&LowThread);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * TimeSync_Active
+ * Node B is the time master — SYNC + FOLLOW_UP every
+ * TSYNC_PERIOD_MS. High priority so SYNC leaves on time.
+ * The one handler that waits: for its own SYNC to
+ * complete behind the bus queue (27 ms bound at 500k,
+ * TSync_TxTimeoutMs), alone on its thread
+ * ───────────────────────────────────────────────── */
+static void TimeSync_Active(AO_Active_t *me, const AO_Event_t *e)
+{
+    switch(e->sig)
+    {
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            AO_Arm(&SyncEvt, 0, TSYNC_PERIOD_MS);
+            break;
+
+        case TSYNC_SIG_CYCLE:
+            TSync_MasterCycle();
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Log_Active
+ * Prints frames handed over by RxAO (CAN_FRAME_TRACE)
+ * and returns them to the pool
+ * ───────────────────────────────────────────────── */
+static void Log_Active(AO_Active_t *me, const AO_Event_t *e)
+{
+    switch(e->sig)
+    {
+        case AO_SIG_ENTRY:
+            UART_Log(me->name, "Started");
+            break;
+
+        case LOG_SIG_FRAME:
         {
-            UART_Log("LOG", msg);
+            CAN_Frame_t *frame = (CAN_Frame_t *)e;
+            char msg[64];
+
+            int len = snprintf(msg, sizeof(msg), "0x%03lX [%u]", (unsigned long)frame->id, frame->dlc);
+
+            for(uint8_t i = 0; i < frame->dlc && i < 8; i++)
+            {
+                len += snprintf(msg + len, sizeof(msg) - len, " %02X", frame->data[i]);
+            }
+
+            UART_Log("TRACE", msg);
+            CAN_Frame_Free(frame);
+            break;
         }
+
+        default:
+            break;
     }
 }
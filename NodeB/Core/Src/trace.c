@@ -0,0 +1,318 @@
+/*
+ * trace.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "trace.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "cmsis_os.h"
+#include "can_app.h"
+#include "co_od.h"
+#include "timesync.h"
+#include "uart_log.h"
+#include "prof.h"
+#include <string.h>
+
+extern CAN_HandleTypeDef hcan1;
+
+#define TRACE_RING_MASK         (TRACE_RING_EVENTS - 1U)
+#define TRACE_UART_RECORDS      6U      /* Per log line, inside UART_Log's 128 bytes */
+#define TRACE_NAME_CHUNK        5U      /* Name bytes per record */
+
+Trace_Ctrl_t Trace_Ctrl = { .autoDump = TRACE_SINK_UART };
+
+#if TRACE_ENABLE
+/* ── Ring ────────────────────────────────────── */
+/* Every write is one masked-IRQ store of 8 bytes: a few dozen cycles,
+ * some 10 events per received frame — well under 1% of the CPU at our
+ * frame rates */
+static Trace_Event_t     _ring[TRACE_RING_EVENTS];
+static uint32_t          _head;             /* Events written since armed */
+static volatile bool     _recording;
+static bool              _triggered;
+static uint32_t          _stopAt;           /* _head at which a trigger freezes the ring */
+static uint32_t          _outTask;
+static uint32_t          _isrStart[TRACE_IRQ_COUNT];
+
+/* ── Names ───────────────────────────────────── */
+static const char *_queueName[TRACE_MAX_QUEUES];
+static uint32_t    _queues;
+
+static const char *const _irqName[TRACE_IRQ_COUNT] = {
+    [TRACE_IRQ_CAN_RX0] = "CAN1_RX0",
+    [TRACE_IRQ_CAN_TX]  = "CAN1_TX",
+    [TRACE_IRQ_TIM2]    = "TIM2",
+    [TRACE_IRQ_TIM3]    = "TIM3",
+};
+
+static const char *const _markName[TRACE_MARK_COUNT] = {
+    [TRACE_MARK_CMD]         = "cmd",
+    [TRACE_MARK_ACK]         = "ack",
+    [TRACE_MARK_ACK_TIMEOUT] = "ack_timeout",
+};
+
+/* ── Dump State ──────────────────────────────── */
+static Trace_Sink_t _sink;
+static uint32_t     _emitted;
+static uint8_t      _line[TRACE_UART_RECORDS][sizeof(Trace_Event_t)];
+static uint32_t     _lineCount;
+
+static void Trace_Arm(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    _head       = 0;
+    _triggered  = false;
+    _recording  = true;
+    __set_PRIMASK(primask);
+}
+#endif
+
+/* After TSync_Init — every event is stamped from TIM2 */
+void Trace_Init(void)
+{
+    /* DWT cycle counter — ISR durations */
+    Prof_CycleCounterEnable();
+
+#if TRACE_ENABLE
+    Trace_Arm();
+#endif
+}
+
+#if TRACE_ENABLE
+/* ─────────────────────────────────────────────────
+ * Trace_Record — from tasks, ISRs and PendSV alike
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC void Trace_Record(uint8_t type, uint8_t id, uint16_t arg)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (_recording)
+    {
+        Trace_Event_t *e = &_ring[_head & TRACE_RING_MASK];
+
+        e->type   = type;
+        e->id     = id;
+        e->arg    = arg;
+        e->timeUs = TSync_LocalUs();
+
+        if (++_head == _stopAt && _triggered) _recording = false;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/* ─────────────────────────────────────────────────
+ * Kernel hooks — task numbers are the kernel's own
+ * (uxTCBNumber). A switch is one event, and only when
+ * the scheduler picked a different task
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC void Trace_TaskSwitchedOut(uint32_t task)
+{
+    _outTask = task;
+}
+
+__RAM_FUNC void Trace_TaskSwitchedIn(uint32_t task)
+{
+    if (task != _outTask)
+    {
+        Trace_Record(TRACE_EV_SWITCH, (uint8_t)task, (uint16_t)_outTask);
+    }
+}
+
+/* traceQUEUE_REGISTRY_ADD — numbers the queue for TRACE_QUEUE */
+void Trace_QueueRegistered(void *queue, const char *name)
+{
+    if (_queues == TRACE_MAX_QUEUES) return;
+
+    _queueName[_queues++] = name;
+    vQueueSetQueueNumber((QueueHandle_t)queue, _queues);
+}
+
+/* ─────────────────────────────────────────────────
+ * IRQ handlers (stm32f4xx_it.c) — the exit event
+ * carries the cycles spent in the handler
+ * ───────────────────────────────────────────────── */
+__RAM_FUNC void Trace_IsrEnter(uint8_t irq)
+{
+    _isrStart[irq] = DWT->CYCCNT;
+    Trace_Record(TRACE_EV_ISR_ENTER, irq, 0);
+}
+
+__RAM_FUNC void Trace_IsrExit(uint8_t irq)
+{
+    uint32_t cycles = DWT->CYCCNT - _isrStart[irq];
+
+    Trace_Record(TRACE_EV_ISR_EXIT, irq, cycles > 0xFFFFU ? 0xFFFFU : (uint16_t)cycles);
+}
+
+/* ─────────────────────────────────────────────────
+ * Trace_Trigger — marks the event and keeps recording
+ * for TRACE_POST_TRIGGER more, so the ring holds what
+ * led up to it and what followed. Only the first
+ * trigger after arming counts
+ * ───────────────────────────────────────────────── */
+void Trace_Trigger(uint8_t mark, uint16_t arg)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (_recording && !_triggered)
+    {
+        _triggered = true;
+        _stopAt    = _head + 1U + TRACE_POST_TRIGGER;
+    }
+    __set_PRIMASK(primask);
+
+    Trace_Record(TRACE_EV_MARK, mark, arg);
+}
+
+/* ─────────────────────────────────────────────────
+ * Dump — header, name tables, events oldest first,
+ * end. UART: six records per hex line behind the
+ * offset of the first; CAN: one record per frame
+ * ───────────────────────────────────────────────── */
+static void Trace_PutU32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+static void Trace_FlushLine(void)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    char     msg[112];
+    uint32_t offset = _emitted - _lineCount;
+    uint32_t len = 0;
+
+    if (_lineCount == 0) return;
+
+    for (int shift = 12; shift >= 0; shift -= 4) msg[len++] = hex[(offset >> shift) & 0x0F];
+    msg[len++] = ' ';
+
+    for (uint32_t r = 0; r < _lineCount; r++)
+    {
+        for (uint32_t b = 0; b < sizeof(_line[r]); b++)
+        {
+            msg[len++] = hex[_line[r][b] >> 4];
+            msg[len++] = hex[_line[r][b] & 0x0F];
+        }
+    }
+    msg[len] = '\0';
+
+    UART_Log("TRC", msg);
+    _lineCount = 0;
+}
+
+static void Trace_Emit(const uint8_t *rec)
+{
+    _emitted++;
+
+    if (_sink == TRACE_SINK_CAN)
+    {
+        if (_emitted % TRACE_CAN_FRAMES_PER_MS == 0U) osDelay(1);
+        while (HAL_CAN_GetTxMailboxesFreeLevel(&hcan1) == 0U) osDelay(1);
+
+        CAN_App_Transmit(TRACE_CAN_ID_BASE + CO_NODE_ID, rec, sizeof(Trace_Event_t));
+        return;
+    }
+
+    memcpy(_line[_lineCount++], rec, sizeof(Trace_Event_t));
+    if (_lineCount == TRACE_UART_RECORDS) Trace_FlushLine();
+}
+
+static void Trace_EmitName(uint8_t kind, uint8_t id, const char *name)
+{
+    size_t len = strnlen(name, configMAX_TASK_NAME_LEN);
+
+    for (uint8_t chunk = 0; chunk * TRACE_NAME_CHUNK < len; chunk++)
+    {
+        uint8_t rec[8] = { kind, id, chunk };
+        size_t  off    = chunk * TRACE_NAME_CHUNK;
+
+        memcpy(&rec[3], name + off, len - off < TRACE_NAME_CHUNK ? len - off : TRACE_NAME_CHUNK);
+        Trace_Emit(rec);
+    }
+}
+
+static void Trace_Dump(Trace_Sink_t sink)
+{
+    static TaskStatus_t tasks[TRACE_MAX_TASKS];
+    uint32_t count = _head < TRACE_RING_EVENTS ? _head : TRACE_RING_EVENTS;
+    uint8_t  rec[8] = { TRACE_REC_HEADER, TRACE_FORMAT_VERSION, CO_NODE_ID };
+
+    _sink      = sink;
+    _emitted   = 0;
+    _lineCount = 0;
+
+    Trace_PutU32(&rec[4], _head);
+    Trace_Emit(rec);
+
+    UBaseType_t n = uxTaskGetSystemState(tasks, TRACE_MAX_TASKS, NULL);
+    for (UBaseType_t i = 0; i < n; i++)
+    {
+        Trace_EmitName(TRACE_REC_TASK_NAME, (uint8_t)tasks[i].xTaskNumber, tasks[i].pcTaskName);
+    }
+    for (uint32_t q = 0; q < _queues; q++)
+    {
+        Trace_EmitName(TRACE_REC_QUEUE_NAME, (uint8_t)(q + 1U), _queueName[q]);
+    }
+    for (uint8_t irq = 1; irq < TRACE_IRQ_COUNT; irq++)
+    {
+        Trace_EmitName(TRACE_REC_IRQ_NAME, irq, _irqName[irq]);
+    }
+    for (uint8_t mark = 1; mark < TRACE_MARK_COUNT; mark++)
+    {
+        Trace_EmitName(TRACE_REC_MARK_NAME, mark, _markName[mark]);
+    }
+
+    /* Recording is stopped — the ring is read in place */
+    for (uint32_t i = _head - count; i != _head; i++)
+    {
+        Trace_Emit((const uint8_t *)&_ring[i & TRACE_RING_MASK]);
+    }
+
+    memset(rec, 0, sizeof(rec));
+    rec[0] = TRACE_REC_END;
+    Trace_PutU32(&rec[4], count);
+    Trace_Emit(rec);
+    Trace_FlushLine();
+
+    UART_Log_Int("TRC", sink == TRACE_SINK_CAN ? "Dumped over CAN, events" : "Dumped, events", (int)count);
+}
+#endif
+
+/* ─────────────────────────────────────────────────
+ * Trace_Service — from a low-priority task. Publishes
+ * the counters and runs a requested (OD 0x2700:01) or
+ * automatic dump, then re-arms the ring
+ * ───────────────────────────────────────────────── */
+void Trace_Service(void)
+{
+#if TRACE_ENABLE
+    uint8_t sink = Trace_Ctrl.request;
+
+    Trace_Ctrl.recorded = _head;
+    Trace_Ctrl.frozen   = _triggered && !_recording;
+
+    if (sink == TRACE_SINK_NONE && Trace_Ctrl.frozen) sink = Trace_Ctrl.autoDump;
+    if (sink != TRACE_SINK_UART && sink != TRACE_SINK_CAN)
+    {
+        Trace_Ctrl.request = TRACE_SINK_NONE;
+        return;
+    }
+
+    _recording = false;
+    Trace_Dump((Trace_Sink_t)sink);
+    Trace_Ctrl.request = TRACE_SINK_NONE;
+    Trace_Arm();
+#endif
+}
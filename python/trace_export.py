@@ -0,0 +1,217 @@
+import argparse
+import json
+import re
+import sys
+
+# Turns a trace dump (Core/Src/trace.c) into Chrome trace JSON, which
+# Perfetto (ui.perfetto.dev) and chrome://tracing open as a timeline:
+# one track per task, one per IRQ, a counter per queue, protocol marks
+# as instants. Input is either a UART capture holding "[TRC]" lines or
+# a candump log of the 0x780 + node ID dump frames.
+#
+#   python3 trace_export.py capture.log -o trace.json
+
+REC_HEADER = 0x80
+REC_TASK_NAME = 0x81
+REC_QUEUE_NAME = 0x82
+REC_IRQ_NAME = 0x83
+REC_MARK_NAME = 0x84
+REC_END = 0x8F
+
+EV_SWITCH = 1
+EV_QUEUE_SEND = 2
+EV_QUEUE_RECEIVE = 3
+EV_QUEUE_FULL = 4
+EV_ISR_ENTER = 5
+EV_ISR_EXIT = 6
+EV_MARK = 7
+
+NAME_KINDS = {REC_TASK_NAME: 'task', REC_QUEUE_NAME: 'queue',
+              REC_IRQ_NAME: 'irq', REC_MARK_NAME: 'mark'}
+
+IRQ_TID_BASE = 1000
+
+UART_LINE = re.compile(r'\[TRC\]\s+([0-9A-Fa-f]{4})\s+([0-9A-Fa-f]+)\s*$')
+# candump: "can0  78F   [8]  80 01 ..." or "(1.0) can0 78F#8001..."
+CANDUMP_SPACED = re.compile(r'\s([0-9A-Fa-f]{3})\s+\[8\]\s+((?:[0-9A-Fa-f]{2}\s*){8})')
+CANDUMP_COMPACT = re.compile(r'\s([0-9A-Fa-f]{3})#([0-9A-Fa-f]{16})')
+
+# Parse
+def read_records(path, can_id):
+    records = []
+    expected = None
+
+    with open(path, errors='replace') as f:
+        for line in f:
+            m = UART_LINE.search(line)
+            if m:
+                offset = int(m.group(1), 16)
+                data = bytes.fromhex(m.group(2))
+                if offset == 0:
+                    expected = 0
+                if expected is not None and offset != expected:
+                    print(f"warning: records {expected}..{offset - 1} missing", file=sys.stderr)
+                expected = offset + len(data) // 8
+                records += [data[i:i + 8] for i in range(0, len(data) - 7, 8)]
+                continue
+
+            m = CANDUMP_SPACED.search(line) or CANDUMP_COMPACT.search(line)
+            if not m:
+                continue
+            ident = int(m.group(1), 16)
+            if ident == can_id or (can_id is None and ident & 0x780 == 0x780):
+                records.append(bytes.fromhex(m.group(2).replace(' ', '')))
+
+    return records
+
+def split_dumps(records):
+    dumps = []
+    for rec in records:
+        if rec[0] == REC_HEADER:
+            dumps.append([])
+        if dumps:
+            dumps[-1].append(rec)
+    return dumps
+
+def decode(dump):
+    header = dump[0]
+    names = {kind: {} for kind in NAME_KINDS.values()}
+    chunks = {}
+    events = []
+    ended = False
+
+    if header[1] != 1:
+        print(f"warning: format version {header[1]}, expected 1", file=sys.stderr)
+
+    for rec in dump[1:]:
+        kind = rec[0]
+        if kind in NAME_KINDS:
+            chunks.setdefault((NAME_KINDS[kind], rec[1]), {})[rec[2]] = rec[3:8]
+        elif kind == REC_END:
+            ended = True
+            dumped = int.from_bytes(rec[4:8], 'little')
+            if dumped != len(events):
+                print(f"warning: {dumped} events dumped, {len(events)} received", file=sys.stderr)
+        elif kind < REC_HEADER:
+            events.append((kind, rec[1], int.from_bytes(rec[2:4], 'little'),
+                           int.from_bytes(rec[4:8], 'little')))
+
+    if not ended:
+        print("warning: dump has no end record", file=sys.stderr)
+
+    for (table, ident), parts in chunks.items():
+        raw = b''.join(parts[i] for i in sorted(parts))
+        names[table][ident] = raw.split(b'\0')[0].decode('ascii', 'replace')
+
+    return {'node': header[2], 'recorded': int.from_bytes(header[4:8], 'little'),
+            'names': names, 'events': events}
+
+# Timeline
+def unwrap(events):
+    """32-bit µs timestamps, oldest first — add a wrap each time they go back"""
+    wraps = 0
+    last = None
+    out = []
+    for kind, ident, arg, t in events:
+        if last is not None and t < last:
+            wraps += 1
+        last = t
+        out.append((kind, ident, arg, t + (wraps << 32)))
+    return out
+
+def to_chrome(trace):
+    names = trace['names']
+    events = unwrap(trace['events'])
+    pid = trace['node']
+    out = []
+
+    def task_name(ident):
+        return names['task'].get(ident, f"task {ident}")
+
+    def irq_name(ident):
+        return names['irq'].get(ident, f"irq {ident}")
+
+    if not events:
+        return out
+    t0 = events[0][3]
+
+    out.append({'ph': 'M', 'name': 'process_name', 'pid': pid, 'tid': 0,
+                'args': {'name': f"Node 0x{pid:02X}"}})
+    for ident in names['task']:
+        out.append({'ph': 'M', 'name': 'thread_name', 'pid': pid, 'tid': ident,
+                    'args': {'name': task_name(ident)}})
+    for ident in names['irq']:
+        out.append({'ph': 'M', 'name': 'thread_name', 'pid': pid, 'tid': IRQ_TID_BASE + ident,
+                    'args': {'name': f"IRQ {irq_name(ident)}"}})
+
+    running = None
+    running_since = 0
+    isr_since = {}
+
+    for kind, ident, arg, t in events:
+        ts = t - t0
+
+        if kind == EV_SWITCH:
+            if running is None:
+                running = arg
+            out.append({'ph': 'X', 'name': task_name(running), 'pid': pid, 'tid': running,
+                        'ts': running_since, 'dur': ts - running_since})
+            running = ident
+            running_since = ts
+
+        elif kind == EV_ISR_ENTER:
+            isr_since[ident] = ts
+
+        elif kind == EV_ISR_EXIT:
+            start = isr_since.pop(ident, None)
+            if start is not None:
+                out.append({'ph': 'X', 'name': irq_name(ident), 'pid': pid,
+                            'tid': IRQ_TID_BASE + ident, 'ts': start, 'dur': ts - start,
+                            'args': {'cycles': arg}})
+
+        elif kind in (EV_QUEUE_SEND, EV_QUEUE_RECEIVE):
+            depth = arg + 1 if kind == EV_QUEUE_SEND else arg - 1
+            out.append({'ph': 'C', 'name': f"queue {names['queue'].get(ident, ident)}",
+                        'pid': pid, 'ts': ts, 'args': {'depth': depth}})
+
+        elif kind == EV_QUEUE_FULL:
+            out.append({'ph': 'i', 's': 'p', 'name': f"full {names['queue'].get(ident, ident)}",
+                        'pid': pid, 'tid': 0, 'ts': ts, 'args': {'waiting': arg}})
+
+        elif kind == EV_MARK:
+            out.append({'ph': 'i', 's': 'p', 'name': names['mark'].get(ident, f"mark {ident}"),
+                        'pid': pid, 'tid': 0, 'ts': ts, 'args': {'arg': arg}})
+
+    if running is not None:
+        out.append({'ph': 'X', 'name': task_name(running), 'pid': pid, 'tid': running,
+                    'ts': running_since, 'dur': events[-1][3] - t0 - running_since})
+
+    return out
+
+def main():
+    parser = argparse.ArgumentParser(description='Export a trace dump as Chrome/Perfetto JSON')
+    parser.add_argument('capture', help='UART capture or candump log')
+    parser.add_argument('-o', '--output', default='trace.json')
+    parser.add_argument('--can-id', type=lambda s: int(s, 0),
+                        help='dump frame ID, default any 0x780 + node')
+    parser.add_argument('--dump', type=int, default=-1,
+                        help='which dump in the capture, default the last')
+    args = parser.parse_args()
+
+    dumps = split_dumps(read_records(args.capture, args.can_id))
+    if not dumps:
+        print(f"No trace dump in {args.capture}", file=sys.stderr)
+        return 1
+
+    trace = decode(dumps[args.dump])
+    events = to_chrome(trace)
+
+    with open(args.output, 'w') as f:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ns'}, f)
+
+    print(f"Node 0x{trace['node']:02X}: {len(trace['events'])} events of {trace['recorded']} recorded, "
+          f"{len(dumps)} dump(s) in capture -> {args.output}")
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,131 @@
+/*
+ * FreeRTOSConfig.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Kernel configuration for the host build. Shadows the node's
+ *  Core/Inc/FreeRTOSConfig.h and keeps its values — priorities,
+ *  tick rate, static-only allocation, CMSIS-RTOS2 options — so the
+ *  firmware's scheduling is what runs. What differs:
+ *
+ *   - no tickless idle: the POSIX port has no low-power hook
+ *   - the tick hook drives the simulated NVIC (sim_core.c)
+ *   - no Cortex-M priority macros and no SysTick handler
+ *   - a failed configASSERT reports file and line, then aborts
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+#include <stddef.h>
+extern uint32_t SystemCoreClock;
+
+#ifndef CMSIS_device_header
+#define CMSIS_device_header "stm32f4xx.h"
+#endif /* CMSIS_device_header */
+
+#define configENABLE_FPU                         0
+#define configENABLE_MPU                         0
+
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          1
+#define configSUPPORT_DYNAMIC_ALLOCATION         0
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      1
+#define configCPU_CLOCK_HZ                       ( SystemCoreClock )
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 56 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
+#define configTOTAL_HEAP_SIZE                    ((size_t)0)
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_TRACE_FACILITY                 1
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_RECURSIVE_MUTEXES              1
+#define configUSE_COUNTING_SEMAPHORES            1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configUSE_TICKLESS_IDLE                  0
+#define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
+
+/* Software timer definitions. */
+#define configUSE_TIMERS                         1
+#define configTIMER_TASK_PRIORITY                ( 2 )
+#define configTIMER_QUEUE_LENGTH                 10
+#define configTIMER_TASK_STACK_DEPTH             256
+
+/* glibc, not newlib */
+#define configUSE_NEWLIB_REENTRANT               0
+
+/* CMSIS-RTOS V2 flags */
+#define configUSE_OS2_THREAD_SUSPEND_RESUME  1
+#define configUSE_OS2_THREAD_ENUMERATE       1
+#define configUSE_OS2_EVENTFLAGS_FROM_ISR    1
+#define configUSE_OS2_THREAD_FLAGS           1
+#define configUSE_OS2_TIMER                  1
+#define configUSE_OS2_MUTEX                  1
+
+#define INCLUDE_vTaskPrioritySet             1
+#define INCLUDE_uxTaskPriorityGet            1
+#define INCLUDE_vTaskDelete                  1
+#define INCLUDE_vTaskCleanUpResources        0
+#define INCLUDE_vTaskSuspend                 1
+#define INCLUDE_vTaskDelayUntil              1
+#define INCLUDE_vTaskDelay                   1
+#define INCLUDE_xTaskGetSchedulerState       1
+#define INCLUDE_xTimerPendFunctionCall       1
+#define INCLUDE_xQueueGetMutexHolder         1
+#define INCLUDE_uxTaskGetStackHighWaterMark  1
+#define INCLUDE_xTaskGetCurrentTaskHandle    1
+#define INCLUDE_eTaskGetState                1
+
+/* The POSIX port runs the tick from a signal — no SysTick */
+#define USE_CUSTOM_SYSTICK_HANDLER_IMPLEMENTATION 1
+
+void Sim_AssertFailed(const char *file, int line);
+#define configASSERT( x ) if ((x) == 0) { Sim_AssertFailed(__FILE__, __LINE__); }
+
+/* Context switch and idle time accounting and the trace recorder, as
+   on target. The simulated NVIC runs as a task; its switches are
+   interrupt entries on the real part, so they are not counted */
+#include "trace.h"
+void Power_TaskSwitchedIn(const void *tcb, uint32_t isIdle);
+extern void *Sim_IrqTaskHandle;
+
+/* Trace hooks run with the kernel's own mask held (a critical section
+   or the scheduler); the flag tells Sim_SetPrimask to leave it in
+   place without asking the OS for the thread's signal mask */
+extern __thread int Sim_InKernelHook;
+#define SIM_KERNEL_HOOK(hook)                                                \
+    do { Sim_InKernelHook++; hook; Sim_InKernelHook--; } while (0)
+
+#define traceTASK_SWITCHED_IN()                                              \
+    do {                                                                     \
+        if ((void *)pxCurrentTCB != Sim_IrqTaskHandle)                       \
+        {                                                                    \
+            Power_TaskSwitchedIn(pxCurrentTCB,                               \
+                                 (void *)pxCurrentTCB == (void *)xIdleTaskHandle); \
+            SIM_KERNEL_HOOK(TRACE_TASK_IN(pxCurrentTCB->uxTCBNumber));       \
+        }                                                                    \
+    } while (0)
+#define traceTASK_SWITCHED_OUT()                                             \
+    do {                                                                     \
+        if ((void *)pxCurrentTCB != Sim_IrqTaskHandle)                       \
+            TRACE_TASK_OUT(pxCurrentTCB->uxTCBNumber);                       \
+    } while (0)
+
+#define traceQUEUE_SEND(q)                       SIM_KERNEL_HOOK(TRACE_QUEUE(TRACE_EV_QUEUE_SEND, q))
+#define traceQUEUE_SEND_FROM_ISR(q)              SIM_KERNEL_HOOK(TRACE_QUEUE(TRACE_EV_QUEUE_SEND, q))
+#define traceQUEUE_SEND_FAILED(q)                SIM_KERNEL_HOOK(TRACE_QUEUE(TRACE_EV_QUEUE_FULL, q))
+#define traceQUEUE_SEND_FROM_ISR_FAILED(q)       SIM_KERNEL_HOOK(TRACE_QUEUE(TRACE_EV_QUEUE_FULL, q))
+#define traceQUEUE_RECEIVE(q)                    SIM_KERNEL_HOOK(TRACE_QUEUE(TRACE_EV_QUEUE_RECEIVE, q))
+#define traceQUEUE_RECEIVE_FROM_ISR(q)           SIM_KERNEL_HOOK(TRACE_QUEUE(TRACE_EV_QUEUE_RECEIVE, q))
+#define traceQUEUE_REGISTRY_ADD(q, name)         TRACE_QUEUE_NAME(q, name)
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,113 @@
+/*
+ * sim.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Host simulation of the STM32F446 — internal interface between
+ *  the simulated core (NVIC, clocks), the peripheral models and the
+ *  CAN bus backends. Node code never includes this; it sees only
+ *  the stand-in device and HAL headers.
+ *
+ *  Interrupts: a FreeRTOS task above every application priority
+ *  plays the NVIC. The tick hook wakes it each millisecond; it polls
+ *  the peripheral models and calls the vector table handlers with
+ *  IPSR set, so the HAL callbacks and the *FromISR APIs run exactly
+ *  as they do in a real handler. Timer compares and CAN events are
+ *  therefore serviced with up to one tick of latency. Received frames
+ *  enter the RX FIFOs one at a time with the handlers run in between,
+ *  so a burst within one tick does not overrun a FIFO the node drains.
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include "stm32f4xx.h"
+#include "vcan.h"
+
+/* ── Core (sim_core.c) ───────────────────────── */
+extern void *Sim_IrqTaskHandle;
+
+void     Sim_Init(void);
+uint64_t Sim_NowNs(void);               /* Host monotonic time since start */
+bool     Sim_NvicIsEnabled(IRQn_Type irq);
+void     Sim_AssertFailed(const char *file, int line);
+
+/* ── Peripheral Models ───────────────────────── */
+uint32_t Sim_TimerClockHz(const TIM_TypeDef *tim);     /* sim_hal.c */
+
+void     Sim_TIM_Start(TIM_TypeDef *tim);               /* sim_tim.c */
+void     Sim_TIM_Stop(TIM_TypeDef *tim);
+void     Sim_TIM_Poll(TIM_TypeDef *tim);
+bool     Sim_TIM_IrqPending(const TIM_TypeDef *tim);
+
+bool     Sim_CAN_Poll(void);                            /* sim_can.c */
+bool     Sim_CAN_TxIrqPending(void);
+bool     Sim_CAN_Rx0IrqPending(void);
+bool     Sim_CAN_Rx1IrqPending(void);
+uint32_t Sim_CAN_RxRead(void);                          /* Frames the node read out */
+uint32_t Sim_CAN_RxFiltered(void);                      /* Frames the filter banks dropped */
+
+/* ── CAN Bus Backends ────────────────────────── */
+/* The frame layout of the virtual bus library, so a model can hand
+ * frames to it unchanged */
+typedef VCAN_Frame_t Sim_CanFrame_t;
+
+/* One acceptance rule of the active filter banks in the RIR layout
+ * (STID[31:21] EXID[20:3] IDE RTR): a frame passes when
+ * (RIR ^ id) & mask == 0. 16-bit banks come out widened */
+typedef struct {
+    uint32_t id;
+    uint32_t mask;
+} Sim_CanFilter_t;
+
+uint32_t Sim_CAN_GetFilters(Sim_CanFilter_t *out, uint32_t max);  /* sim_can.c */
+
+/* A backend carries frames between simulated controllers. send()
+ * gets the time the frame's last bit left and returns false if no
+ * node acknowledged; poll() must not block and is only ever called
+ * from the IRQ task. poll() reports the sender's bitrate (0 when the
+ * medium has only one) and the receive time. Times are on the
+ * Sim_NowNs() scale. flush() and refilter() are optional: the
+ * first ends a poll pass, for backends that batch their sends, the
+ * second follows every filter bank change */
+typedef struct {
+    const char *name;
+    bool (*open)(void);
+    bool (*send)(const Sim_CanFrame_t *frame, uint32_t bitrate, uint64_t timeNs);
+    bool (*poll)(Sim_CanFrame_t *frame, uint32_t *bitrate, uint64_t *timeNs);
+    void (*flush)(void);
+    void (*refilter)(void);
+} Sim_CanBus_t;
+
+extern const Sim_CanBus_t Sim_CanBusUdp;               /* sim_bus_udp.c */
+#if defined(__linux__)
+extern const Sim_CanBus_t Sim_CanBusSocketCan;         /* sim_bus_socketcan.c */
+#endif
+
+/* Only in benchmark builds (perf/perf.c): the bench is the rest of
+ * the bus, and SIM_CAN_BUS is ignored */
+extern const Sim_CanBus_t Sim_CanBusPerf __attribute__((weak));
+
+/* ── Host Threads (sim_core.c) ───────────────── */
+/* Backends receive on a plain pthread and hand frames to the IRQ
+ * task through a single-producer, single-consumer ring */
+#define SIM_RX_RING_SIZE    256U        /* Power of two */
+
+typedef struct {
+    Sim_CanFrame_t frame;
+    uint32_t       bitrate;
+    uint64_t       timeNs;
+} Sim_RxItem_t;
+
+typedef struct {
+    Sim_RxItem_t     item[SIM_RX_RING_SIZE];
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+} Sim_RxRing_t;
+
+bool Sim_StartThread(void *(*entry)(void *));          /* With every signal masked */
+bool Sim_RxRingPut(Sim_RxRing_t *ring, const Sim_RxItem_t *item);
+bool Sim_RxRingGet(Sim_RxRing_t *ring, Sim_RxItem_t *item);
+
+#endif /* SIM_H_ */
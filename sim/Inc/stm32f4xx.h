@@ -0,0 +1,367 @@
+/*
+ * stm32f4xx.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Host stand-in for the STM32F446 device header. Register blocks are
+ *  plain structs owned by the simulator (sim_*.c), with the field
+ *  names and bit positions of the real part, so node code that pokes
+ *  registers directly (the CAN RX FIFO peek, FLASH->ACR, DWT) builds
+ *  unchanged. Only what the two nodes use is modelled.
+ *
+ *  The Cortex-M intrinsics map onto the FreeRTOS POSIX port: masking
+ *  interrupts blocks the port's tick signal on the calling thread,
+ *  and IPSR is non-zero while the simulated NVIC runs a handler.
+ */
+
+#ifndef SIM_STM32F4XX_H_
+#define SIM_STM32F4XX_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cmsis_compiler.h"
+
+#define __IO                    volatile
+#define __I                     volatile const
+#define __O                     volatile
+
+#define __NVIC_PRIO_BITS        4U
+
+/* ── Interrupt Numbers ───────────────────────── */
+typedef enum {
+    NonMaskableInt_IRQn         = -14,
+    MemoryManagement_IRQn       = -12,
+    BusFault_IRQn               = -11,
+    UsageFault_IRQn             = -10,
+    SVCall_IRQn                 = -5,
+    DebugMonitor_IRQn           = -4,
+    PendSV_IRQn                 = -2,
+    SysTick_IRQn                = -1,
+    CAN1_TX_IRQn                = 19,
+    CAN1_RX0_IRQn               = 20,
+    CAN1_RX1_IRQn               = 21,
+    CAN1_SCE_IRQn               = 22,
+    TIM1_UP_TIM10_IRQn          = 25,
+    TIM2_IRQn                   = 28,
+    TIM3_IRQn                   = 29,
+    USART2_IRQn                 = 38,
+    EXTI15_10_IRQn              = 40,
+} IRQn_Type;
+
+#define SIM_IRQ_COUNT           64      /* Device lines modelled by the NVIC */
+
+/* ── bxCAN ───────────────────────────────────── */
+typedef struct {
+    __IO uint32_t TIR;
+    __IO uint32_t TDTR;
+    __IO uint32_t TDLR;
+    __IO uint32_t TDHR;
+} CAN_TxMailBox_TypeDef;
+
+typedef struct {
+    __IO uint32_t RIR;
+    __IO uint32_t RDTR;
+    __IO uint32_t RDLR;
+    __IO uint32_t RDHR;
+} CAN_FIFOMailBox_TypeDef;
+
+typedef struct {
+    __IO uint32_t FR1;
+    __IO uint32_t FR2;
+} CAN_FilterRegister_TypeDef;
+
+typedef struct {
+    __IO uint32_t MCR;
+    __IO uint32_t MSR;
+    __IO uint32_t TSR;
+    __IO uint32_t RF0R;
+    __IO uint32_t RF1R;
+    __IO uint32_t IER;
+    __IO uint32_t ESR;
+    __IO uint32_t BTR;
+    CAN_TxMailBox_TypeDef      sTxMailBox[3];
+    CAN_FIFOMailBox_TypeDef    sFIFOMailBox[2];     /* Head of each FIFO */
+    __IO uint32_t FMR;
+    __IO uint32_t FM1R;
+    __IO uint32_t FS1R;
+    __IO uint32_t FFA1R;
+    __IO uint32_t FA1R;
+    CAN_FilterRegister_TypeDef sFilterRegister[28];
+} CAN_TypeDef;
+
+#define CAN_MCR_INRQ            (1U << 0)
+#define CAN_MCR_TXFP            (1U << 2)
+#define CAN_MCR_RFLM            (1U << 3)
+#define CAN_MCR_NART            (1U << 4)
+#define CAN_MCR_ABOM            (1U << 6)
+#define CAN_MSR_INAK            (1U << 0)
+
+#define CAN_TSR_RQCP0           (1U << 0)
+#define CAN_TSR_TXOK0           (1U << 1)
+#define CAN_TSR_ALST0           (1U << 2)
+#define CAN_TSR_TERR0           (1U << 3)
+#define CAN_TSR_RQCP1           (1U << 8)
+#define CAN_TSR_TXOK1           (1U << 9)
+#define CAN_TSR_ALST1           (1U << 10)
+#define CAN_TSR_TERR1           (1U << 11)
+#define CAN_TSR_RQCP2           (1U << 16)
+#define CAN_TSR_TXOK2           (1U << 17)
+#define CAN_TSR_ALST2           (1U << 18)
+#define CAN_TSR_TERR2           (1U << 19)
+#define CAN_TSR_TME0            (1U << 26)
+#define CAN_TSR_TME1            (1U << 27)
+#define CAN_TSR_TME2            (1U << 28)
+#define CAN_TSR_TME             (CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2)
+
+#define CAN_RF0R_FMP0           (3U << 0)
+#define CAN_RF0R_FULL0          (1U << 3)
+#define CAN_RF0R_FOVR0          (1U << 4)
+#define CAN_RF0R_RFOM0          (1U << 5)
+#define CAN_RF1R_FMP1           (3U << 0)
+#define CAN_RF1R_FULL1          (1U << 3)
+#define CAN_RF1R_FOVR1          (1U << 4)
+#define CAN_RF1R_RFOM1          (1U << 5)
+
+#define CAN_IER_TMEIE           (1U << 0)
+#define CAN_IER_FMPIE0          (1U << 1)
+#define CAN_IER_FFIE0           (1U << 2)
+#define CAN_IER_FOVIE0          (1U << 3)
+#define CAN_IER_FMPIE1          (1U << 4)
+#define CAN_IER_FFIE1           (1U << 5)
+#define CAN_IER_FOVIE1          (1U << 6)
+#define CAN_IER_ERRIE           (1U << 15)
+
+#define CAN_ESR_EWGF            (1U << 0)
+#define CAN_ESR_EPVF            (1U << 1)
+#define CAN_ESR_BOFF            (1U << 2)
+#define CAN_ESR_TEC_Pos         16U
+#define CAN_ESR_REC_Pos         24U
+
+#define CAN_BTR_BRP_Pos         0U
+#define CAN_BTR_BRP             (0x3FFU << CAN_BTR_BRP_Pos)
+#define CAN_BTR_TS1_Pos         16U
+#define CAN_BTR_TS1             (0xFU << CAN_BTR_TS1_Pos)
+#define CAN_BTR_TS2_Pos         20U
+#define CAN_BTR_TS2             (0x7U << CAN_BTR_TS2_Pos)
+#define CAN_BTR_SJW_Pos         24U
+#define CAN_BTR_SJW             (0x3U << CAN_BTR_SJW_Pos)
+#define CAN_BTR_LBKM            (1U << 30)
+#define CAN_BTR_SILM            (1U << 31)
+
+#define CAN_TI0R_TXRQ           (1U << 0)
+#define CAN_TI0R_RTR            (1U << 1)
+#define CAN_TI0R_IDE            (1U << 2)
+#define CAN_TI0R_EXID_Pos       3U
+#define CAN_TI0R_EXID           (0x3FFFFU << CAN_TI0R_EXID_Pos)
+#define CAN_TI0R_STID_Pos       21U
+#define CAN_TI0R_STID           (0x7FFU << CAN_TI0R_STID_Pos)
+#define CAN_TDT0R_DLC           (0xFU << 0)
+
+#define CAN_RI0R_RTR            (1U << 1)
+#define CAN_RI0R_IDE            (1U << 2)
+#define CAN_RI0R_EXID_Pos       3U
+#define CAN_RI0R_EXID           (0x3FFFFU << CAN_RI0R_EXID_Pos)
+#define CAN_RI0R_STID_Pos       21U
+#define CAN_RI0R_STID           (0x7FFU << CAN_RI0R_STID_Pos)
+#define CAN_RDT0R_DLC           (0xFU << 0)
+#define CAN_RDT0R_FMI_Pos       8U
+#define CAN_RDT0R_FMI           (0xFFU << CAN_RDT0R_FMI_Pos)
+#define CAN_RDT0R_TIME_Pos      16U
+#define CAN_RDT0R_TIME          (0xFFFFU << CAN_RDT0R_TIME_Pos)
+
+/* ── Timers ──────────────────────────────────── */
+/* CNT is not kept current — read it through __HAL_TIM_GET_COUNTER */
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMCR;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t EGR;
+    __IO uint32_t CCMR1;
+    __IO uint32_t CCMR2;
+    __IO uint32_t CCER;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t RCR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+    __IO uint32_t BDTR;
+    __IO uint32_t DCR;
+    __IO uint32_t DMAR;
+    __IO uint32_t OR;
+} TIM_TypeDef;
+
+#define TIM_CR1_CEN             (1U << 0)
+#define TIM_DIER_UIE            (1U << 0)
+#define TIM_DIER_CC1IE          (1U << 1)
+#define TIM_DIER_CC2IE          (1U << 2)
+#define TIM_DIER_CC3IE          (1U << 3)
+#define TIM_DIER_CC4IE          (1U << 4)
+#define TIM_SR_UIF              (1U << 0)
+#define TIM_SR_CC1IF            (1U << 1)
+#define TIM_SR_CC2IF            (1U << 2)
+#define TIM_SR_CC3IF            (1U << 3)
+#define TIM_SR_CC4IF            (1U << 4)
+#define TIM_EGR_UG              (1U << 0)
+
+/* ── USART / GPIO / FLASH ────────────────────── */
+typedef struct {
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t BRR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t CR3;
+    __IO uint32_t GTPR;
+} USART_TypeDef;
+
+typedef struct {
+    __IO uint32_t MODER;
+    __IO uint32_t OTYPER;
+    __IO uint32_t OSPEEDR;
+    __IO uint32_t PUPDR;
+    __IO uint32_t IDR;
+    __IO uint32_t ODR;
+    __IO uint32_t BSRR;
+    __IO uint32_t LCKR;
+    __IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    __IO uint32_t ACR;
+    __IO uint32_t KEYR;
+    __IO uint32_t OPTKEYR;
+    __IO uint32_t SR;
+    __IO uint32_t CR;
+    __IO uint32_t OPTCR;
+    __IO uint32_t OPTCR1;
+} FLASH_TypeDef;
+
+#define FLASH_ACR_LATENCY       (0xFU << 0)
+#define FLASH_ACR_PRFTEN        (1U << 8)
+#define FLASH_ACR_ICEN          (1U << 9)
+#define FLASH_ACR_DCEN          (1U << 10)
+
+/* ── Cortex-M4 Core ──────────────────────────── */
+typedef struct {
+    __I  uint32_t CPUID;
+    __IO uint32_t ICSR;
+    __IO uint32_t VTOR;
+    __IO uint32_t AIRCR;
+    __IO uint32_t SCR;
+    __IO uint32_t CCR;
+    __IO uint8_t  SHP[12];
+    __IO uint32_t SHCSR;
+} SCB_Type;
+
+#define SCB_ICSR_VECTACTIVE_Msk     0x1FFU
+#define SCB_ICSR_VECTPENDING_Pos    12U
+#define SCB_ICSR_VECTPENDING_Msk    (0x1FFU << SCB_ICSR_VECTPENDING_Pos)
+#define SCB_SCR_SLEEPDEEP_Pos       2U
+#define SCB_SCR_SLEEPDEEP_Msk       (1U << SCB_SCR_SLEEPDEEP_Pos)
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __I  uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct {
+    __IO uint32_t DHCSR;
+    __O  uint32_t DCRSR;
+    __IO uint32_t DCRDR;
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define CoreDebug_DEMCR_TRCENA_Msk  (1U << 24)
+
+/* CYCCNT counts host time at the target core clock */
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+    __IO uint32_t CPICNT;
+    __IO uint32_t EXCCNT;
+    __IO uint32_t SLEEPCNT;
+    __IO uint32_t LSUCNT;
+    __IO uint32_t FOLDCNT;
+    __I  uint32_t PCSR;
+} DWT_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1U << 0)
+
+/* ── Instances (sim_hal.c) ───────────────────── */
+extern CAN_TypeDef    Sim_CAN1;
+extern TIM_TypeDef    Sim_TIM1, Sim_TIM2, Sim_TIM3;
+extern USART_TypeDef  Sim_USART2;
+extern GPIO_TypeDef   Sim_GPIOA, Sim_GPIOB, Sim_GPIOC, Sim_GPIOH;
+extern FLASH_TypeDef  Sim_FLASH;
+extern SCB_Type       Sim_SCB;
+extern SysTick_Type   Sim_SysTick;
+extern CoreDebug_Type Sim_CoreDebug;
+
+DWT_Type *Sim_DWT(void);
+
+#define CAN1                    (&Sim_CAN1)
+#define TIM1                    (&Sim_TIM1)
+#define TIM2                    (&Sim_TIM2)
+#define TIM3                    (&Sim_TIM3)
+#define USART2                  (&Sim_USART2)
+#define GPIOA                   (&Sim_GPIOA)
+#define GPIOB                   (&Sim_GPIOB)
+#define GPIOC                   (&Sim_GPIOC)
+#define GPIOH                   (&Sim_GPIOH)
+#define FLASH                   (&Sim_FLASH)
+#define SCB                     (&Sim_SCB)
+#define SysTick                 (&Sim_SysTick)
+#define CoreDebug               (&Sim_CoreDebug)
+#define DWT                     (Sim_DWT())     /* Refreshes CYCCNT */
+
+/* ── Core Intrinsics (sim_core.c) ────────────── */
+uint32_t Sim_GetPrimask(void);
+void     Sim_SetPrimask(uint32_t mask);
+uint32_t Sim_GetIpsr(void);
+void     Sim_NvicSetPriority(IRQn_Type irq, uint32_t priority);
+void     Sim_NvicEnable(IRQn_Type irq, bool enable);
+
+__STATIC_INLINE void     __disable_irq(void)             { Sim_SetPrimask(1U); }
+__STATIC_INLINE void     __enable_irq(void)              { Sim_SetPrimask(0U); }
+__STATIC_INLINE uint32_t __get_PRIMASK(void)             { return Sim_GetPrimask(); }
+__STATIC_INLINE void     __set_PRIMASK(uint32_t priMask) { Sim_SetPrimask(priMask & 1U); }
+__STATIC_INLINE uint32_t __get_BASEPRI(void)             { return 0U; }
+__STATIC_INLINE uint32_t __get_IPSR(void)                { return Sim_GetIpsr(); }
+
+__STATIC_INLINE void __DMB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+__STATIC_INLINE void __DSB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+__STATIC_INLINE void __ISB(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+__STATIC_INLINE void __NOP(void) { }
+
+__STATIC_INLINE int32_t Sim_SSAT(int32_t val, uint32_t bits)
+{
+    const int32_t max = (int32_t)((1U << (bits - 1U)) - 1U);
+    const int32_t min = -max - 1;
+    return val > max ? max : val < min ? min : val;
+}
+
+__STATIC_INLINE uint32_t Sim_USAT(int32_t val, uint32_t bits)
+{
+    const int32_t max = (int32_t)((1U << bits) - 1U);
+    return val > max ? (uint32_t)max : val < 0 ? 0U : (uint32_t)val;
+}
+
+#define __SSAT(val, bits)       Sim_SSAT((int32_t)(val), (bits))
+#define __USAT(val, bits)       Sim_USAT((int32_t)(val), (bits))
+#define __CLZ(val)              ((val) == 0U ? 32U : (uint32_t)__builtin_clz(val))
+
+__STATIC_INLINE void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { Sim_NvicSetPriority(irq, priority); }
+__STATIC_INLINE void NVIC_EnableIRQ(IRQn_Type irq)  { Sim_NvicEnable(irq, true); }
+__STATIC_INLINE void NVIC_DisableIRQ(IRQn_Type irq) { Sim_NvicEnable(irq, false); }
+
+extern uint32_t SystemCoreClock;
+
+#endif /* SIM_STM32F4XX_H_ */
@@ -0,0 +1,513 @@
+/*
+ * stm32f4xx_hal.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Host stand-in for the STM32F4 HAL — the subset the nodes call:
+ *  core/tick, RCC/PWR/FLASH, NVIC, GPIO, UART, TIM and bxCAN. Types,
+ *  constants and signatures match the ST driver so the CubeMX-generated
+ *  main.c, MSP, stm32f4xx_it.c and timebase build unchanged. Behaviour
+ *  lives in sim_hal.c, sim_tim.c and sim_can.c.
+ */
+
+#ifndef SIM_STM32F4XX_HAL_H_
+#define SIM_STM32F4XX_HAL_H_
+
+#include "stm32f4xx.h"
+#include <stddef.h>
+
+/* ── HAL Definitions ─────────────────────────── */
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum { RESET = 0U, SET = !RESET } FlagStatus, ITStatus;
+typedef enum { DISABLE = 0U, ENABLE = !DISABLE } FunctionalState;
+
+#define HAL_MAX_DELAY           0xFFFFFFFFU
+#define UNUSED(X)               (void)(X)
+
+#ifndef __weak
+#define __weak                  __attribute__((weak))
+#endif
+#define __RAM_FUNC                              /* Nothing to relocate on a host */
+
+#define TICK_INT_PRIORITY       15U
+#define HSI_VALUE               16000000U
+
+/* ── HAL Core / Tick ─────────────────────────── */
+typedef enum {
+    HAL_TICK_FREQ_1KHZ          = 1U,
+    HAL_TICK_FREQ_DEFAULT       = HAL_TICK_FREQ_1KHZ
+} HAL_TickFreqTypeDef;
+
+extern __IO uint32_t        uwTick;
+extern uint32_t             uwTickPrio;
+extern HAL_TickFreqTypeDef  uwTickFreq;
+
+HAL_StatusTypeDef HAL_Init(void);
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority);
+void     HAL_MspInit(void);
+void     HAL_IncTick(void);
+uint32_t HAL_GetTick(void);
+void     HAL_Delay(uint32_t Delay);
+void     HAL_SuspendTick(void);
+void     HAL_ResumeTick(void);
+
+/* ── RCC / PWR / FLASH ───────────────────────── */
+typedef struct {
+    uint32_t PLLState;
+    uint32_t PLLSource;
+    uint32_t PLLM;
+    uint32_t PLLN;
+    uint32_t PLLP;
+    uint32_t PLLQ;
+    uint32_t PLLR;
+} RCC_PLLInitTypeDef;
+
+typedef struct {
+    uint32_t OscillatorType;
+    uint32_t HSEState;
+    uint32_t LSEState;
+    uint32_t HSIState;
+    uint32_t HSICalibrationValue;
+    uint32_t LSIState;
+    RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct {
+    uint32_t ClockType;
+    uint32_t SYSCLKSource;
+    uint32_t AHBCLKDivider;
+    uint32_t APB1CLKDivider;
+    uint32_t APB2CLKDivider;
+} RCC_ClkInitTypeDef;
+
+#define RCC_OSCILLATORTYPE_HSE      0x1U
+#define RCC_OSCILLATORTYPE_HSI      0x2U
+#define RCC_HSI_ON                  1U
+#define RCC_HSE_ON                  1U
+#define RCC_HSICALIBRATION_DEFAULT  0x10U
+#define RCC_PLL_NONE                0U
+#define RCC_PLL_OFF                 1U
+#define RCC_PLL_ON                  2U
+#define RCC_PLLSOURCE_HSI           0U
+#define RCC_PLLSOURCE_HSE           1U
+#define RCC_PLLP_DIV2               2U
+#define RCC_PLLP_DIV4               4U
+#define RCC_PLLP_DIV6               6U
+#define RCC_PLLP_DIV8               8U
+
+#define RCC_CLOCKTYPE_SYSCLK        0x1U
+#define RCC_CLOCKTYPE_HCLK          0x2U
+#define RCC_CLOCKTYPE_PCLK1         0x4U
+#define RCC_CLOCKTYPE_PCLK2         0x8U
+#define RCC_SYSCLKSOURCE_HSI        0U
+#define RCC_SYSCLKSOURCE_HSE        1U
+#define RCC_SYSCLKSOURCE_PLLCLK     2U
+
+/* Dividers carry their value — the real encodings are register fields */
+#define RCC_SYSCLK_DIV1             1U
+#define RCC_SYSCLK_DIV2             2U
+#define RCC_SYSCLK_DIV4             4U
+#define RCC_HCLK_DIV1               1U
+#define RCC_HCLK_DIV2               2U
+#define RCC_HCLK_DIV4               4U
+#define RCC_HCLK_DIV8               8U
+#define RCC_HCLK_DIV16              16U
+
+#define FLASH_LATENCY_0             0U
+#define FLASH_LATENCY_1             1U
+#define FLASH_LATENCY_2             2U
+#define FLASH_LATENCY_3             3U
+#define FLASH_LATENCY_4             4U
+#define FLASH_LATENCY_5             5U
+#define FLASH_LATENCY_6             6U
+#define FLASH_LATENCY_7             7U
+
+#define PWR_REGULATOR_VOLTAGE_SCALE1    1U
+
+/* Peripheral clocks are always on in the simulator */
+#define __HAL_RCC_SYSCFG_CLK_ENABLE()   do { } while (0)
+#define __HAL_RCC_PWR_CLK_ENABLE()      do { } while (0)
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_GPIOH_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_CAN1_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_TIM1_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_TIM2_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_TIM3_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_USART2_CLK_ENABLE()   do { } while (0)
+#define __HAL_RCC_CAN1_CLK_DISABLE()    do { } while (0)
+#define __HAL_RCC_TIM2_CLK_DISABLE()    do { } while (0)
+#define __HAL_RCC_TIM3_CLK_DISABLE()    do { } while (0)
+#define __HAL_RCC_USART2_CLK_DISABLE()  do { } while (0)
+#define __HAL_PWR_VOLTAGESCALING_CONFIG(scale)  UNUSED(scale)
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+void     HAL_RCC_GetClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t *pFLatency);
+uint32_t HAL_RCC_GetSysClockFreq(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+HAL_StatusTypeDef HAL_PWREx_EnableOverDrive(void);
+
+/* ── NVIC ────────────────────────────────────── */
+#define NVIC_PRIORITYGROUP_4        0x3U
+
+void HAL_NVIC_SetPriorityGrouping(uint32_t PriorityGroup);
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+
+/* ── GPIO ────────────────────────────────────── */
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+#define GPIO_PIN_0                  ((uint16_t)0x0001)
+#define GPIO_PIN_1                  ((uint16_t)0x0002)
+#define GPIO_PIN_2                  ((uint16_t)0x0004)
+#define GPIO_PIN_3                  ((uint16_t)0x0008)
+#define GPIO_PIN_4                  ((uint16_t)0x0010)
+#define GPIO_PIN_5                  ((uint16_t)0x0020)
+#define GPIO_PIN_6                  ((uint16_t)0x0040)
+#define GPIO_PIN_7                  ((uint16_t)0x0080)
+#define GPIO_PIN_8                  ((uint16_t)0x0100)
+#define GPIO_PIN_9                  ((uint16_t)0x0200)
+#define GPIO_PIN_10                 ((uint16_t)0x0400)
+#define GPIO_PIN_11                 ((uint16_t)0x0800)
+#define GPIO_PIN_12                 ((uint16_t)0x1000)
+#define GPIO_PIN_13                 ((uint16_t)0x2000)
+#define GPIO_PIN_14                 ((uint16_t)0x4000)
+#define GPIO_PIN_15                 ((uint16_t)0x8000)
+
+#define GPIO_MODE_INPUT             0x00000000U
+#define GPIO_MODE_OUTPUT_PP         0x00000001U
+#define GPIO_MODE_OUTPUT_OD         0x00000011U
+#define GPIO_MODE_AF_PP             0x00000002U
+#define GPIO_MODE_IT_RISING         0x10110000U
+#define GPIO_MODE_IT_FALLING        0x10210000U
+#define GPIO_NOPULL                 0U
+#define GPIO_PULLUP                 1U
+#define GPIO_PULLDOWN               2U
+#define GPIO_SPEED_FREQ_LOW         0U
+#define GPIO_SPEED_FREQ_VERY_HIGH   3U
+#define GPIO_AF7_USART2             0x07U
+#define GPIO_AF9_CAN1               0x09U
+
+void          HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void          HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void          HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void          HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+/* ── UART ────────────────────────────────────── */
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef enum {
+    HAL_UART_STATE_RESET        = 0x00U,
+    HAL_UART_STATE_READY        = 0x20U
+} HAL_UART_StateTypeDef;
+
+typedef struct {
+    USART_TypeDef                *Instance;
+    UART_InitTypeDef             Init;
+    __IO HAL_UART_StateTypeDef   gState;
+} UART_HandleTypeDef;
+
+#define UART_WORDLENGTH_8B          0U
+#define UART_STOPBITS_1             0U
+#define UART_PARITY_NONE            0U
+#define UART_MODE_TX_RX             0xCU
+#define UART_HWCONTROL_NONE         0U
+#define UART_OVERSAMPLING_16        0U
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+void HAL_UART_MspInit(UART_HandleTypeDef *huart);
+void HAL_UART_MspDeInit(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+
+/* ── TIM ─────────────────────────────────────── */
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    uint32_t OCMode;
+    uint32_t Pulse;
+    uint32_t OCPolarity;
+    uint32_t OCNPolarity;
+    uint32_t OCFastMode;
+    uint32_t OCIdleState;
+    uint32_t OCNIdleState;
+} TIM_OC_InitTypeDef;
+
+typedef enum {
+    HAL_TIM_STATE_RESET         = 0x00U,
+    HAL_TIM_STATE_READY         = 0x01U,
+    HAL_TIM_STATE_BUSY          = 0x02U
+} HAL_TIM_StateTypeDef;
+
+typedef enum {
+    HAL_TIM_ACTIVE_CHANNEL_1        = 0x01U,
+    HAL_TIM_ACTIVE_CHANNEL_2        = 0x02U,
+    HAL_TIM_ACTIVE_CHANNEL_3        = 0x04U,
+    HAL_TIM_ACTIVE_CHANNEL_4        = 0x08U,
+    HAL_TIM_ACTIVE_CHANNEL_CLEARED  = 0x00U
+} HAL_TIM_ActiveChannel;
+
+typedef struct {
+    TIM_TypeDef                 *Instance;
+    TIM_Base_InitTypeDef        Init;
+    HAL_TIM_ActiveChannel       Channel;
+    __IO HAL_TIM_StateTypeDef   State;
+} TIM_HandleTypeDef;
+
+#define TIM_COUNTERMODE_UP              0U
+#define TIM_CLOCKDIVISION_DIV1          0U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE  0U
+#define TIM_AUTORELOAD_PRELOAD_ENABLE   0x80U
+#define TIM_OCMODE_TIMING               0U
+#define TIM_OCPOLARITY_HIGH             0U
+#define TIM_OCFAST_DISABLE              0U
+
+#define TIM_CHANNEL_1                   0x0U
+#define TIM_CHANNEL_2                   0x4U
+#define TIM_CHANNEL_3                   0x8U
+#define TIM_CHANNEL_4                   0xCU
+
+#define TIM_IT_UPDATE                   TIM_DIER_UIE
+#define TIM_IT_CC1                      TIM_DIER_CC1IE
+#define TIM_IT_CC2                      TIM_DIER_CC2IE
+#define TIM_IT_CC3                      TIM_DIER_CC3IE
+#define TIM_IT_CC4                      TIM_DIER_CC4IE
+#define TIM_FLAG_UPDATE                 TIM_SR_UIF
+#define TIM_FLAG_CC1                    TIM_SR_CC1IF
+#define TIM_FLAG_CC2                    TIM_SR_CC2IF
+#define TIM_FLAG_CC3                    TIM_SR_CC3IF
+#define TIM_FLAG_CC4                    TIM_SR_CC4IF
+
+uint32_t Sim_TIM_GetCounter(TIM_TypeDef *tim);
+void     Sim_TIM_SetCounter(TIM_TypeDef *tim, uint32_t cnt);
+
+/* Status flags are rc_w0 on silicon — writing 1 leaves a bit alone,
+ * so clearing is an AND here rather than the HAL's plain store */
+#define __HAL_TIM_GET_COUNTER(h)            Sim_TIM_GetCounter((h)->Instance)
+#define __HAL_TIM_SET_COUNTER(h, cnt)       Sim_TIM_SetCounter((h)->Instance, (cnt))
+#define __HAL_TIM_SET_COMPARE(h, ch, cmp)   (*(__IO uint32_t *)(&((h)->Instance->CCR1) + ((ch) >> 2U)) = (cmp))
+#define __HAL_TIM_GET_COMPARE(h, ch)        (*(__IO uint32_t *)(&((h)->Instance->CCR1) + ((ch) >> 2U)))
+#define __HAL_TIM_GET_AUTORELOAD(h)         ((h)->Instance->ARR)
+#define __HAL_TIM_ENABLE_IT(h, it)          ((h)->Instance->DIER |= (it))
+#define __HAL_TIM_DISABLE_IT(h, it)         ((h)->Instance->DIER &= ~(it))
+#define __HAL_TIM_GET_FLAG(h, flag)         (((h)->Instance->SR & (flag)) == (flag))
+#define __HAL_TIM_CLEAR_FLAG(h, flag)       ((h)->Instance->SR &= ~(flag))
+#define __HAL_TIM_CLEAR_IT(h, it)           ((h)->Instance->SR &= ~(it))
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_OC_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel);
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef *htim);
+void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim);
+void HAL_TIM_OC_MspInit(TIM_HandleTypeDef *htim);
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim);
+
+/* ── bxCAN ───────────────────────────────────── */
+typedef enum {
+    HAL_CAN_STATE_RESET         = 0x00U,
+    HAL_CAN_STATE_READY         = 0x01U,
+    HAL_CAN_STATE_LISTENING     = 0x02U,
+    HAL_CAN_STATE_ERROR         = 0x05U
+} HAL_CAN_StateTypeDef;
+
+typedef struct {
+    uint32_t        Prescaler;
+    uint32_t        Mode;
+    uint32_t        SyncJumpWidth;
+    uint32_t        TimeSeg1;
+    uint32_t        TimeSeg2;
+    FunctionalState TimeTriggeredMode;
+    FunctionalState AutoBusOff;
+    FunctionalState AutoWakeUp;
+    FunctionalState AutoRetransmission;
+    FunctionalState ReceiveFifoLocked;
+    FunctionalState TransmitFifoPriority;
+} CAN_InitTypeDef;
+
+typedef struct {
+    uint32_t        FilterIdHigh;
+    uint32_t        FilterIdLow;
+    uint32_t        FilterMaskIdHigh;
+    uint32_t        FilterMaskIdLow;
+    uint32_t        FilterFIFOAssignment;
+    uint32_t        FilterBank;
+    uint32_t        FilterMode;
+    uint32_t        FilterScale;
+    uint32_t        FilterActivation;
+    uint32_t        SlaveStartFilterBank;
+} CAN_FilterTypeDef;
+
+typedef struct {
+    uint32_t        StdId;
+    uint32_t        ExtId;
+    uint32_t        IDE;
+    uint32_t        RTR;
+    uint32_t        DLC;
+    FunctionalState TransmitGlobalTime;
+} CAN_TxHeaderTypeDef;
+
+typedef struct {
+    uint32_t        StdId;
+    uint32_t        ExtId;
+    uint32_t        IDE;
+    uint32_t        RTR;
+    uint32_t        DLC;
+    uint32_t        Timestamp;
+    uint32_t        FilterMatchIndex;
+} CAN_RxHeaderTypeDef;
+
+typedef struct {
+    CAN_TypeDef                 *Instance;
+    CAN_InitTypeDef             Init;
+    __IO HAL_CAN_StateTypeDef   State;
+    __IO uint32_t               ErrorCode;
+} CAN_HandleTypeDef;
+
+#define HAL_CAN_ERROR_NONE          0x00000000U
+#define HAL_CAN_ERROR_RX_FOV0       0x00000200U
+#define HAL_CAN_ERROR_RX_FOV1       0x00000400U
+#define HAL_CAN_ERROR_TX_TERR0      0x00001000U
+#define HAL_CAN_ERROR_TX_TERR1      0x00004000U
+#define HAL_CAN_ERROR_TX_TERR2      0x00010000U
+#define HAL_CAN_ERROR_NOT_INITIALIZED 0x00100000U
+#define HAL_CAN_ERROR_NOT_READY     0x00200000U
+#define HAL_CAN_ERROR_NOT_STARTED   0x00400000U
+#define HAL_CAN_ERROR_PARAM         0x00800000U
+
+#define CAN_MODE_NORMAL             0x00000000U
+#define CAN_MODE_LOOPBACK           CAN_BTR_LBKM
+#define CAN_MODE_SILENT             CAN_BTR_SILM
+
+#define CAN_SJW_1TQ                 (0U << CAN_BTR_SJW_Pos)
+#define CAN_SJW_2TQ                 (1U << CAN_BTR_SJW_Pos)
+#define CAN_SJW_3TQ                 (2U << CAN_BTR_SJW_Pos)
+#define CAN_SJW_4TQ                 (3U << CAN_BTR_SJW_Pos)
+
+#define CAN_BS1_1TQ                 (0U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_2TQ                 (1U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_3TQ                 (2U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_4TQ                 (3U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_5TQ                 (4U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_6TQ                 (5U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_7TQ                 (6U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_8TQ                 (7U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_9TQ                 (8U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_10TQ                (9U  << CAN_BTR_TS1_Pos)
+#define CAN_BS1_11TQ                (10U << CAN_BTR_TS1_Pos)
+#define CAN_BS1_12TQ                (11U << CAN_BTR_TS1_Pos)
+#define CAN_BS1_13TQ                (12U << CAN_BTR_TS1_Pos)
+#define CAN_BS1_14TQ                (13U << CAN_BTR_TS1_Pos)
+#define CAN_BS1_15TQ                (14U << CAN_BTR_TS1_Pos)
+#define CAN_BS1_16TQ                (15U << CAN_BTR_TS1_Pos)
+
+#define CAN_BS2_1TQ                 (0U << CAN_BTR_TS2_Pos)
+#define CAN_BS2_2TQ                 (1U << CAN_BTR_TS2_Pos)
+#define CAN_BS2_3TQ                 (2U << CAN_BTR_TS2_Pos)
+#define CAN_BS2_4TQ                 (3U << CAN_BTR_TS2_Pos)
+#define CAN_BS2_5TQ                 (4U << CAN_BTR_TS2_Pos)
+#define CAN_BS2_6TQ                 (5U << CAN_BTR_TS2_Pos)
+#define CAN_BS2_7TQ                 (6U << CAN_BTR_TS2_Pos)
+#define CAN_BS2_8TQ                 (7U << CAN_BTR_TS2_Pos)
+
+#define CAN_ID_STD                  0x00000000U
+#define CAN_ID_EXT                  0x00000004U
+#define CAN_RTR_DATA                0x00000000U
+#define CAN_RTR_REMOTE              0x00000002U
+
+#define CAN_RX_FIFO0                0x00000000U
+#define CAN_RX_FIFO1                0x00000001U
+#define CAN_FILTER_FIFO0            0x00000000U
+#define CAN_FILTER_FIFO1            0x00000001U
+#define CAN_FILTERMODE_IDMASK       0x00000000U
+#define CAN_FILTERMODE_IDLIST       0x00000001U
+#define CAN_FILTERSCALE_16BIT       0x00000000U
+#define CAN_FILTERSCALE_32BIT       0x00000001U
+#define CAN_FILTER_DISABLE          0x00000000U
+#define CAN_FILTER_ENABLE           0x00000001U
+
+#define CAN_TX_MAILBOX0             0x00000001U
+#define CAN_TX_MAILBOX1             0x00000002U
+#define CAN_TX_MAILBOX2             0x00000004U
+
+#define CAN_IT_TX_MAILBOX_EMPTY     CAN_IER_TMEIE
+#define CAN_IT_RX_FIFO0_MSG_PENDING CAN_IER_FMPIE0
+#define CAN_IT_RX_FIFO0_FULL        CAN_IER_FFIE0
+#define CAN_IT_RX_FIFO0_OVERRUN     CAN_IER_FOVIE0
+#define CAN_IT_RX_FIFO1_MSG_PENDING CAN_IER_FMPIE1
+#define CAN_IT_RX_FIFO1_FULL        CAN_IER_FFIE1
+#define CAN_IT_RX_FIFO1_OVERRUN     CAN_IER_FOVIE1
+#define CAN_IT_ERROR                CAN_IER_ERRIE
+
+HAL_StatusTypeDef HAL_CAN_Init(CAN_HandleTypeDef *hcan);
+void HAL_CAN_MspInit(CAN_HandleTypeDef *hcan);
+void HAL_CAN_MspDeInit(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *sFilterConfig);
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_Stop(CAN_HandleTypeDef *hcan);
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader,
+                                       uint8_t aData[], uint32_t *pTxMailbox);
+HAL_StatusTypeDef HAL_CAN_AbortTxRequest(CAN_HandleTypeDef *hcan, uint32_t TxMailboxes);
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan);
+uint32_t HAL_CAN_IsTxMessagePending(CAN_HandleTypeDef *hcan, uint32_t TxMailboxes);
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo,
+                                       CAN_RxHeaderTypeDef *pHeader, uint8_t aData[]);
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo);
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs);
+HAL_StatusTypeDef HAL_CAN_DeactivateNotification(CAN_HandleTypeDef *hcan, uint32_t InactiveITs);
+uint32_t HAL_CAN_GetError(CAN_HandleTypeDef *hcan);
+void HAL_CAN_IRQHandler(CAN_HandleTypeDef *hcan);
+
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo0FullCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo1FullCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan);
+
+#endif /* SIM_STM32F4XX_HAL_H_ */
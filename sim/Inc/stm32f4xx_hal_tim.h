@@ -0,0 +1,16 @@
+/*
+ * stm32f4xx_hal_tim.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  The timebase includes the TIM driver header by name. Everything
+ *  is in the stand-in stm32f4xx_hal.h.
+ */
+
+#ifndef SIM_STM32F4XX_HAL_TIM_H_
+#define SIM_STM32F4XX_HAL_TIM_H_
+
+#include "stm32f4xx_hal.h"
+
+#endif /* SIM_STM32F4XX_HAL_TIM_H_ */
@@ -0,0 +1,276 @@
+/*
+ * sim_bus_socketcan.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#if defined(__linux__)
+
+#define _GNU_SOURCE                             /* recvmmsg, sendmmsg */
+#include "sim.h"
+#include <errno.h>
+#include <net/if.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+
+/* ── SocketCAN ───────────────────────────────── */
+/* The node on a Linux CAN interface — a real adapter, or vcan for
+ * testing next to can-utils. SIM_CAN_IF names it (vcan0 by default);
+ * its bitrate is the interface's, set with ip link, so frames carry
+ * none. The kernel filters with CAN_RAW_FILTER rules built from the
+ * node's own filter banks and stamps every frame on arrival
+ * (SO_TIMESTAMPING, software). Frames move in batches: recvmmsg on a
+ * receive thread, sendmmsg once per NVIC pass. The kernel queues a
+ * frame without waiting for its ACK, so send() only fails when the
+ * interface queue is full */
+#define SC_DEFAULT_IF       "vcan0"
+#define SC_BATCH            32U
+#define SC_MAX_RULES        (28U * 4U)      /* Every bank as four 16-bit list entries */
+
+static int          _sock = -1;
+static Sim_RxRing_t _ring;
+
+static struct can_frame _txFrame[SC_BATCH];
+static uint32_t         _txCount;
+
+static uint64_t Sc_Ns(const struct timespec *ts)
+{
+    return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+/* ─────────────────────────────────────────────────
+ * Sc_Rules — one filter bank rule as CAN_RAW_FILTER
+ * entries. A rule that leaves IDE open covers both
+ * frame formats and needs one entry for each
+ * ───────────────────────────────────────────────── */
+static uint32_t Sc_Rules(const Sim_CanFilter_t *rule, struct can_filter *out)
+{
+    uint32_t n = 0U;
+    canid_t  rtrId   = (rule->id & CAN_RI0R_RTR) != 0U ? CAN_RTR_FLAG : 0U;
+    canid_t  rtrMask = (rule->mask & CAN_RI0R_RTR) != 0U ? CAN_RTR_FLAG : 0U;
+    bool     ideSet  = (rule->mask & CAN_RI0R_IDE) != 0U;
+    bool     ide     = (rule->id & CAN_RI0R_IDE) != 0U;
+
+    if (rule->mask == 0U)
+    {
+        out[n++] = (struct can_filter){ .can_id = 0U, .can_mask = 0U };
+        return n;
+    }
+    if (!ideSet || !ide)
+    {
+        out[n++] = (struct can_filter){
+            .can_id   = ((rule->id >> 21) & CAN_SFF_MASK) | rtrId,
+            .can_mask = ((rule->mask >> 21) & CAN_SFF_MASK) | CAN_EFF_FLAG | rtrMask,
+        };
+    }
+    if (!ideSet || ide)
+    {
+        out[n++] = (struct can_filter){
+            .can_id   = ((rule->id >> 3) & CAN_EFF_MASK) | CAN_EFF_FLAG | rtrId,
+            .can_mask = ((rule->mask >> 3) & CAN_EFF_MASK) | CAN_EFF_FLAG | rtrMask,
+        };
+    }
+    return n;
+}
+
+/* No active bank means no rules, and the kernel passes nothing */
+static void Sc_Refilter(void)
+{
+    Sim_CanFilter_t   banks[SC_MAX_RULES];
+    struct can_filter rules[2U * SC_MAX_RULES];
+    uint32_t count = Sim_CAN_GetFilters(banks, SC_MAX_RULES);
+    uint32_t n = 0U;
+
+    if (_sock < 0) return;
+
+    for (uint32_t i = 0; i < count; i++) n += Sc_Rules(&banks[i], &rules[n]);
+
+    if (setsockopt(_sock, SOL_CAN_RAW, CAN_RAW_FILTER, n > 0U ? rules : NULL,
+                   (socklen_t)(n * sizeof(rules[0]))) < 0)
+    {
+        perror("sim: socketcan filter");
+    }
+}
+
+/* Software RX stamp, CLOCK_REALTIME; 0 if the kernel sent none */
+static uint64_t Sc_Timestamp(struct msghdr *msg)
+{
+    for (struct cmsghdr *c = CMSG_FIRSTHDR(msg); c != NULL; c = CMSG_NXTHDR(msg, c))
+    {
+        if (c->cmsg_level != SOL_SOCKET || c->cmsg_type != SCM_TIMESTAMPING) continue;
+
+        struct scm_timestamping ts;
+        memcpy(&ts, CMSG_DATA(c), sizeof(ts));
+        return Sc_Ns(&ts.ts[0]);
+    }
+    return 0U;
+}
+
+/* ─────────────────────────────────────────────────
+ * Sc_RxThread — up to SC_BATCH frames per system call.
+ * Kernel stamps are moved onto the Sim_NowNs() scale
+ * through one pair of clock readings per batch
+ * ───────────────────────────────────────────────── */
+static void *Sc_RxThread(void *arg)
+{
+    static struct can_frame frame[SC_BATCH];
+    static struct iovec     iov[SC_BATCH];
+    static struct mmsghdr   msg[SC_BATCH];
+    static union {
+        struct cmsghdr align;
+        uint8_t        buf[CMSG_SPACE(sizeof(struct scm_timestamping))];
+    } ctrl[SC_BATCH];
+
+    (void)arg;
+
+    for (;;)
+    {
+        for (uint32_t i = 0; i < SC_BATCH; i++)
+        {
+            iov[i] = (struct iovec){ .iov_base = &frame[i], .iov_len = sizeof(frame[i]) };
+            memset(&msg[i], 0, sizeof(msg[i]));
+            msg[i].msg_hdr.msg_iov        = &iov[i];
+            msg[i].msg_hdr.msg_iovlen     = 1;
+            msg[i].msg_hdr.msg_control    = ctrl[i].buf;
+            msg[i].msg_hdr.msg_controllen = sizeof(ctrl[i].buf);
+        }
+
+        int n = recvmmsg(_sock, msg, SC_BATCH, MSG_WAITFORONE, NULL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) break;
+
+        struct timespec real;
+        clock_gettime(CLOCK_REALTIME, &real);
+        uint64_t simNow  = Sim_NowNs();
+        uint64_t realNow = Sc_Ns(&real);
+
+        for (int i = 0; i < n; i++)
+        {
+            const struct can_frame *cf = &frame[i];
+            if (msg[i].msg_len != sizeof(*cf) || (cf->can_id & CAN_ERR_FLAG) != 0U) continue;
+
+            Sim_RxItem_t item;
+            memset(&item, 0, sizeof(item));
+            item.frame.ide = (cf->can_id & CAN_EFF_FLAG) != 0U;
+            item.frame.rtr = (cf->can_id & CAN_RTR_FLAG) != 0U;
+            item.frame.id  = cf->can_id & (item.frame.ide ? CAN_EFF_MASK : CAN_SFF_MASK);
+            item.frame.dlc = cf->len > 8U ? 8U : cf->len;
+            memcpy(item.frame.data, cf->data, sizeof(item.frame.data));
+
+            uint64_t stamp = Sc_Timestamp(&msg[i].msg_hdr);
+            item.timeNs = simNow;
+            if (stamp != 0U && stamp <= realNow && realNow - stamp <= simNow)
+                item.timeNs = simNow - (realNow - stamp);
+
+            Sim_RxRingPut(&_ring, &item);
+        }
+    }
+    return NULL;
+}
+
+static bool Sc_Open(void)
+{
+    const char *ifname = getenv("SIM_CAN_IF");
+    int stamping = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    struct sockaddr_can addr;
+
+    if (ifname == NULL) ifname = SC_DEFAULT_IF;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family  = AF_CAN;
+    addr.can_ifindex = (int)if_nametoindex(ifname);
+
+    _sock = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (_sock < 0 || addr.can_ifindex == 0 ||
+        setsockopt(_sock, SOL_SOCKET, SO_TIMESTAMPING, &stamping, sizeof(stamping)) < 0)
+    {
+        fprintf(stderr, "sim: socketcan %s: %s\n", ifname, strerror(errno));
+        if (_sock >= 0) close(_sock);
+        _sock = -1;
+        return false;
+    }
+
+    /* Filters before bind, so nothing unfiltered is queued */
+    Sc_Refilter();
+
+    if (bind(_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        fprintf(stderr, "sim: socketcan %s: %s\n", ifname, strerror(errno));
+        close(_sock);
+        _sock = -1;
+        return false;
+    }
+    return Sim_StartThread(Sc_RxThread);
+}
+
+/* Whatever the queue does not take now stays for the next pass */
+static void Sc_Flush(void)
+{
+    struct mmsghdr msg[SC_BATCH];
+    struct iovec   iov[SC_BATCH];
+    uint32_t sent = 0U;
+
+    memset(msg, 0, sizeof(msg));
+    for (uint32_t i = 0; i < _txCount; i++)
+    {
+        iov[i] = (struct iovec){ .iov_base = &_txFrame[i], .iov_len = sizeof(_txFrame[i]) };
+        msg[i].msg_hdr.msg_iov    = &iov[i];
+        msg[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (sent < _txCount)
+    {
+        int n = sendmmsg(_sock, &msg[sent], _txCount - sent, MSG_DONTWAIT);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;                          /* ENOBUFS, EAGAIN */
+        sent += (uint32_t)n;
+    }
+
+    _txCount -= sent;
+    memmove(&_txFrame[0], &_txFrame[sent], _txCount * sizeof(_txFrame[0]));
+}
+
+static bool Sc_Send(const Sim_CanFrame_t *frame, uint32_t bitrate, uint64_t timeNs)
+{
+    if (_txCount == SC_BATCH) Sc_Flush();
+    if (_txCount == SC_BATCH) return false;
+
+    struct can_frame *cf = &_txFrame[_txCount++];
+    memset(cf, 0, sizeof(*cf));
+    cf->can_id = frame->id | (frame->ide ? CAN_EFF_FLAG : 0U) | (frame->rtr ? CAN_RTR_FLAG : 0U);
+    cf->len    = frame->dlc > 8U ? 8U : frame->dlc;
+    memcpy(cf->data, frame->data, sizeof(cf->data));
+    return true;
+}
+
+static bool Sc_Poll(Sim_CanFrame_t *frame, uint32_t *bitrate, uint64_t *timeNs)
+{
+    Sim_RxItem_t item;
+    if (!Sim_RxRingGet(&_ring, &item)) return false;
+
+    *frame   = item.frame;
+    *bitrate = item.bitrate;
+    *timeNs  = item.timeNs;
+    return true;
+}
+
+const Sim_CanBus_t Sim_CanBusSocketCan = {
+    .name     = "socketcan",
+    .open     = Sc_Open,
+    .send     = Sc_Send,
+    .poll     = Sc_Poll,
+    .flush    = Sc_Flush,
+    .refilter = Sc_Refilter,
+};
+
+#endif /* __linux__ */
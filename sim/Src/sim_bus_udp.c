@@ -0,0 +1,160 @@
+/*
+ * sim_bus_udp.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "sim.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* ── UDP Multicast Bus ───────────────────────── */
+/* Every node process joins one multicast group on the loopback
+ * interface; a frame is one datagram and every member sees it.
+ * Frames carry the sender's bitrate so a receiver on another rate
+ * can treat them as bus errors. There is no arbitration and no
+ * real ACK: a send always succeeds. SIM_BUS_GROUP and SIM_BUS_PORT
+ * select the group, so several independent busses can run side by
+ * side */
+#define UDP_DEFAULT_GROUP   "239.255.43.21"
+#define UDP_DEFAULT_PORT    47000
+#define UDP_MAGIC           0x4E414353U     /* "SCAN" */
+#define UDP_ID_IDE          (1U << 31)
+#define UDP_ID_RTR          (1U << 30)
+#define UDP_DATAGRAM_LEN    25U
+
+static int                _sock = -1;
+static struct sockaddr_in _group;
+static uint32_t           _sender;
+static Sim_RxRing_t       _ring;
+
+static void Udp_Put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t Udp_Get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/* ─────────────────────────────────────────────────
+ * Udp_RxThread — a plain pthread, not a task, so it can
+ * block in recv(). Frames are stamped on arrival
+ * ───────────────────────────────────────────────── */
+static void *Udp_RxThread(void *arg)
+{
+    uint8_t buf[64];
+    (void)arg;
+
+    for (;;)
+    {
+        ssize_t n = recv(_sock, buf, sizeof(buf), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) break;
+        if ((size_t)n != UDP_DATAGRAM_LEN || Udp_Get32(&buf[0]) != UDP_MAGIC) continue;
+        if (Udp_Get32(&buf[4]) == _sender) continue;        /* Our own, looped back */
+
+        Sim_RxItem_t item;
+        uint32_t id = Udp_Get32(&buf[12]);
+
+        item.timeNs    = Sim_NowNs();
+        item.bitrate   = Udp_Get32(&buf[8]);
+        item.frame.ide = (id & UDP_ID_IDE) != 0U;
+        item.frame.rtr = (id & UDP_ID_RTR) != 0U;
+        item.frame.id  = id & 0x1FFFFFFFU;
+        item.frame.dlc = buf[16] > 8U ? 8U : buf[16];
+        memcpy(item.frame.data, &buf[17], 8);
+
+        Sim_RxRingPut(&_ring, &item);
+    }
+    return NULL;
+}
+
+static bool Udp_Open(void)
+{
+    const char *group = getenv("SIM_BUS_GROUP");
+    const char *port  = getenv("SIM_BUS_PORT");
+    int one = 1;
+    unsigned char loop = 1, ttl = 0;
+    struct in_addr lo = { .s_addr = htonl(INADDR_LOOPBACK) };
+
+    memset(&_group, 0, sizeof(_group));
+    _group.sin_family = AF_INET;
+    _group.sin_port   = htons(port != NULL ? (uint16_t)atoi(port) : UDP_DEFAULT_PORT);
+    if (inet_pton(AF_INET, group != NULL ? group : UDP_DEFAULT_GROUP, &_group.sin_addr) != 1)
+        return false;
+
+    _sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (_sock < 0) return false;
+
+    struct sockaddr_in local = _group;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    struct ip_mreq mreq = { .imr_multiaddr = _group.sin_addr, .imr_interface = lo };
+
+    if (setsockopt(_sock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) < 0 ||
+        setsockopt(_sock, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0 ||
+        bind(_sock, (struct sockaddr *)&local, sizeof(local)) < 0 ||
+        setsockopt(_sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0 ||
+        setsockopt(_sock, IPPROTO_IP, IP_MULTICAST_IF, &lo, sizeof(lo)) < 0 ||
+        setsockopt(_sock, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0 ||
+        setsockopt(_sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0)
+    {
+        perror("sim: udp bus");
+        close(_sock);
+        _sock = -1;
+        return false;
+    }
+
+    _sender = (uint32_t)getpid() ^ ((uint32_t)Sim_NowNs() << 16);
+    return Sim_StartThread(Udp_RxThread);
+}
+
+static bool Udp_Send(const Sim_CanFrame_t *frame, uint32_t bitrate, uint64_t timeNs)
+{
+    uint8_t buf[UDP_DATAGRAM_LEN];
+    uint32_t id = frame->id | (frame->ide ? UDP_ID_IDE : 0U) | (frame->rtr ? UDP_ID_RTR : 0U);
+
+    Udp_Put32(&buf[0], UDP_MAGIC);
+    Udp_Put32(&buf[4], _sender);
+    Udp_Put32(&buf[8], bitrate);
+    Udp_Put32(&buf[12], id);
+    buf[16] = frame->dlc;
+    memcpy(&buf[17], frame->data, 8);
+
+    while (sendto(_sock, buf, sizeof(buf), 0, (struct sockaddr *)&_group, sizeof(_group)) < 0)
+    {
+        if (errno != EINTR) break;
+    }
+    return true;
+}
+
+static bool Udp_Poll(Sim_CanFrame_t *frame, uint32_t *bitrate, uint64_t *timeNs)
+{
+    Sim_RxItem_t item;
+    if (!Sim_RxRingGet(&_ring, &item)) return false;
+
+    *frame   = item.frame;
+    *bitrate = item.bitrate;
+    *timeNs  = item.timeNs;
+    return true;
+}
+
+const Sim_CanBus_t Sim_CanBusUdp = {
+    .name = "udp",
+    .open = Udp_Open,
+    .send = Udp_Send,
+    .poll = Udp_Poll,
+};
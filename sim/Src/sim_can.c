@@ -0,0 +1,794 @@
+/*
+ * sim_can.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "stm32f4xx_hal.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── bxCAN Model ─────────────────────────────── */
+/* Three TX mailboxes, two three-deep RX FIFOs and 28 filter banks,
+ * with the flag and interrupt behaviour of RM0390 §30. A mailbox
+ * wins the (local) bus by identifier, or request order with TXFP,
+ * holds it for the stuffed frame time at the BTR bitrate, and is
+ * then handed to the bus backend; its ACK decides TXOK or TERR.
+ * Received frames whose bitrate differs from ours are the error
+ * frames a real node would see and only raise REC */
+#define TX_MAILBOXES        3U
+#define RX_FIFO_DEPTH       3U
+#define FILTER_BANKS        28U
+
+#define CAN_TSR_RQCP(mb)    (CAN_TSR_RQCP0 << (8U * (mb)))
+#define CAN_TSR_TXOK(mb)    (CAN_TSR_TXOK0 << (8U * (mb)))
+#define CAN_TSR_ALST(mb)    (CAN_TSR_ALST0 << (8U * (mb)))
+#define CAN_TSR_TERR(mb)    (CAN_TSR_TERR0 << (8U * (mb)))
+#define CAN_TSR_TMEx(mb)    (CAN_TSR_TME0 << (mb))
+#define CAN_TSR_DONE(mb)    (CAN_TSR_RQCP(mb) | CAN_TSR_TXOK(mb) | CAN_TSR_ALST(mb) | CAN_TSR_TERR(mb))
+
+#define NO_MAILBOX          0xFFU
+
+typedef struct {
+    CAN_FIFOMailBox_TypeDef slot[RX_FIFO_DEPTH];
+    uint8_t                 count;
+} Sim_RxFifo_t;
+
+static const Sim_CanBus_t *_bus;
+static bool                _busOpened;
+
+static uint32_t     _txSeq;
+static uint32_t     _txOrder[TX_MAILBOXES];     /* Request order, for TXFP */
+static uint8_t      _txActive = NO_MAILBOX;     /* Mailbox holding the bus */
+static uint64_t     _txEndNs;
+static Sim_RxFifo_t _rx[2];
+static uint32_t     _rxRead;                    /* Frames released, both FIFOs */
+static uint32_t     _rxFiltered;                /* Frames no bank accepted */
+
+/* Backends a node can be pointed at with SIM_CAN_BUS */
+static const Sim_CanBus_t *const _busses[] = {
+    &Sim_CanBusUdp,
+#if defined(__linux__)
+    &Sim_CanBusSocketCan,
+#endif
+};
+
+/* ─────────────────────────────────────────────────
+ * Bit timing — the bitrate the BTR currently encodes
+ * ───────────────────────────────────────────────── */
+static uint32_t Sim_CAN_Bitrate(void)
+{
+    uint32_t btr = CAN1->BTR;
+    uint32_t brp = ((btr & CAN_BTR_BRP) >> CAN_BTR_BRP_Pos) + 1U;
+    uint32_t ntq = 1U + ((btr & CAN_BTR_TS1) >> CAN_BTR_TS1_Pos) + 1U
+                      + ((btr & CAN_BTR_TS2) >> CAN_BTR_TS2_Pos) + 1U;
+
+    return HAL_RCC_GetPCLK1Freq() / (brp * ntq);
+}
+
+/* ── Register <-> Frame ──────────────────────── */
+static void Sim_CAN_FromMailbox(const CAN_TxMailBox_TypeDef *mb, Sim_CanFrame_t *f)
+{
+    uint32_t tir = mb->TIR;
+
+    f->ide = (tir & CAN_TI0R_IDE) != 0U;
+    f->rtr = (tir & CAN_TI0R_RTR) != 0U;
+    f->id  = f->ide ? (tir & (CAN_TI0R_STID | CAN_TI0R_EXID)) >> CAN_TI0R_EXID_Pos
+                    : (tir & CAN_TI0R_STID) >> CAN_TI0R_STID_Pos;
+    f->dlc = (uint8_t)(mb->TDTR & CAN_TDT0R_DLC);
+
+    uint32_t lo = mb->TDLR, hi = mb->TDHR;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        f->data[i]     = (uint8_t)(lo >> (8U * i));
+        f->data[i + 4] = (uint8_t)(hi >> (8U * i));
+    }
+}
+
+/* Identifier in the RIR / 32-bit filter layout */
+static uint32_t Sim_CAN_Rir(const Sim_CanFrame_t *f)
+{
+    uint32_t rir = f->ide ? (f->id << CAN_RI0R_EXID_Pos) | CAN_RI0R_IDE
+                          : f->id << CAN_RI0R_STID_Pos;
+    return rir | (f->rtr ? CAN_RI0R_RTR : 0U);
+}
+
+/* Identifier in the 16-bit filter layout: STID[15:5] RTR IDE EXID[17:15] */
+static uint32_t Sim_CAN_Filter16(uint32_t rir)
+{
+    return ((rir >> 16) & 0xFFE0U) | ((rir & CAN_RI0R_RTR) << 3) | ((rir & CAN_RI0R_IDE) << 1)
+         | ((rir >> 18) & 0x7U);
+}
+
+/* ─────────────────────────────────────────────────
+ * Sim_CAN_Filter — first matching bank wins. FMI counts
+ * the filters of every bank assigned to the FIFO, active
+ * or not, in bank order (RM0390 §30.7.4)
+ * ───────────────────────────────────────────────── */
+static bool Sim_CAN_Filter(uint32_t rir, uint32_t *fifo, uint32_t *fmi)
+{
+    uint32_t index[2] = { 0U, 0U };
+
+    for (uint32_t bank = 0; bank < FILTER_BANKS; bank++)
+    {
+        uint32_t bit    = 1U << bank;
+        uint32_t f      = (CAN1->FFA1R & bit) != 0U ? 1U : 0U;
+        bool     list   = (CAN1->FM1R & bit) != 0U;
+        bool     wide   = (CAN1->FS1R & bit) != 0U;
+        uint32_t fr1    = CAN1->sFilterRegister[bank].FR1;
+        uint32_t fr2    = CAN1->sFilterRegister[bank].FR2;
+        uint32_t count  = wide ? (list ? 2U : 1U) : (list ? 4U : 2U);
+        int32_t  hit    = -1;
+
+        if ((CAN1->FA1R & bit) != 0U)
+        {
+            uint32_t id32 = rir & ~1U;
+            uint32_t id16 = Sim_CAN_Filter16(rir);
+
+            if (wide && !list)
+            {
+                if (((id32 ^ fr1) & fr2) == 0U) hit = 0;
+            }
+            else if (wide)
+            {
+                if (id32 == (fr1 & ~1U))      hit = 0;
+                else if (id32 == (fr2 & ~1U)) hit = 1;
+            }
+            else if (!list)
+            {
+                if (((id16 ^ fr1) & (fr1 >> 16) & 0xFFFFU) == 0U)      hit = 0;
+                else if (((id16 ^ fr2) & (fr2 >> 16) & 0xFFFFU) == 0U) hit = 1;
+            }
+            else
+            {
+                const uint32_t ids[4] = { fr1 & 0xFFFFU, fr1 >> 16, fr2 & 0xFFFFU, fr2 >> 16 };
+                for (uint32_t i = 0; i < 4 && hit < 0; i++)
+                {
+                    if (id16 == ids[i]) hit = (int32_t)i;
+                }
+            }
+        }
+
+        if (hit >= 0)
+        {
+            *fifo = f;
+            *fmi  = index[f] + (uint32_t)hit;
+            return true;
+        }
+        index[f] += count;
+    }
+    return false;
+}
+
+/* ─────────────────────────────────────────────────
+ * RX FIFOs — the head is mirrored into sFIFOMailBox so
+ * the node's direct RIR peek sees what the HAL will read
+ * ───────────────────────────────────────────────── */
+static __IO uint32_t *Sim_CAN_Rfr(uint32_t fifo)
+{
+    return fifo == 0U ? &CAN1->RF0R : &CAN1->RF1R;
+}
+
+static void Sim_CAN_RxMirror(uint32_t fifo)
+{
+    Sim_RxFifo_t *q = &_rx[fifo];
+    __IO uint32_t *rfr = Sim_CAN_Rfr(fifo);
+
+    *rfr = (*rfr & ~CAN_RF0R_FMP0) | q->count;
+    if (q->count > 0U) CAN1->sFIFOMailBox[fifo] = q->slot[0];
+    else               memset((void *)&CAN1->sFIFOMailBox[fifo], 0, sizeof(CAN1->sFIFOMailBox[fifo]));
+}
+
+static void Sim_CAN_RxPush(const Sim_CanFrame_t *f, uint32_t bitrate, uint64_t timeNs)
+{
+    uint32_t rir = Sim_CAN_Rir(f);
+    uint32_t fifo, fmi;
+
+    if (!Sim_CAN_Filter(rir, &fifo, &fmi))
+    {
+        _rxFiltered++;
+        return;
+    }
+
+    Sim_RxFifo_t *q = &_rx[fifo];
+    __IO uint32_t *rfr = Sim_CAN_Rfr(fifo);
+    CAN_FIFOMailBox_TypeDef *slot;
+
+    if (q->count == RX_FIFO_DEPTH)
+    {
+        *rfr |= CAN_RF0R_FOVR0;
+        if ((CAN1->MCR & CAN_MCR_RFLM) != 0U) return;   /* Locked: the new frame is lost */
+        slot = &q->slot[RX_FIFO_DEPTH - 1U];            /* Otherwise it replaces the newest */
+    }
+    else
+    {
+        slot = &q->slot[q->count++];
+    }
+
+    uint32_t time = (uint32_t)((unsigned __int128)timeNs * bitrate / 1000000000ULL) & 0xFFFFU;
+
+    slot->RIR  = rir;
+    slot->RDTR = (time << CAN_RDT0R_TIME_Pos) | (fmi << CAN_RDT0R_FMI_Pos) | (f->dlc & CAN_RDT0R_DLC);
+    slot->RDLR = (uint32_t)f->data[0] | (uint32_t)f->data[1] << 8 |
+                 (uint32_t)f->data[2] << 16 | (uint32_t)f->data[3] << 24;
+    slot->RDHR = (uint32_t)f->data[4] | (uint32_t)f->data[5] << 8 |
+                 (uint32_t)f->data[6] << 16 | (uint32_t)f->data[7] << 24;
+
+    if (q->count == RX_FIFO_DEPTH) *rfr |= CAN_RF0R_FULL0;
+    Sim_CAN_RxMirror(fifo);
+}
+
+static void Sim_CAN_RxRelease(uint32_t fifo)
+{
+    Sim_RxFifo_t *q = &_rx[fifo];
+
+    if (q->count == 0U) return;
+    memmove(&q->slot[0], &q->slot[1], (size_t)(q->count - 1U) * sizeof(q->slot[0]));
+    q->count--;
+    _rxRead++;
+    *Sim_CAN_Rfr(fifo) &= ~CAN_RF0R_FULL0;
+    Sim_CAN_RxMirror(fifo);
+}
+
+uint32_t Sim_CAN_RxRead(void)
+{
+    return _rxRead;
+}
+
+uint32_t Sim_CAN_RxFiltered(void)
+{
+    return _rxFiltered;
+}
+
+static void Sim_CAN_ErrorCount(uint32_t pos, uint32_t add)
+{
+    uint32_t n = ((CAN1->ESR >> pos) & 0xFFU) + add;
+    if (n > 255U) n = 255U;
+    CAN1->ESR = (CAN1->ESR & ~(0xFFU << pos)) | (n << pos);
+}
+
+/* ─────────────────────────────────────────────────
+ * TX — the pending mailbox that would win arbitration
+ * ───────────────────────────────────────────────── */
+static uint8_t Sim_CAN_TxNext(void)
+{
+    uint8_t best = NO_MAILBOX;
+
+    for (uint8_t mb = 0; mb < TX_MAILBOXES; mb++)
+    {
+        if ((CAN1->sTxMailBox[mb].TIR & CAN_TI0R_TXRQ) == 0U) continue;
+        if (best == NO_MAILBOX) { best = mb; continue; }
+
+        bool earlier = (CAN1->MCR & CAN_MCR_TXFP) != 0U
+                     ? (int32_t)(_txOrder[mb] - _txOrder[best]) < 0
+                     : (CAN1->sTxMailBox[mb].TIR >> 1) < (CAN1->sTxMailBox[best].TIR >> 1);
+        if (earlier) best = mb;
+    }
+    return best;
+}
+
+static void Sim_CAN_TxStart(uint64_t atNs)
+{
+    if (_txActive != NO_MAILBOX || (CAN1->MCR & CAN_MCR_INRQ) != 0U) return;
+
+    uint8_t mb = Sim_CAN_TxNext();
+    if (mb == NO_MAILBOX) return;
+
+    Sim_CanFrame_t f;
+    Sim_CAN_FromMailbox(&CAN1->sTxMailBox[mb], &f);
+
+    _txActive = mb;
+    _txEndNs  = atNs + (uint64_t)VCAN_FrameBits(&f, NULL) * 1000000000ULL / Sim_CAN_Bitrate();
+}
+
+static void Sim_CAN_TxComplete(void)
+{
+    uint8_t mb = _txActive;
+    Sim_CanFrame_t f;
+    uint32_t bitrate = Sim_CAN_Bitrate();
+    bool ack = true;
+
+    _txActive = NO_MAILBOX;
+    Sim_CAN_FromMailbox(&CAN1->sTxMailBox[mb], &f);
+
+    if ((CAN1->BTR & CAN_BTR_SILM) == 0U && _bus != NULL)
+        ack = _bus->send(&f, bitrate, _txEndNs);
+    if ((CAN1->BTR & CAN_BTR_LBKM) != 0U)
+        Sim_CAN_RxPush(&f, bitrate, _txEndNs);
+
+    if (ack)
+    {
+        uint32_t tec = (CAN1->ESR >> CAN_ESR_TEC_Pos) & 0xFFU;
+        CAN1->ESR = (CAN1->ESR & ~(0xFFU << CAN_ESR_TEC_Pos)) | ((tec > 0U ? tec - 1U : 0U) << CAN_ESR_TEC_Pos);
+        CAN1->sTxMailBox[mb].TIR &= ~CAN_TI0R_TXRQ;
+        CAN1->TSR |= CAN_TSR_RQCP(mb) | CAN_TSR_TXOK(mb) | CAN_TSR_TMEx(mb);
+        return;
+    }
+
+    /* No ACK: an error frame, then retry unless NART */
+    Sim_CAN_ErrorCount(CAN_ESR_TEC_Pos, 8U);
+    if ((CAN1->MCR & CAN_MCR_NART) != 0U)
+    {
+        CAN1->sTxMailBox[mb].TIR &= ~CAN_TI0R_TXRQ;
+        CAN1->TSR |= CAN_TSR_RQCP(mb) | CAN_TSR_TERR(mb) | CAN_TSR_TMEx(mb);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Sim_CAN_Poll — from the NVIC task: finish every frame
+ * whose time on the bus has passed, then take in the
+ * next frame another node sent. One per call, so the
+ * RX handler can run between frames as on the chip;
+ * true if there may be more
+ * ───────────────────────────────────────────────── */
+bool Sim_CAN_Poll(void)
+{
+    uint64_t now = Sim_NowNs();
+
+    while (_txActive != NO_MAILBOX && _txEndNs <= now)
+    {
+        uint64_t end = _txEndNs;
+        Sim_CAN_TxComplete();
+        Sim_CAN_TxStart(end);
+    }
+    Sim_CAN_TxStart(now);
+
+    if (_bus == NULL) return false;
+    if (_bus->flush != NULL) _bus->flush();
+
+    Sim_CanFrame_t f;
+    uint32_t bitrate;
+    uint64_t timeNs;
+
+    if (!_bus->poll(&f, &bitrate, &timeNs)) return false;
+    if ((CAN1->MCR & CAN_MCR_INRQ) != 0U || (CAN1->BTR & CAN_BTR_LBKM) != 0U) return true;
+
+    /* 0: a medium with a single bitrate, which is ours */
+    if (bitrate == 0U) bitrate = Sim_CAN_Bitrate();
+
+    if (bitrate != Sim_CAN_Bitrate())
+    {
+        Sim_CAN_ErrorCount(CAN_ESR_REC_Pos, 1U);
+        return true;
+    }
+    Sim_CAN_RxPush(&f, bitrate, timeNs);
+    return true;
+}
+
+/* ─────────────────────────────────────────────────
+ * Sim_CAN_GetFilters — the active banks as RIR-layout
+ * id/mask rules, for backends that filter before us.
+ * List entries become exact-match rules
+ * ───────────────────────────────────────────────── */
+static uint32_t Sim_CAN_Widen16(uint32_t f16)
+{
+    return ((f16 & 0xFFE0U) << 16) | ((f16 & 0x7U) << 18) |
+           ((f16 >> 3) & CAN_RI0R_RTR) | ((f16 >> 1) & CAN_RI0R_IDE);
+}
+
+uint32_t Sim_CAN_GetFilters(Sim_CanFilter_t *out, uint32_t max)
+{
+    uint32_t n = 0U;
+
+    for (uint32_t bank = 0; bank < FILTER_BANKS; bank++)
+    {
+        uint32_t bit  = 1U << bank;
+        bool     list = (CAN1->FM1R & bit) != 0U;
+        uint32_t fr1  = CAN1->sFilterRegister[bank].FR1;
+        uint32_t fr2  = CAN1->sFilterRegister[bank].FR2;
+        Sim_CanFilter_t rule[4];
+        uint32_t count;
+
+        if ((CAN1->FA1R & bit) == 0U) continue;
+
+        if ((CAN1->FS1R & bit) != 0U)
+        {
+            if (list)
+            {
+                rule[0] = (Sim_CanFilter_t){ fr1, ~1U };
+                rule[1] = (Sim_CanFilter_t){ fr2, ~1U };
+                count = 2U;
+            }
+            else
+            {
+                rule[0] = (Sim_CanFilter_t){ fr1, fr2 & ~1U };
+                count = 1U;
+            }
+        }
+        else
+        {
+            const uint32_t full16 = Sim_CAN_Widen16(0xFFFFU);
+            if (list)
+            {
+                rule[0] = (Sim_CanFilter_t){ Sim_CAN_Widen16(fr1 & 0xFFFFU), full16 };
+                rule[1] = (Sim_CanFilter_t){ Sim_CAN_Widen16(fr1 >> 16),     full16 };
+                rule[2] = (Sim_CanFilter_t){ Sim_CAN_Widen16(fr2 & 0xFFFFU), full16 };
+                rule[3] = (Sim_CanFilter_t){ Sim_CAN_Widen16(fr2 >> 16),     full16 };
+                count = 4U;
+            }
+            else
+            {
+                rule[0] = (Sim_CanFilter_t){ Sim_CAN_Widen16(fr1 & 0xFFFFU), Sim_CAN_Widen16(fr1 >> 16) };
+                rule[1] = (Sim_CanFilter_t){ Sim_CAN_Widen16(fr2 & 0xFFFFU), Sim_CAN_Widen16(fr2 >> 16) };
+                count = 2U;
+            }
+        }
+
+        for (uint32_t i = 0; i < count && n < max; i++) out[n++] = rule[i];
+    }
+    return n;
+}
+
+bool Sim_CAN_TxIrqPending(void)
+{
+    return (CAN1->IER & CAN_IER_TMEIE) != 0U &&
+           (CAN1->TSR & (CAN_TSR_RQCP0 | CAN_TSR_RQCP1 | CAN_TSR_RQCP2)) != 0U;
+}
+
+static bool Sim_CAN_RxIrqPending(uint32_t fifo)
+{
+    uint32_t rfr = *Sim_CAN_Rfr(fifo);
+    uint32_t ier = CAN1->IER >> (3U * fifo);
+
+    return ((ier & CAN_IER_FMPIE0) != 0U && (rfr & CAN_RF0R_FMP0) != 0U) ||
+           ((ier & CAN_IER_FFIE0)  != 0U && (rfr & CAN_RF0R_FULL0) != 0U) ||
+           ((ier & CAN_IER_FOVIE0) != 0U && (rfr & CAN_RF0R_FOVR0) != 0U);
+}
+
+bool Sim_CAN_Rx0IrqPending(void) { return Sim_CAN_RxIrqPending(0U); }
+bool Sim_CAN_Rx1IrqPending(void) { return Sim_CAN_RxIrqPending(1U); }
+
+/* ─────────────────────────────────────────────────
+ * Sim_CAN_OpenBus — SIM_CAN_BUS names the backend,
+ * the first one is the default. A node whose bus fails
+ * to open keeps running with nobody to talk to
+ * ───────────────────────────────────────────────── */
+static void Sim_CAN_OpenBus(void)
+{
+    const char *name = getenv("SIM_CAN_BUS");
+
+    _busOpened = true;
+    _bus       = _busses[0];
+
+    if (&Sim_CanBusPerf != NULL)
+    {
+        _bus = &Sim_CanBusPerf;
+    }
+    else if (name != NULL)
+    {
+        _bus = NULL;
+        for (uint32_t i = 0; i < sizeof(_busses) / sizeof(_busses[0]); i++)
+        {
+            if (strcmp(_busses[i]->name, name) == 0) _bus = _busses[i];
+        }
+        if (_bus == NULL) fprintf(stderr, "sim: unknown SIM_CAN_BUS '%s'\n", name);
+    }
+
+    if (_bus != NULL && !_bus->open())
+    {
+        fprintf(stderr, "sim: CAN bus '%s' failed to open, running without a bus\n", _bus->name);
+        _bus = NULL;
+    }
+}
+
+/* ── HAL CAN ─────────────────────────────────── */
+__weak void HAL_CAN_MspInit(CAN_HandleTypeDef *hcan)                    { UNUSED(hcan); }
+__weak void HAL_CAN_MspDeInit(CAN_HandleTypeDef *hcan)                  { UNUSED(hcan); }
+__weak void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan) { UNUSED(hcan); }
+__weak void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan) { UNUSED(hcan); }
+__weak void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan) { UNUSED(hcan); }
+__weak void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan)    { UNUSED(hcan); }
+__weak void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan)    { UNUSED(hcan); }
+__weak void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan)    { UNUSED(hcan); }
+__weak void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan)  { UNUSED(hcan); }
+__weak void HAL_CAN_RxFifo0FullCallback(CAN_HandleTypeDef *hcan)        { UNUSED(hcan); }
+__weak void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan)  { UNUSED(hcan); }
+__weak void HAL_CAN_RxFifo1FullCallback(CAN_HandleTypeDef *hcan)        { UNUSED(hcan); }
+__weak void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan)              { UNUSED(hcan); }
+
+static bool CAN_IsActive(const CAN_HandleTypeDef *hcan)
+{
+    return hcan->State == HAL_CAN_STATE_READY || hcan->State == HAL_CAN_STATE_LISTENING;
+}
+
+HAL_StatusTypeDef HAL_CAN_Init(CAN_HandleTypeDef *hcan)
+{
+    if (hcan == NULL || hcan->Instance != CAN1) return HAL_ERROR;
+
+    if (hcan->State == HAL_CAN_STATE_RESET)
+    {
+        HAL_CAN_MspInit(hcan);
+        CAN1->TSR = CAN_TSR_TME;
+    }
+
+    CAN1->MCR |= CAN_MCR_INRQ;
+    CAN1->MSR |= CAN_MSR_INAK;
+
+    uint32_t mcr = CAN1->MCR & ~(CAN_MCR_ABOM | CAN_MCR_NART | CAN_MCR_RFLM | CAN_MCR_TXFP);
+    if (hcan->Init.AutoBusOff == ENABLE)            mcr |= CAN_MCR_ABOM;
+    if (hcan->Init.AutoRetransmission == DISABLE)   mcr |= CAN_MCR_NART;
+    if (hcan->Init.ReceiveFifoLocked == ENABLE)     mcr |= CAN_MCR_RFLM;
+    if (hcan->Init.TransmitFifoPriority == ENABLE)  mcr |= CAN_MCR_TXFP;
+    CAN1->MCR = mcr;
+
+    CAN1->BTR = hcan->Init.Mode | hcan->Init.SyncJumpWidth | hcan->Init.TimeSeg1 |
+                hcan->Init.TimeSeg2 | (hcan->Init.Prescaler - 1U);
+
+    hcan->ErrorCode = HAL_CAN_ERROR_NONE;
+    hcan->State     = HAL_CAN_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *sFilterConfig)
+{
+    if (!CAN_IsActive(hcan) || sFilterConfig->FilterBank >= FILTER_BANKS)
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_NOT_INITIALIZED;
+        return HAL_ERROR;
+    }
+
+    uint32_t bit = 1U << sFilterConfig->FilterBank;
+    CAN_FilterRegister_TypeDef *fr = &CAN1->sFilterRegister[sFilterConfig->FilterBank];
+
+    CAN1->FA1R &= ~bit;
+
+    if (sFilterConfig->FilterScale == CAN_FILTERSCALE_16BIT)
+    {
+        CAN1->FS1R &= ~bit;
+        fr->FR1 = ((0xFFFFU & sFilterConfig->FilterMaskIdLow) << 16) | (0xFFFFU & sFilterConfig->FilterIdLow);
+        fr->FR2 = ((0xFFFFU & sFilterConfig->FilterMaskIdHigh) << 16) | (0xFFFFU & sFilterConfig->FilterIdHigh);
+    }
+    else
+    {
+        CAN1->FS1R |= bit;
+        fr->FR1 = ((0xFFFFU & sFilterConfig->FilterIdHigh) << 16) | (0xFFFFU & sFilterConfig->FilterIdLow);
+        fr->FR2 = ((0xFFFFU & sFilterConfig->FilterMaskIdHigh) << 16) | (0xFFFFU & sFilterConfig->FilterMaskIdLow);
+    }
+
+    if (sFilterConfig->FilterMode == CAN_FILTERMODE_IDLIST) CAN1->FM1R |= bit;
+    else                                                    CAN1->FM1R &= ~bit;
+
+    if (sFilterConfig->FilterFIFOAssignment == CAN_FILTER_FIFO1) CAN1->FFA1R |= bit;
+    else                                                         CAN1->FFA1R &= ~bit;
+
+    if (sFilterConfig->FilterActivation == CAN_FILTER_ENABLE) CAN1->FA1R |= bit;
+
+    if (_bus != NULL && _bus->refilter != NULL) _bus->refilter();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan)
+{
+    if (hcan->State != HAL_CAN_STATE_READY)
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_NOT_READY;
+        return HAL_ERROR;
+    }
+
+    if (!_busOpened) Sim_CAN_OpenBus();
+
+    hcan->State = HAL_CAN_STATE_LISTENING;
+    CAN1->MCR &= ~CAN_MCR_INRQ;
+    CAN1->MSR &= ~CAN_MSR_INAK;
+    hcan->ErrorCode = HAL_CAN_ERROR_NONE;
+
+    Sim_CAN_TxStart(Sim_NowNs());
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_Stop(CAN_HandleTypeDef *hcan)
+{
+    if (hcan->State != HAL_CAN_STATE_LISTENING)
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_NOT_STARTED;
+        return HAL_ERROR;
+    }
+
+    /* A frame already on the bus still finishes */
+    if (_txActive != NO_MAILBOX)
+    {
+        _txEndNs = Sim_NowNs();
+        Sim_CAN_TxComplete();
+    }
+
+    CAN1->MCR |= CAN_MCR_INRQ;
+    CAN1->MSR |= CAN_MSR_INAK;
+    hcan->State = HAL_CAN_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader,
+                                       uint8_t aData[], uint32_t *pTxMailbox)
+{
+    if (!CAN_IsActive(hcan))
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_NOT_INITIALIZED;
+        return HAL_ERROR;
+    }
+
+    uint32_t free = CAN1->TSR & CAN_TSR_TME;
+    if (free == 0U)
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_PARAM;
+        return HAL_ERROR;
+    }
+
+    /* TSR.CODE: the lowest-numbered empty mailbox */
+    uint32_t mb = (uint32_t)__builtin_ctz(free >> 26);
+    CAN_TxMailBox_TypeDef *box = &CAN1->sTxMailBox[mb];
+
+    *pTxMailbox = 1U << mb;
+
+    box->TIR  = (pHeader->IDE == CAN_ID_STD ? pHeader->StdId << CAN_TI0R_STID_Pos
+                                            : (pHeader->ExtId << CAN_TI0R_EXID_Pos) | CAN_TI0R_IDE)
+              | pHeader->RTR;
+    box->TDTR = pHeader->DLC & CAN_TDT0R_DLC;
+    box->TDHR = (uint32_t)aData[7] << 24 | (uint32_t)aData[6] << 16 |
+                (uint32_t)aData[5] << 8  | (uint32_t)aData[4];
+    box->TDLR = (uint32_t)aData[3] << 24 | (uint32_t)aData[2] << 16 |
+                (uint32_t)aData[1] << 8  | (uint32_t)aData[0];
+
+    CAN1->TSR &= ~(CAN_TSR_TMEx(mb) | CAN_TSR_DONE(mb));
+    _txOrder[mb] = _txSeq++;
+    box->TIR |= CAN_TI0R_TXRQ;
+
+    Sim_CAN_TxStart(Sim_NowNs());
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_AbortTxRequest(CAN_HandleTypeDef *hcan, uint32_t TxMailboxes)
+{
+    if (!CAN_IsActive(hcan)) return HAL_ERROR;
+
+    for (uint32_t mb = 0; mb < TX_MAILBOXES; mb++)
+    {
+        if ((TxMailboxes & (1U << mb)) == 0U || mb == _txActive) continue;
+        if ((CAN1->sTxMailBox[mb].TIR & CAN_TI0R_TXRQ) == 0U) continue;
+
+        CAN1->sTxMailBox[mb].TIR &= ~CAN_TI0R_TXRQ;
+        CAN1->TSR |= CAN_TSR_RQCP(mb) | CAN_TSR_TMEx(mb);
+    }
+    return HAL_OK;
+}
+
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef *hcan)
+{
+    if (!CAN_IsActive(hcan)) return 0U;
+    return (uint32_t)__builtin_popcount(CAN1->TSR & CAN_TSR_TME);
+}
+
+uint32_t HAL_CAN_IsTxMessagePending(CAN_HandleTypeDef *hcan, uint32_t TxMailboxes)
+{
+    if (!CAN_IsActive(hcan)) return 0U;
+    return (CAN1->TSR & (TxMailboxes << 26)) != (TxMailboxes << 26) ? 1U : 0U;
+}
+
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo,
+                                       CAN_RxHeaderTypeDef *pHeader, uint8_t aData[])
+{
+    if (!CAN_IsActive(hcan) || RxFifo > CAN_RX_FIFO1)
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_NOT_INITIALIZED;
+        return HAL_ERROR;
+    }
+    if ((*Sim_CAN_Rfr(RxFifo) & CAN_RF0R_FMP0) == 0U)
+    {
+        hcan->ErrorCode |= HAL_CAN_ERROR_PARAM;
+        return HAL_ERROR;
+    }
+
+    const CAN_FIFOMailBox_TypeDef *box = &CAN1->sFIFOMailBox[RxFifo];
+
+    pHeader->IDE = box->RIR & CAN_RI0R_IDE;
+    if (pHeader->IDE == CAN_ID_STD)
+        pHeader->StdId = (box->RIR & CAN_RI0R_STID) >> CAN_TI0R_STID_Pos;
+    else
+        pHeader->ExtId = (box->RIR & (CAN_RI0R_EXID | CAN_RI0R_STID)) >> CAN_RI0R_EXID_Pos;
+    pHeader->RTR              = box->RIR & CAN_RI0R_RTR;
+    pHeader->DLC              = box->RDTR & CAN_RDT0R_DLC;
+    pHeader->FilterMatchIndex = (box->RDTR & CAN_RDT0R_FMI) >> CAN_RDT0R_FMI_Pos;
+    pHeader->Timestamp        = (box->RDTR & CAN_RDT0R_TIME) >> CAN_RDT0R_TIME_Pos;
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        aData[i]     = (uint8_t)(box->RDLR >> (8U * i));
+        aData[i + 4] = (uint8_t)(box->RDHR >> (8U * i));
+    }
+
+    Sim_CAN_RxRelease(RxFifo);      /* RFOM */
+    return HAL_OK;
+}
+
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo)
+{
+    if (!CAN_IsActive(hcan) || RxFifo > CAN_RX_FIFO1) return 0U;
+    return *Sim_CAN_Rfr(RxFifo) & CAN_RF0R_FMP0;
+}
+
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs)
+{
+    if (!CAN_IsActive(hcan)) return HAL_ERROR;
+    CAN1->IER |= ActiveITs;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_DeactivateNotification(CAN_HandleTypeDef *hcan, uint32_t InactiveITs)
+{
+    if (!CAN_IsActive(hcan)) return HAL_ERROR;
+    CAN1->IER &= ~InactiveITs;
+    return HAL_OK;
+}
+
+uint32_t HAL_CAN_GetError(CAN_HandleTypeDef *hcan)
+{
+    return hcan->ErrorCode;
+}
+
+/* ─────────────────────────────────────────────────
+ * HAL_CAN_IRQHandler — the driver's order: TX mailboxes,
+ * then FIFO 0 and FIFO 1 (overrun, full, pending)
+ * ───────────────────────────────────────────────── */
+void HAL_CAN_IRQHandler(CAN_HandleTypeDef *hcan)
+{
+    static void (*const complete[TX_MAILBOXES])(CAN_HandleTypeDef *) = {
+        HAL_CAN_TxMailbox0CompleteCallback, HAL_CAN_TxMailbox1CompleteCallback,
+        HAL_CAN_TxMailbox2CompleteCallback,
+    };
+    static void (*const abort_[TX_MAILBOXES])(CAN_HandleTypeDef *) = {
+        HAL_CAN_TxMailbox0AbortCallback, HAL_CAN_TxMailbox1AbortCallback,
+        HAL_CAN_TxMailbox2AbortCallback,
+    };
+    static const uint32_t terr[TX_MAILBOXES] = {
+        HAL_CAN_ERROR_TX_TERR0, HAL_CAN_ERROR_TX_TERR1, HAL_CAN_ERROR_TX_TERR2,
+    };
+
+    uint32_t ier       = CAN1->IER;
+    uint32_t errorcode = HAL_CAN_ERROR_NONE;
+
+    if ((ier & CAN_IER_TMEIE) != 0U)
+    {
+        for (uint32_t mb = 0; mb < TX_MAILBOXES; mb++)
+        {
+            uint32_t tsr = CAN1->TSR;
+            if ((tsr & CAN_TSR_RQCP(mb)) == 0U) continue;
+
+            CAN1->TSR &= ~CAN_TSR_DONE(mb);
+            if ((tsr & CAN_TSR_TXOK(mb)) != 0U)      complete[mb](hcan);
+            else if ((tsr & CAN_TSR_TERR(mb)) != 0U) errorcode |= terr[mb];
+            else                                     abort_[mb](hcan);
+        }
+    }
+
+    for (uint32_t fifo = 0; fifo < 2U; fifo++)
+    {
+        __IO uint32_t *rfr = Sim_CAN_Rfr(fifo);
+        uint32_t fier = ier >> (3U * fifo);
+
+        if ((fier & CAN_IER_FOVIE0) != 0U && (*rfr & CAN_RF0R_FOVR0) != 0U)
+        {
+            errorcode |= fifo == 0U ? HAL_CAN_ERROR_RX_FOV0 : HAL_CAN_ERROR_RX_FOV1;
+            *rfr &= ~CAN_RF0R_FOVR0;
+        }
+        if ((fier & CAN_IER_FFIE0) != 0U && (*rfr & CAN_RF0R_FULL0) != 0U)
+        {
+            *rfr &= ~CAN_RF0R_FULL0;
+            if (fifo == 0U) HAL_CAN_RxFifo0FullCallback(hcan);
+            else            HAL_CAN_RxFifo1FullCallback(hcan);
+        }
+        if ((fier & CAN_IER_FMPIE0) != 0U && (*rfr & CAN_RF0R_FMP0) != 0U)
+        {
+            if (fifo == 0U) HAL_CAN_RxFifo0MsgPendingCallback(hcan);
+            else            HAL_CAN_RxFifo1MsgPendingCallback(hcan);
+        }
+    }
+
+    if (errorcode != HAL_CAN_ERROR_NONE)
+    {
+        hcan->ErrorCode |= errorcode;
+        HAL_CAN_ErrorCallback(hcan);
+    }
+}
@@ -0,0 +1,250 @@
+/*
+ * sim_core.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "sim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* ── Vector Table ────────────────────────────── */
+/* Weak, so a node without the handler (TIM3 on Node B) still links */
+extern void CAN1_TX_IRQHandler(void)       __attribute__((weak));
+extern void CAN1_RX0_IRQHandler(void)      __attribute__((weak));
+extern void CAN1_RX1_IRQHandler(void)      __attribute__((weak));
+extern void TIM1_UP_TIM10_IRQHandler(void) __attribute__((weak));
+extern void TIM2_IRQHandler(void)          __attribute__((weak));
+extern void TIM3_IRQHandler(void)          __attribute__((weak));
+
+static bool Tim1Pending(void) { return Sim_TIM_IrqPending(TIM1); }
+static bool Tim2Pending(void) { return Sim_TIM_IrqPending(TIM2); }
+static bool Tim3Pending(void) { return Sim_TIM_IrqPending(TIM3); }
+
+typedef struct {
+    IRQn_Type irq;
+    void    (*handler)(void);
+    bool    (*pending)(void);
+} Sim_Vector_t;
+
+static const Sim_Vector_t _vectors[] = {
+    { CAN1_TX_IRQn,       CAN1_TX_IRQHandler,       Sim_CAN_TxIrqPending  },
+    { CAN1_RX0_IRQn,      CAN1_RX0_IRQHandler,      Sim_CAN_Rx0IrqPending },
+    { CAN1_RX1_IRQn,      CAN1_RX1_IRQHandler,      Sim_CAN_Rx1IrqPending },
+    { TIM1_UP_TIM10_IRQn, TIM1_UP_TIM10_IRQHandler, Tim1Pending           },
+    { TIM2_IRQn,          TIM2_IRQHandler,          Tim2Pending           },
+    { TIM3_IRQn,          TIM3_IRQHandler,          Tim3Pending           },
+};
+
+#define VECTOR_COUNT        (sizeof(_vectors) / sizeof(_vectors[0]))
+#define MAX_DISPATCH        64      /* Per tick — bounds a level-triggered storm */
+
+/* ── State ───────────────────────────────────── */
+static struct timespec  _start;
+static bool             _nvicEnabled[SIM_IRQ_COUNT];
+static uint8_t          _nvicPrio[SIM_IRQ_COUNT];
+
+static __thread uint32_t _primask;  /* Per task thread, like the saved context */
+static __thread uint32_t _ipsr;     /* Exception number while in a handler */
+
+static StaticTask_t _irqTaskCb;
+static StackType_t  _irqTaskStack[configMINIMAL_STACK_SIZE * 2];
+void *Sim_IrqTaskHandle;
+
+static DWT_Type _dwt;
+
+uint64_t Sim_NowNs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - _start.tv_sec) * 1000000000ULL
+         + (uint64_t)now.tv_nsec - (uint64_t)_start.tv_nsec;
+}
+
+/* ─────────────────────────────────────────────────
+ * Core intrinsics — PRIMASK is the port's interrupt
+ * mask, so a masked task cannot be preempted by the
+ * tick and therefore not by the simulated NVIC either.
+ * Kernel critical sections and the scheduler mask the
+ * tick themselves; PRIMASK set and cleared inside one
+ * (trace hooks) leaves their mask in place, as BASEPRI
+ * outlives PRIMASK on the target. The hooks say so
+ * through a flag: a mask lookup here would cost a
+ * system call on every __disable_irq
+ * ───────────────────────────────────────────────── */
+__thread int Sim_InKernelHook;        /* SIM_KERNEL_HOOK, FreeRTOSConfig.h */
+static __thread bool _primaskNested;
+
+uint32_t Sim_GetPrimask(void)
+{
+    return _primask;
+}
+
+void Sim_SetPrimask(uint32_t mask)
+{
+    if (mask != 0U && _primask == 0U)
+    {
+        _primaskNested = Sim_InKernelHook != 0;
+        if (!_primaskNested) portDISABLE_INTERRUPTS();
+        _primask = 1U;
+    }
+    else if (mask == 0U && _primask != 0U)
+    {
+        _primask = 0U;
+        if (!_primaskNested) portENABLE_INTERRUPTS();
+    }
+}
+
+uint32_t Sim_GetIpsr(void)
+{
+    return _ipsr;
+}
+
+void Sim_NvicSetPriority(IRQn_Type irq, uint32_t priority)
+{
+    if (irq >= 0 && irq < SIM_IRQ_COUNT) _nvicPrio[irq] = (uint8_t)priority;
+}
+
+void Sim_NvicEnable(IRQn_Type irq, bool enable)
+{
+    if (irq >= 0 && irq < SIM_IRQ_COUNT) _nvicEnabled[irq] = enable;
+}
+
+bool Sim_NvicIsEnabled(IRQn_Type irq)
+{
+    return irq >= 0 && irq < SIM_IRQ_COUNT && _nvicEnabled[irq];
+}
+
+/* CYCCNT follows host time at the configured core clock */
+DWT_Type *Sim_DWT(void)
+{
+    if ((_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0U &&
+        (CoreDebug->DEMCR & CoreDebug_DEMCR_TRCENA_Msk) != 0U)
+    {
+        _dwt.CYCCNT = (uint32_t)(Sim_NowNs() * (SystemCoreClock / 1000000U) / 1000U);
+    }
+    return &_dwt;
+}
+
+/* ─────────────────────────────────────────────────
+ * Sim_ServiceInterrupts — one NVIC pass: bring the
+ * peripheral models up to date, then take pending
+ * lines highest priority first. When none is left the
+ * CAN model takes in its next received frame, until
+ * the backend has nothing more
+ * ───────────────────────────────────────────────── */
+static void Sim_ServiceInterrupts(void)
+{
+    Sim_TIM_Poll(TIM1);
+    Sim_TIM_Poll(TIM2);
+    Sim_TIM_Poll(TIM3);
+    bool more = Sim_CAN_Poll();
+
+    for (uint32_t n = 0; n < MAX_DISPATCH; n++)
+    {
+        const Sim_Vector_t *next = NULL;
+
+        for (uint32_t i = 0; i < VECTOR_COUNT; i++)
+        {
+            const Sim_Vector_t *v = &_vectors[i];
+
+            if (v->handler == NULL || !_nvicEnabled[v->irq] || !v->pending()) continue;
+            if (next == NULL || _nvicPrio[v->irq] < _nvicPrio[next->irq]) next = v;
+        }
+        if (next == NULL)
+        {
+            if (!more) return;
+            more = Sim_CAN_Poll();
+            continue;
+        }
+
+        _ipsr = (uint32_t)next->irq + 16U;
+        next->handler();
+        _ipsr = 0U;
+    }
+}
+
+static void Sim_IrqTask(void *argument)
+{
+    (void)argument;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        Sim_ServiceInterrupts();
+    }
+}
+
+/* Runs in the port's tick handler */
+void vApplicationTickHook(void)
+{
+    vTaskNotifyGiveFromISR((TaskHandle_t)Sim_IrqTaskHandle, NULL);
+}
+
+/* ─────────────────────────────────────────────────
+ * Sim_Init — from HAL_Init, before any peripheral is
+ * touched. The NVIC task sits above every priority
+ * the firmware can ask for
+ * ───────────────────────────────────────────────── */
+void Sim_Init(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &_start);
+
+    Sim_IrqTaskHandle = xTaskCreateStatic(Sim_IrqTask, "NVIC",
+                                          sizeof(_irqTaskStack) / sizeof(_irqTaskStack[0]),
+                                          NULL, configMAX_PRIORITIES - 1,
+                                          _irqTaskStack, &_irqTaskCb);
+}
+
+/* ── Host Threads ────────────────────────────── */
+/* The port drives its tick and context switches with signals; a
+ * helper thread must never take one */
+bool Sim_StartThread(void *(*entry)(void *))
+{
+    sigset_t all, old;
+    pthread_t thread;
+
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    int err = pthread_create(&thread, NULL, entry, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    if (err == 0) pthread_detach(thread);
+    return err == 0;
+}
+
+bool Sim_RxRingPut(Sim_RxRing_t *ring, const Sim_RxItem_t *item)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head - tail == SIM_RX_RING_SIZE) return false;     /* IRQ task stalled — lost */
+
+    ring->item[head & (SIM_RX_RING_SIZE - 1U)] = *item;
+    atomic_store_explicit(&ring->head, head + 1U, memory_order_release);
+    return true;
+}
+
+bool Sim_RxRingGet(Sim_RxRing_t *ring, Sim_RxItem_t *item)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (tail == head) return false;
+
+    *item = ring->item[tail & (SIM_RX_RING_SIZE - 1U)];
+    atomic_store_explicit(&ring->tail, tail + 1U, memory_order_release);
+    return true;
+}
+
+void Sim_AssertFailed(const char *file, int line)
+{
+    fprintf(stderr, "configASSERT failed at %s:%d\n", file, line);
+    abort();
+}
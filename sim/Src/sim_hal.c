@@ -0,0 +1,270 @@
+/*
+ * sim_hal.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "stm32f4xx_hal.h"
+#include "sim.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+/* ── Register Blocks ─────────────────────────── */
+CAN_TypeDef    Sim_CAN1;
+TIM_TypeDef    Sim_TIM1, Sim_TIM2, Sim_TIM3;
+USART_TypeDef  Sim_USART2;
+GPIO_TypeDef   Sim_GPIOA, Sim_GPIOB, Sim_GPIOC, Sim_GPIOH;
+FLASH_TypeDef  Sim_FLASH;
+SCB_Type       Sim_SCB;
+SysTick_Type   Sim_SysTick;
+CoreDebug_Type Sim_CoreDebug;
+
+/* ── Clocks ──────────────────────────────────── */
+uint32_t SystemCoreClock = HSI_VALUE;
+
+static uint32_t _pllClk;
+static uint32_t _sysClkSource = RCC_SYSCLKSOURCE_HSI;
+static uint32_t _ahbDiv  = 1U;
+static uint32_t _apb1Div = 1U;
+static uint32_t _apb2Div = 1U;
+
+/* ── HAL Tick ────────────────────────────────── */
+__IO uint32_t       uwTick;
+uint32_t            uwTickPrio = (1UL << __NVIC_PRIO_BITS);
+HAL_TickFreqTypeDef uwTickFreq = HAL_TICK_FREQ_DEFAULT;
+
+static uint32_t _uartPaceNsPerByte;
+
+/* ─────────────────────────────────────────────────
+ * HAL Core — HAL_Init starts the simulated core before
+ * anything else so the tick and NVIC exist when the
+ * timebase is configured
+ * ───────────────────────────────────────────────── */
+HAL_StatusTypeDef HAL_Init(void)
+{
+    Sim_Init();
+
+    FLASH->ACR |= FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+
+    HAL_NVIC_SetPriorityGrouping(NVIC_PRIORITYGROUP_4);
+    HAL_InitTick(TICK_INT_PRIORITY);
+    HAL_MspInit();
+    return HAL_OK;
+}
+
+/* Overridden by stm32f4xx_hal_timebase_tim.c */
+__weak HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+    uwTickPrio = TickPriority;
+    return HAL_OK;
+}
+
+__weak void HAL_MspInit(void)
+{
+}
+
+void HAL_IncTick(void)
+{
+    uwTick += uwTickFreq;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return uwTick;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    uint32_t start = HAL_GetTick();
+    uint32_t wait  = Delay;
+
+    if (wait < HAL_MAX_DELAY) wait += (uint32_t)uwTickFreq;
+    while ((HAL_GetTick() - start) < wait) { }
+}
+
+__weak void HAL_SuspendTick(void)
+{
+}
+
+__weak void HAL_ResumeTick(void)
+{
+}
+
+/* ─────────────────────────────────────────────────
+ * RCC / PWR — only the resulting frequencies are kept;
+ * the PLL locks and the bus switches instantly
+ * ───────────────────────────────────────────────── */
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+    const RCC_PLLInitTypeDef *pll = &RCC_OscInitStruct->PLL;
+
+    if (pll->PLLState == RCC_PLL_ON)
+    {
+        if (pll->PLLSource != RCC_PLLSOURCE_HSI || pll->PLLM == 0U || pll->PLLP == 0U)
+            return HAL_ERROR;
+        _pllClk = (uint32_t)((uint64_t)HSI_VALUE / pll->PLLM * pll->PLLN / pll->PLLP);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+    if (RCC_ClkInitStruct->SYSCLKSource == RCC_SYSCLKSOURCE_PLLCLK && _pllClk == 0U)
+        return HAL_ERROR;
+
+    FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY) | FLatency;
+
+    _sysClkSource = RCC_ClkInitStruct->SYSCLKSource;
+    _ahbDiv       = RCC_ClkInitStruct->AHBCLKDivider;
+    _apb1Div      = RCC_ClkInitStruct->APB1CLKDivider;
+    _apb2Div      = RCC_ClkInitStruct->APB2CLKDivider;
+
+    SystemCoreClock = HAL_RCC_GetHCLKFreq();
+    return HAL_InitTick(uwTickPrio);
+}
+
+void HAL_RCC_GetClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t *pFLatency)
+{
+    RCC_ClkInitStruct->ClockType      = RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK |
+                                        RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+    RCC_ClkInitStruct->SYSCLKSource   = _sysClkSource;
+    RCC_ClkInitStruct->AHBCLKDivider  = _ahbDiv;
+    RCC_ClkInitStruct->APB1CLKDivider = _apb1Div;
+    RCC_ClkInitStruct->APB2CLKDivider = _apb2Div;
+    *pFLatency = FLASH->ACR & FLASH_ACR_LATENCY;
+}
+
+uint32_t HAL_RCC_GetSysClockFreq(void)
+{
+    return _sysClkSource == RCC_SYSCLKSOURCE_PLLCLK ? _pllClk : HSI_VALUE;
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+    return HAL_RCC_GetSysClockFreq() / _ahbDiv;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return HAL_RCC_GetHCLKFreq() / _apb1Div;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+    return HAL_RCC_GetHCLKFreq() / _apb2Div;
+}
+
+/* Timer kernels run at twice a divided APB clock (RM0390 §6.2) */
+uint32_t Sim_TimerClockHz(const TIM_TypeDef *tim)
+{
+    if (tim == TIM1) return _apb2Div == 1U ? HAL_RCC_GetPCLK2Freq() : 2U * HAL_RCC_GetPCLK2Freq();
+    return _apb1Div == 1U ? HAL_RCC_GetPCLK1Freq() : 2U * HAL_RCC_GetPCLK1Freq();
+}
+
+HAL_StatusTypeDef HAL_PWREx_EnableOverDrive(void)
+{
+    return HAL_OK;
+}
+
+/* ── NVIC ────────────────────────────────────── */
+void HAL_NVIC_SetPriorityGrouping(uint32_t PriorityGroup)
+{
+    (void)PriorityGroup;    /* Group 4: all bits pre-emption */
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    (void)SubPriority;
+    NVIC_SetPriority(IRQn, PreemptPriority);
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    NVIC_EnableIRQ(IRQn);
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+    NVIC_DisableIRQ(IRQn);
+}
+
+/* ── GPIO — output data register only ────────── */
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin)
+{
+    (void)GPIOx;
+    (void)GPIO_Pin;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return (GPIOx->IDR & GPIO_Pin) != 0U ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (PinState != GPIO_PIN_RESET) GPIOx->ODR |= GPIO_Pin;
+    else                            GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    GPIOx->ODR ^= GPIO_Pin;
+}
+
+/* ─────────────────────────────────────────────────
+ * UART — bytes go to stdout. Blocking transmit holds the
+ * caller for the time the frame takes on the wire, as the
+ * polled HAL driver does; SIM_UART_PACE=0 turns that off
+ * ───────────────────────────────────────────────── */
+__weak void HAL_UART_MspInit(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+__weak void HAL_UART_MspDeInit(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    if (huart == NULL || huart->Init.BaudRate == 0U) return HAL_ERROR;
+
+    if (huart->gState == HAL_UART_STATE_RESET) HAL_UART_MspInit(huart);
+
+    const char *pace = getenv("SIM_UART_PACE");
+    _uartPaceNsPerByte = (pace != NULL && atoi(pace) == 0) ? 0U
+                       : (uint32_t)(10ULL * 1000000000ULL / huart->Init.BaudRate);   /* 8N1 */
+
+    huart->gState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size,
+                                    uint32_t Timeout)
+{
+    (void)Timeout;
+
+    if (huart->gState != HAL_UART_STATE_READY) return HAL_BUSY;
+    if (pData == NULL || Size == 0U) return HAL_ERROR;
+
+    uint64_t done = Sim_NowNs() + (uint64_t)_uartPaceNsPerByte * Size;
+
+    for (uint16_t sent = 0; sent < Size; )
+    {
+        ssize_t n = write(STDOUT_FILENO, pData + sent, Size - sent);
+        if (n <= 0) break;
+        sent += (uint16_t)n;
+    }
+    while (Sim_NowNs() < done) { }
+
+    return HAL_OK;
+}
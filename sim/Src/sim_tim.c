@@ -0,0 +1,258 @@
+/*
+ * sim_tim.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "stm32f4xx_hal.h"
+#include "sim.h"
+
+/* ── Counter Model ───────────────────────────── */
+/* The counter is never stored: it is derived from host time as
+ * base + elapsed * f_tim / (PSC + 1), counted in 64 bits so update
+ * and compare events between two polls can be found from the
+ * previous and the current position */
+typedef struct {
+    TIM_TypeDef *tim;
+    bool         running;
+    uint64_t     startNs;
+    uint64_t     base;          /* Counter ticks at startNs */
+    uint64_t     last;          /* Position at the previous poll */
+} Sim_Timer_t;
+
+static Sim_Timer_t _timers[] = {
+    { .tim = TIM1 },
+    { .tim = TIM2 },
+    { .tim = TIM3 },
+};
+
+static Sim_Timer_t *Sim_TIM_Find(const TIM_TypeDef *tim)
+{
+    for (uint32_t i = 0; i < sizeof(_timers) / sizeof(_timers[0]); i++)
+    {
+        if (_timers[i].tim == tim) return &_timers[i];
+    }
+    return NULL;
+}
+
+static uint64_t Sim_TIM_Position(const Sim_Timer_t *t)
+{
+    if (!t->running) return t->base;
+
+    unsigned __int128 ticks = (unsigned __int128)(Sim_NowNs() - t->startNs)
+                            * Sim_TimerClockHz(t->tim);
+    return t->base + (uint64_t)(ticks / (1000000000ULL * ((uint64_t)t->tim->PSC + 1U)));
+}
+
+static uint64_t Sim_TIM_Period(const TIM_TypeDef *tim)
+{
+    return (uint64_t)tim->ARR + 1U;
+}
+
+uint32_t Sim_TIM_GetCounter(TIM_TypeDef *tim)
+{
+    Sim_Timer_t *t = Sim_TIM_Find(tim);
+    if (t == NULL) return tim->CNT;
+
+    tim->CNT = (uint32_t)(Sim_TIM_Position(t) % Sim_TIM_Period(tim));
+    return tim->CNT;
+}
+
+void Sim_TIM_SetCounter(TIM_TypeDef *tim, uint32_t cnt)
+{
+    Sim_Timer_t *t = Sim_TIM_Find(tim);
+
+    tim->CNT = cnt;
+    if (t == NULL) return;
+
+    t->startNs = Sim_NowNs();
+    t->base    = cnt;
+    t->last    = cnt;
+}
+
+void Sim_TIM_Start(TIM_TypeDef *tim)
+{
+    Sim_Timer_t *t = Sim_TIM_Find(tim);
+    if (t == NULL || t->running) return;
+
+    t->startNs = Sim_NowNs();
+    t->base    = tim->CNT;
+    t->last    = tim->CNT;
+    t->running = true;
+}
+
+void Sim_TIM_Stop(TIM_TypeDef *tim)
+{
+    Sim_Timer_t *t = Sim_TIM_Find(tim);
+    if (t == NULL || !t->running) return;
+
+    tim->CNT   = (uint32_t)(Sim_TIM_Position(t) % Sim_TIM_Period(tim));
+    t->running = false;
+    t->base    = tim->CNT;
+}
+
+/* ─────────────────────────────────────────────────
+ * Sim_TIM_Poll — raise the flags for everything that
+ * happened since the previous poll. Several periods
+ * collapse into one update event, as they would for a
+ * handler that ran late
+ * ───────────────────────────────────────────────── */
+void Sim_TIM_Poll(TIM_TypeDef *tim)
+{
+    Sim_Timer_t *t = Sim_TIM_Find(tim);
+    if (t == NULL || !t->running) return;
+
+    uint64_t now    = Sim_TIM_Position(t);
+    uint64_t period = Sim_TIM_Period(tim);
+    if (now <= t->last) return;
+
+    if (now / period != t->last / period) tim->SR |= TIM_SR_UIF;
+
+    /* Compare match: the first position after the last poll
+     * where the counter equals CCRx */
+    const uint32_t ccr[4] = { tim->CCR1, tim->CCR2, tim->CCR3, tim->CCR4 };
+    for (uint32_t ch = 0; ch < 4; ch++)
+    {
+        if (ccr[ch] >= period) continue;
+
+        uint64_t match = t->last - (t->last % period) + ccr[ch];
+        if (match <= t->last) match += period;
+        if (match <= now) tim->SR |= TIM_SR_CC1IF << ch;
+    }
+
+    t->last = now;
+}
+
+bool Sim_TIM_IrqPending(const TIM_TypeDef *tim)
+{
+    const uint32_t sources = TIM_DIER_UIE | TIM_DIER_CC1IE | TIM_DIER_CC2IE |
+                             TIM_DIER_CC3IE | TIM_DIER_CC4IE;
+    return (tim->SR & tim->DIER & sources) != 0U;
+}
+
+/* ── HAL TIM ─────────────────────────────────── */
+__weak void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim)
+{
+    UNUSED(htim);
+}
+
+__weak void HAL_TIM_OC_MspInit(TIM_HandleTypeDef *htim)
+{
+    UNUSED(htim);
+}
+
+__weak void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    UNUSED(htim);
+}
+
+__weak void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    UNUSED(htim);
+}
+
+static void TIM_Base_SetConfig(TIM_HandleTypeDef *htim)
+{
+    TIM_TypeDef *tim = htim->Instance;
+
+    tim->CR1 = (tim->CR1 & TIM_CR1_CEN) | htim->Init.AutoReloadPreload;
+    tim->PSC = htim->Init.Prescaler;
+    tim->ARR = htim->Init.Period;
+    Sim_TIM_SetCounter(tim, 0U);    /* UG: reload PSC, restart from zero */
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+    if (htim == NULL || Sim_TIM_Find(htim->Instance) == NULL) return HAL_ERROR;
+
+    if (htim->State == HAL_TIM_STATE_RESET) HAL_TIM_Base_MspInit(htim);
+
+    TIM_Base_SetConfig(htim);
+    htim->State = HAL_TIM_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_Init(TIM_HandleTypeDef *htim)
+{
+    if (htim == NULL || Sim_TIM_Find(htim->Instance) == NULL) return HAL_ERROR;
+
+    if (htim->State == HAL_TIM_STATE_RESET) HAL_TIM_OC_MspInit(htim);
+
+    TIM_Base_SetConfig(htim);
+    htim->State = HAL_TIM_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig,
+                                           uint32_t Channel)
+{
+    if (Channel > TIM_CHANNEL_4 || sConfig->OCMode != TIM_OCMODE_TIMING) return HAL_ERROR;
+
+    __HAL_TIM_SET_COMPARE(htim, Channel, sConfig->Pulse);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim)
+{
+    if (htim->State != HAL_TIM_STATE_READY) return HAL_ERROR;
+
+    htim->State = HAL_TIM_STATE_BUSY;
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    Sim_TIM_Start(htim->Instance);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    Sim_TIM_Stop(htim->Instance);
+    htim->State = HAL_TIM_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    if (htim->State != HAL_TIM_STATE_READY) return HAL_ERROR;
+
+    __HAL_TIM_ENABLE_IT(htim, TIM_IT_UPDATE);
+    return HAL_TIM_Base_Start(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    __HAL_TIM_DISABLE_IT(htim, TIM_IT_UPDATE);
+    return HAL_TIM_Base_Stop(htim);
+}
+
+/* ─────────────────────────────────────────────────
+ * HAL_TIM_IRQHandler — the driver's order: compare
+ * channels first, then update
+ * ───────────────────────────────────────────────── */
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef *htim)
+{
+    static const HAL_TIM_ActiveChannel active[4] = {
+        HAL_TIM_ACTIVE_CHANNEL_1, HAL_TIM_ACTIVE_CHANNEL_2,
+        HAL_TIM_ACTIVE_CHANNEL_3, HAL_TIM_ACTIVE_CHANNEL_4,
+    };
+
+    for (uint32_t ch = 0; ch < 4; ch++)
+    {
+        uint32_t flag = TIM_SR_CC1IF << ch;
+
+        if (__HAL_TIM_GET_FLAG(htim, flag) && (htim->Instance->DIER & flag) != 0U)
+        {
+            __HAL_TIM_CLEAR_IT(htim, flag);
+            htim->Channel = active[ch];
+            HAL_TIM_OC_DelayElapsedCallback(htim);
+            htim->Channel = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+        }
+    }
+
+    if (__HAL_TIM_GET_FLAG(htim, TIM_FLAG_UPDATE) && (htim->Instance->DIER & TIM_IT_UPDATE) != 0U)
+    {
+        __HAL_TIM_CLEAR_IT(htim, TIM_IT_UPDATE);
+        HAL_TIM_PeriodElapsedCallback(htim);
+    }
+}
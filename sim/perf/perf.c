@@ -0,0 +1,673 @@
+/*
+ * perf.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "sim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "can_app.h"
+#include "co_od.h"
+#include "uart_log.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(PERF_NODE_A)
+#include "canopen.h"
+#elif defined(PERF_NODE_B)
+#include "config.h"
+#else
+#error "Build with -DPERF_NODE_A or -DPERF_NODE_B"
+#endif
+
+/* ── CAN Stack Benchmarks ────────────────────── */
+/* Linked into a node binary (make perf), this file is the rest of the
+ * bus. The node boots unchanged; a driver task just below the NVIC
+ * then times its real code paths through the bxCAN model, in host
+ * nanoseconds:
+ *
+ *   tx_submit_ns       CAN_App_Transmit into a free mailbox
+ *   log_record_ns      UART_Log, UART unpaced (SIM_UART_PACE=0)
+ *   log_int_ns         UART_Log_Int
+ *   dispatch_ns.<id>   RX thread: queue → handler → frame freed, per frame
+ *   rx_frames_per_s    RX interrupt → handler, through the FIFO and pool
+ *   cmd_ack_ns         Node A: command in → end of its ACK frame
+ *   rpm_cmd_ns         Node B: RPM over the limit in → end of the command
+ *
+ * A batch counts as handled once a task below every node task gets the
+ * CPU. The command path runs under background traffic from other nodes,
+ * SIM_PERF_LOAD percent of the bus (default 50); commands are ACKed as a
+ * sensor would. Results are written to SIM_PERF_OUT (stderr if unset)
+ * as JSON, for perf_compare.py to check against a baseline. Along
+ * with them goes host_ref_ns, a fixed loop of plain arithmetic timed
+ * before and after the run: the comparison scales host timings by it,
+ * so a slower or busier machine is not read as a regression */
+#define PERF_SETTLE_MS          1500U   /* Boot, subscriptions, first log lines */
+#define PERF_TX_SUBMITS         600U
+#define PERF_LOG_RECORDS        2000U
+#define PERF_DISPATCH_ROUNDS    100U
+#define PERF_RX_BURSTS          200U
+#define PERF_RX_BURST           12U     /* Frames per burst, fits the pool */
+#define PERF_CMD_ROUNDS         200U
+#define PERF_CMD_TIMEOUT_MS     100U
+#define PERF_CMD_GAP_MS         5U
+#define PERF_LOAD_SETTLE_MS     200U    /* Load nodes seen and subscribed to first */
+#define PERF_DEFAULT_LOAD       50U
+#define PERF_REF_ROUNDS         200U    /* Host reference, each side of the run */
+#define PERF_REF_WORDS          1024U
+
+#define PERF_MAX_SAMPLES        2000U
+#define PERF_MAX_METRICS        24U
+#define PERF_UNKNOWN_ID         0x7E0U  /* Nobody's ID */
+
+#if defined(PERF_NODE_A)
+#define PERF_NODE               "A"
+#define PERF_TARGET_NODE        SENSOR_NODE_ID
+#else
+#define PERF_NODE               "B"
+#define PERF_TARGET_NODE        5U      /* The sensor the controller is measured against */
+#endif
+
+extern CAN_HandleTypeDef hcan1;
+
+/* ── Frames ──────────────────────────────────── */
+typedef struct {
+    const char *name;
+    uint32_t    id;
+    uint8_t     dlc;
+    uint8_t     data[8];
+    uint8_t     batch;      /* Frames per measurement — at most 3 if each is answered */
+} Perf_Frame_t;
+
+#if defined(PERF_NODE_A)
+static const Perf_Frame_t _dispatch[] = {
+    { "command",        CAN_ID_CMD(SENSOR_NODE_ID, CAN_FN_COMMAND),   1, { CMD_REDUCE_POWER }, 3 },
+    { "subscribe",      CAN_ID_CMD(SENSOR_NODE_ID, CAN_FN_SUBSCRIBE), 4, { 0x01, CAN_SIG_RPM, 0, 100 }, 8 },
+    { "ctrl_heartbeat", CAN_ID_CTRL_HEARTBEAT,                        1, { 0x01 }, 8 },
+    { "sdo_upload",     CO_COBID_RSDO + CO_NODE_ID,                   8, { 0x40, 0x00, 0x10, 0x00 }, 3 },
+    { "foreign",        CAN_ID_DATA(1, CAN_FN_RPM_AGG),               8, { 0x03, 0xE8, 0x03, 0xE8 }, 8 },
+};
+
+static const Perf_Frame_t _rxMix[] = {
+    { "foreign",        CAN_ID_DATA(2, CAN_FN_RPM_AGG),               8, { 0x03, 0xE8, 0x03, 0xE8 }, 0 },
+    { "ctrl_heartbeat", CAN_ID_CTRL_HEARTBEAT,                        1, { 0x01 }, 0 },
+    { "foreign",        CAN_ID_DATA(3, CAN_FN_HEARTBEAT),             1, { 0xAA }, 0 },
+};
+
+/* Measured against its answer */
+static const Perf_Frame_t _cmd  = { "cmd_ack_ns", CAN_ID_CMD(SENSOR_NODE_ID, CAN_FN_COMMAND), 1, { CMD_REDUCE_POWER }, 1 };
+#define PERF_CMD_REPLY_ID       CAN_ID_CMD(SENSOR_NODE_ID, CAN_FN_ACK)
+#else
+static const Perf_Frame_t _dispatch[] = {
+    { "heartbeat",      CAN_ID_DATA(PERF_TARGET_NODE, CAN_FN_HEARTBEAT), 1, { 0xAA }, 8 },
+    { "ack",            CAN_ID_CMD(PERF_TARGET_NODE, CAN_FN_ACK),        1, { CMD_WARNING_HIGH_RPM }, 8 },
+    { "diag",           CAN_ID_DATA(PERF_TARGET_NODE, CAN_FN_DIAG),      8, { 0, 0, 0x0E, 0x10 }, 8 },
+    { "config_read",    CAN_ID_CONFIG_REQ,                               2, { CFG_OP_READ, CFG_KEY_RPM_LIMIT }, 3 },
+    { "unknown",        PERF_UNKNOWN_ID,                                 1, { 0 }, 8 },
+};
+
+static const Perf_Frame_t _rxMix[] = {
+    { "rpm",            CAN_ID_DATA(1, CAN_FN_RPM),                   2, { 0x03, 0xE8 }, 0 },
+    { "temp",           CAN_ID_DATA(2, CAN_FN_TEMP),                  2, { 0x00, 0x28 }, 0 },
+    { "heartbeat",      CAN_ID_DATA(3, CAN_FN_HEARTBEAT),             1, { 0xAA }, 0 },
+};
+
+static const Perf_Frame_t _cmd  = { "rpm_cmd_ns", CAN_ID_DATA(PERF_TARGET_NODE, CAN_FN_RPM), 2, { 0x17, 0x70 }, 1 };
+#define PERF_CMD_REPLY_ID       CAN_ID_CMD(PERF_TARGET_NODE, CAN_FN_COMMAND)
+#endif
+
+#define COUNT_OF(a)             (sizeof(a) / sizeof((a)[0]))
+
+/* ── Results ─────────────────────────────────── */
+typedef struct {
+    char        name[40];
+    const char *unit;
+    bool        higherBetter;
+    bool        busTimed;       /* Mostly frame time on the bus, not host CPU */
+    double      value;          /* The compared number — p50 for latencies */
+    uint32_t    n;
+    uint32_t    min, p50, p99, max;
+    double      mean;
+    uint32_t    lost;           /* Dropped frames or unanswered commands */
+} Perf_Metric_t;
+
+static Perf_Metric_t _metric[PERF_MAX_METRICS];
+static uint32_t      _metrics;
+static uint32_t      _sample[PERF_MAX_SAMPLES];
+static uint32_t      _samples;
+static uint32_t      _hostRefNs;
+static volatile uint32_t _hostRefSink;
+
+/* ── Bus ─────────────────────────────────────── */
+/* One ring per producer: the driver task, the NVIC (auto-ACKs from
+ * send) and the load thread */
+static Sim_RxRing_t _injectRing;
+static Sim_RxRing_t _replyRing;
+static Sim_RxRing_t _loadRing;
+
+static volatile uint32_t _replyId = UINT32_MAX;
+static volatile uint64_t _replyNs;
+static volatile uint32_t _sent;
+
+static _Atomic uint32_t _loadPeriodNs;     /* 0: no background traffic */
+static _Atomic uint32_t _loadFrames;
+static _Atomic uint32_t _loadLost;
+static uint32_t         _loadPct = PERF_DEFAULT_LOAD;
+
+/* ── Tasks ───────────────────────────────────── */
+static StaticTask_t _perfTaskCb, _idleTaskCb;
+static StackType_t  _perfTaskStack[configMINIMAL_STACK_SIZE * 4];
+static StackType_t  _idleTaskStack[configMINIMAL_STACK_SIZE];
+static TaskHandle_t _perfTask, _idleTask;
+static volatile uint64_t _settledNs;
+
+/* ─────────────────────────────────────────────────
+ * Samples → metric
+ * ───────────────────────────────────────────────── */
+static int Perf_Cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void Perf_Sample(uint64_t ns)
+{
+    if (_samples < PERF_MAX_SAMPLES) _sample[_samples++] = ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+}
+
+static Perf_Metric_t *Perf_Add(const char *name, const char *unit, bool higherBetter)
+{
+    if (_metrics == PERF_MAX_METRICS) return NULL;
+
+    Perf_Metric_t *m = &_metric[_metrics++];
+    memset(m, 0, sizeof(*m));
+    snprintf(m->name, sizeof(m->name), "%s", name);
+    m->unit         = unit;
+    m->higherBetter = higherBetter;
+    return m;
+}
+
+/* Latency metric from the samples taken since the last one */
+static Perf_Metric_t *Perf_Latency(const char *name)
+{
+    Perf_Metric_t *m = Perf_Add(name, "ns", false);
+    uint64_t sum = 0;
+
+    if (m != NULL && _samples > 0U)
+    {
+        qsort(_sample, _samples, sizeof(_sample[0]), Perf_Cmp);
+        for (uint32_t i = 0; i < _samples; i++) sum += _sample[i];
+
+        m->n     = _samples;
+        m->min   = _sample[0];
+        m->p50   = _sample[_samples / 2U];
+        m->p99   = _sample[(_samples * 99U) / 100U];
+        m->max   = _sample[_samples - 1U];
+        m->mean  = (double)sum / _samples;
+        m->value = m->p50;
+    }
+    _samples = 0;
+    return m;
+}
+
+/* ─────────────────────────────────────────────────
+ * Perf_Settle — returns once every task above the
+ * idle sentinel has blocked, i.e. the node has done
+ * all the work the last frames caused
+ * ───────────────────────────────────────────────── */
+static uint64_t Perf_Settle(void)
+{
+    xTaskNotifyGive(_idleTask);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return _settledNs;
+}
+
+static void Perf_IdleTask(void *argument)
+{
+    (void)argument;
+
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        _settledNs = Sim_NowNs();
+        xTaskNotifyGive(_perfTask);
+    }
+}
+
+static void Perf_WaitTxIdle(void)
+{
+    while (HAL_CAN_GetTxMailboxesFreeLevel(&hcan1) < 3U) vTaskDelay(1);
+}
+
+static Sim_RxItem_t Perf_Item(const Perf_Frame_t *f)
+{
+    Sim_RxItem_t item;
+
+    memset(&item, 0, sizeof(item));
+    item.frame.id  = f->id;
+    item.frame.dlc = f->dlc;
+    memcpy(item.frame.data, f->data, sizeof(item.frame.data));
+    item.timeNs    = Sim_NowNs();
+    return item;
+}
+
+/* Frames arrive at the controller now; the NVIC takes them at once */
+static void Perf_Inject(const Perf_Frame_t *f, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        Sim_RxItem_t item = Perf_Item(&f[i]);
+        Sim_RxRingPut(&_injectRing, &item);
+    }
+    xTaskNotifyGive((TaskHandle_t)Sim_IrqTaskHandle);
+}
+
+/* ─────────────────────────────────────────────────
+ * Host reference — FNV-1a over a fixed buffer; the
+ * faster of the two sides of the run is kept
+ * ───────────────────────────────────────────────── */
+static void Perf_HostRef(void)
+{
+    static uint32_t buf[PERF_REF_WORDS];
+
+    for (uint32_t r = 0; r < PERF_REF_ROUNDS; r++)
+    {
+        uint64_t t0 = Sim_NowNs();
+        uint32_t h  = 2166136261U;
+        for (uint32_t i = 0; i < PERF_REF_WORDS; i++)
+        {
+            h = (h ^ (buf[i] + i)) * 16777619U;
+        }
+        _hostRefSink = h;
+        Perf_Sample(Sim_NowNs() - t0);
+    }
+
+    qsort(_sample, _samples, sizeof(_sample[0]), Perf_Cmp);
+    if (_hostRefNs == 0U || _sample[_samples / 2U] < _hostRefNs) _hostRefNs = _sample[_samples / 2U];
+    _samples = 0;
+}
+
+/* ─────────────────────────────────────────────────
+ * TX submit and log record cost — direct calls
+ * ───────────────────────────────────────────────── */
+static void Perf_TxSubmit(void)
+{
+    static const uint8_t data[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    for (uint32_t i = 0; i < PERF_TX_SUBMITS; i++)
+    {
+        if (i % 3U == 0U) Perf_WaitTxIdle();
+
+        uint64_t t0 = Sim_NowNs();
+        CAN_App_Transmit(PERF_UNKNOWN_ID + 1U, data, 8);
+        Perf_Sample(Sim_NowNs() - t0);
+    }
+    Perf_Latency("tx_submit_ns");
+}
+
+static void Perf_LogRecord(void)
+{
+    for (uint32_t i = 0; i < PERF_LOG_RECORDS; i++)
+    {
+        uint64_t t0 = Sim_NowNs();
+        UART_Log("PERF", "Node 5 RPM: 1000 (950..1050)");
+        Perf_Sample(Sim_NowNs() - t0);
+    }
+    Perf_Latency("log_record_ns");
+
+    for (uint32_t i = 0; i < PERF_LOG_RECORDS; i++)
+    {
+        uint64_t t0 = Sim_NowNs();
+        UART_Log_Int("PERF", "COMMAND", (int)i);
+        Perf_Sample(Sim_NowNs() - t0);
+    }
+    Perf_Latency("log_int_ns");
+}
+
+/* ─────────────────────────────────────────────────
+ * Dispatch cost — frames are posted straight to the RX
+ * active object, as the ISR would leave them, while this
+ * task holds the CPU; then the RX thread has them all to itself
+ * ───────────────────────────────────────────────── */
+static uint32_t Perf_QueueBatch(const Perf_Frame_t *f)
+{
+    uint32_t queued = 0;
+
+    for (uint32_t i = 0; i < f->batch; i++)
+    {
+        CAN_Frame_t *frame = CAN_Frame_Alloc();
+        if (frame == NULL) break;
+
+        frame->id   = f->id;
+        frame->dlc  = f->dlc;
+        frame->rxUs = (uint32_t)(Sim_NowNs() / 1000U);
+        memcpy(frame->data, f->data, sizeof(frame->data));
+
+        if (!CAN_App_PostFrame(frame))
+        {
+            CAN_Frame_Free(frame);
+            break;
+        }
+        queued++;
+    }
+    return queued;
+}
+
+static void Perf_Dispatch(void)
+{
+    char name[40];
+
+    for (uint32_t k = 0; k < COUNT_OF(_dispatch); k++)
+    {
+        const Perf_Frame_t *f = &_dispatch[k];
+
+        /* First sighting work (subscriptions, "online" logs) stays out */
+        Perf_WaitTxIdle();
+        Perf_QueueBatch(f);
+        Perf_Settle();
+
+        for (uint32_t r = 0; r < PERF_DISPATCH_ROUNDS; r++)
+        {
+            Perf_WaitTxIdle();
+
+            uint32_t n  = Perf_QueueBatch(f);
+            uint64_t t0 = Sim_NowNs();
+            uint64_t t1 = Perf_Settle();
+
+            if (n > 0U) Perf_Sample((t1 - t0) / n);
+        }
+        snprintf(name, sizeof(name), "dispatch_ns.%s", f->name);
+        Perf_Latency(name);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * RX throughput — bursts through the bxCAN model, one
+ * frame per RX interrupt, until every handler is done
+ * ───────────────────────────────────────────────── */
+static void Perf_RxThroughput(void)
+{
+    Perf_Frame_t burst[PERF_RX_BURST];
+    uint32_t read0, read1;
+    uint32_t drop0 = CAN_FramePoolStats.exhausted + CAN_FramePoolStats.queueFull;
+    uint32_t overruns = 0;
+
+    for (uint32_t i = 0; i < PERF_RX_BURST; i++) burst[i] = _rxMix[i % COUNT_OF(_rxMix)];
+
+    Perf_Inject(burst, PERF_RX_BURST);
+    Perf_Settle();
+    read0 = Sim_CAN_RxRead() + Sim_CAN_RxFiltered();
+
+    for (uint32_t r = 0; r < PERF_RX_BURSTS; r++)
+    {
+        Perf_WaitTxIdle();
+        CAN1->RF0R &= ~CAN_RF0R_FOVR0;
+
+        uint64_t t0 = Sim_NowNs();
+        Perf_Inject(burst, PERF_RX_BURST);
+        uint64_t t1 = Perf_Settle();
+
+        if ((CAN1->RF0R & CAN_RF0R_FOVR0) != 0U) overruns++;
+        Perf_Sample((t1 - t0) / PERF_RX_BURST);
+    }
+
+    read1 = Sim_CAN_RxRead() + Sim_CAN_RxFiltered();    /* A filtered frame is handled, not lost */
+    const Perf_Metric_t *lat = Perf_Latency("rx_frame_ns");
+
+    Perf_Metric_t *m = Perf_Add("rx_frames_per_s", "frames/s", true);
+    if (m == NULL) return;
+
+    uint32_t frames = PERF_RX_BURSTS * PERF_RX_BURST;
+    uint32_t seen   = read1 - read0;
+
+    m->n     = frames;
+    /* From the median burst, like rx_frame_ns; one host stall in the
+     * summed time would otherwise decide the figure */
+    m->value = (lat != NULL && lat->p50 > 0U) ? 1e9 / (double)lat->p50 : 0.0;
+    m->lost  = (frames > seen ? frames - seen : 0U) + overruns +
+               (CAN_FramePoolStats.exhausted + CAN_FramePoolStats.queueFull - drop0);
+}
+
+/* ─────────────────────────────────────────────────
+ * Command path under load — from the frame that asks
+ * for it to the end of the answer on the bus
+ * ───────────────────────────────────────────────── */
+static uint64_t Perf_CommandOnce(void)
+{
+    Perf_WaitTxIdle();
+
+    _replyNs = 0;
+    _replyId = PERF_CMD_REPLY_ID;
+
+    uint64_t t0 = Sim_NowNs();
+    Perf_Inject(&_cmd, 1);
+
+    for (uint32_t ms = 0; _replyNs == 0U && ms < PERF_CMD_TIMEOUT_MS; ms++) vTaskDelay(1);
+
+    uint64_t ns = _replyNs != 0U ? _replyNs - t0 : 0U;
+    _replyId = UINT32_MAX;
+    vTaskDelay(PERF_CMD_GAP_MS);
+    return ns;
+}
+
+static void Perf_Command(void)
+{
+    uint32_t lost = 0;
+
+    /* The controller subscribes to a node it has not seen first */
+    Perf_CommandOnce();
+
+    for (uint32_t r = 0; r < PERF_CMD_ROUNDS; r++)
+    {
+        uint64_t ns = Perf_CommandOnce();
+
+        if (ns == 0U) lost++;
+        else          Perf_Sample(ns);
+    }
+
+    Perf_Metric_t *m = Perf_Latency(_cmd.name);
+    if (m != NULL)
+    {
+        m->lost     = lost;
+        m->busTimed = true;
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Background load — other nodes' aggregates, paced on
+ * host time, taken in by the NVIC on its next pass
+ * ───────────────────────────────────────────────── */
+static void *Perf_LoadThread(void *arg)
+{
+    struct timespec next;
+    uint32_t seq = 0;
+
+    (void)arg;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    for (;;)
+    {
+        uint32_t period = atomic_load(&_loadPeriodNs);
+
+        if (period == 0U)
+        {
+            struct timespec idle = { 0, 1000000L };
+            nanosleep(&idle, NULL);
+            clock_gettime(CLOCK_MONOTONIC, &next);
+            continue;
+        }
+
+        next.tv_nsec += (long)period;
+        while (next.tv_nsec >= 1000000000L) { next.tv_nsec -= 1000000000L; next.tv_sec++; }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+        /* Any node but the one being measured, values inside the limits */
+        uint8_t node = (uint8_t)(1U + seq % (CAN_MAX_SENSOR_NODES - 1U));
+        if (node == PERF_TARGET_NODE) node = 0U;
+
+        Perf_Frame_t f = { "load", CAN_ID_DATA(node, (seq & 1U) ? CAN_FN_TEMP_AGG : CAN_FN_RPM_AGG), 8,
+                           { 0x00, 0x28, 0x00, 0x28, 0x00, 0x28, 0x00, 0x28 }, 0 };
+        if ((seq & 1U) == 0U)
+        {
+            for (uint32_t i = 0; i < 8; i += 2) { f.data[i] = 0x03; f.data[i + 1] = 0xE8; }
+        }
+        seq++;
+
+        Sim_RxItem_t item = Perf_Item(&f);
+        if (Sim_RxRingPut(&_loadRing, &item)) atomic_fetch_add(&_loadFrames, 1U);
+        else                                  atomic_fetch_add(&_loadLost, 1U);
+    }
+    return NULL;
+}
+
+static void Perf_SetLoad(uint32_t pct)
+{
+    static const Sim_CanFrame_t f = { .id = CAN_ID_DATA(1, CAN_FN_RPM_AGG), .dlc = 8 };
+    uint64_t fps = (uint64_t)CAN_Bitrate.active * pct / 100U / VCAN_FrameBits(&f, NULL);
+
+    atomic_store(&_loadPeriodNs, fps > 0U ? (uint32_t)(1000000000ULL / fps) : 0U);
+}
+
+/* ─────────────────────────────────────────────────
+ * Perf_Write — one JSON document
+ * ───────────────────────────────────────────────── */
+static void Perf_Write(void)
+{
+    const char *path = getenv("SIM_PERF_OUT");
+    const char *pace = getenv("SIM_UART_PACE");
+    FILE *out = stderr;
+
+    if (path != NULL && (out = fopen(path, "w")) == NULL)
+    {
+        perror(path);
+        out = stderr;
+    }
+
+    fprintf(out, "{\n  \"node\": \"%s\",\n", PERF_NODE);
+    fprintf(out, "  \"config\": { \"bitrate\": %lu, \"load_pct\": %lu, \"uart_paced\": %s },\n",
+            (unsigned long)CAN_Bitrate.active, (unsigned long)_loadPct,
+            (pace != NULL && strcmp(pace, "0") == 0) ? "false" : "true");
+    fprintf(out, "  \"host_ref_ns\": %lu,\n", (unsigned long)_hostRefNs);
+    fprintf(out, "  \"load\": { \"frames\": %lu, \"lost\": %lu },\n",
+            (unsigned long)atomic_load(&_loadFrames), (unsigned long)atomic_load(&_loadLost));
+    fprintf(out, "  \"metrics\": {\n");
+
+    for (uint32_t i = 0; i < _metrics; i++)
+    {
+        const Perf_Metric_t *m = &_metric[i];
+
+        fprintf(out, "    \"%s\": { \"value\": %.1f, \"unit\": \"%s\", \"better\": \"%s\", \"clock\": \"%s\", \"n\": %lu",
+                m->name, m->value, m->unit, m->higherBetter ? "higher" : "lower",
+                m->busTimed ? "bus" : "host", (unsigned long)m->n);
+        if (!m->higherBetter)
+        {
+            fprintf(out, ", \"min\": %lu, \"p50\": %lu, \"p99\": %lu, \"max\": %lu, \"mean\": %.1f",
+                    (unsigned long)m->min, (unsigned long)m->p50, (unsigned long)m->p99,
+                    (unsigned long)m->max, m->mean);
+        }
+        fprintf(out, ", \"lost\": %lu }%s\n", (unsigned long)m->lost, i + 1U < _metrics ? "," : "");
+    }
+    fprintf(out, "  }\n}\n");
+
+    if (out != stderr) fclose(out);
+}
+
+/* ─────────────────────────────────────────────────
+ * Perf_Task — the whole run, then the process exits
+ * ───────────────────────────────────────────────── */
+static void Perf_Task(void *argument)
+{
+    (void)argument;
+
+    vTaskDelay(pdMS_TO_TICKS(PERF_SETTLE_MS));
+
+    Perf_HostRef();
+    Perf_TxSubmit();
+    Perf_LogRecord();
+    Perf_Dispatch();
+    Perf_RxThroughput();
+
+    Perf_SetLoad(_loadPct);
+    vTaskDelay(pdMS_TO_TICKS(PERF_LOAD_SETTLE_MS));
+    Perf_Command();
+    Perf_SetLoad(0U);
+    Perf_HostRef();
+
+    Perf_Write();
+    fflush(stdout);
+
+    uint32_t lost = 0;
+    for (uint32_t i = 0; i < _metrics; i++) lost += _metric[i].lost;
+    _exit(lost == 0U ? 0 : 2);
+}
+
+/* ── Bus Backend ─────────────────────────────── */
+static bool Perf_Open(void)
+{
+    const char *load = getenv("SIM_PERF_LOAD");
+
+    if (load != NULL)
+    {
+        _loadPct = (uint32_t)strtoul(load, NULL, 10);
+        if (_loadPct > 100U) _loadPct = 100U;
+    }
+
+    _perfTask = xTaskCreateStatic(Perf_Task, "PERF",
+                                  sizeof(_perfTaskStack) / sizeof(_perfTaskStack[0]),
+                                  NULL, configMAX_PRIORITIES - 2, _perfTaskStack, &_perfTaskCb);
+    _idleTask = xTaskCreateStatic(Perf_IdleTask, "PERF_IDLE",
+                                  sizeof(_idleTaskStack) / sizeof(_idleTaskStack[0]),
+                                  NULL, tskIDLE_PRIORITY + 1, _idleTaskStack, &_idleTaskCb);
+
+    return _perfTask != NULL && _idleTask != NULL && Sim_StartThread(Perf_LoadThread);
+}
+
+/* Every frame is ACKed; commands are answered like a sensor would */
+static bool Perf_Send(const Sim_CanFrame_t *frame, uint32_t bitrate, uint64_t timeNs)
+{
+    _sent++;
+
+    if (frame->ide || frame->rtr) return true;
+
+    if (frame->id == _replyId && _replyNs == 0U) _replyNs = timeNs;
+
+    if (CAN_ID_IS_CMD(frame->id) && CAN_ID_CMD_FN(frame->id) == CAN_FN_COMMAND)
+    {
+        Perf_Frame_t ack = { "ack", CAN_ID_CMD(CAN_ID_CMD_NODE(frame->id), CAN_FN_ACK), 1,
+                             { frame->data[0] }, 1 };
+        Sim_RxItem_t item = Perf_Item(&ack);
+        Sim_RxRingPut(&_replyRing, &item);
+    }
+    return true;
+}
+
+static bool Perf_Poll(Sim_CanFrame_t *frame, uint32_t *bitrate, uint64_t *timeNs)
+{
+    Sim_RxItem_t item;
+
+    if (!Sim_RxRingGet(&_injectRing, &item) &&
+        !Sim_RxRingGet(&_replyRing, &item) &&
+        !Sim_RxRingGet(&_loadRing, &item))
+    {
+        return false;
+    }
+
+    *frame   = item.frame;
+    *bitrate = 0U;
+    *timeNs  = item.timeNs;
+    return true;
+}
+
+const Sim_CanBus_t Sim_CanBusPerf = {
+    .name = "perf",
+    .open = Perf_Open,
+    .send = Perf_Send,
+    .poll = Perf_Poll,
+};
@@ -0,0 +1,68 @@
+import argparse
+import json
+import sys
+
+# Compares a perf run (sim/perf/perf.c) against a stored baseline.
+# A metric regresses when it moves the wrong way by more than the
+# tolerance; lost frames or unanswered commands always fail.
+# Metrics on the host clock are first scaled by host_ref_ns, the same
+# fixed loop timed in both runs, so machine speed drops out.
+# Exit status 1 on any regression, so make perf stops there.
+
+def load(path):
+    with open(path) as f:
+        return json.load(f)
+
+def main():
+    parser = argparse.ArgumentParser(description='Check perf results against a baseline')
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    parser.add_argument('--tolerance', type=float, default=0.25,
+                        help='allowed relative change, default 0.25')
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    cur = load(args.current)
+    failed = False
+
+    print(f"Node {cur['node']}: {args.current} vs {args.baseline}")
+    if base['config'] != cur['config']:
+        print(f"  note: config differs, baseline {base['config']} now {cur['config']}")
+
+    scale = 1.0
+    if base.get('host_ref_ns') and cur.get('host_ref_ns'):
+        scale = base['host_ref_ns'] / cur['host_ref_ns']
+        print(f"  host reference {base['host_ref_ns']} ns -> {cur['host_ref_ns']} ns, host timings x{scale:.2f}")
+
+    print(f"  {'metric':<28} {'baseline':>12} {'current':>12} {'change':>8}")
+    for name, b in base['metrics'].items():
+        c = cur['metrics'].get(name)
+        if c is None:
+            print(f"  {name:<28} {b['value']:>12.0f} {'missing':>12}          REGRESSION")
+            failed = True
+            continue
+
+        value = c['value']
+        if c.get('clock', 'host') == 'host':
+            value = value / scale if b['better'] == 'higher' else value * scale
+
+        change = (value - b['value']) / b['value'] if b['value'] else 0.0
+        worse = -change if b['better'] == 'higher' else change
+        status = ''
+        if worse > args.tolerance:
+            status = 'REGRESSION'
+        elif worse < -args.tolerance:
+            status = 'faster (perf-baseline to keep)'
+        if c.get('lost', 0) > b.get('lost', 0):
+            status = f"REGRESSION ({c['lost']} lost)"
+        failed |= status.startswith('REGRESSION')
+
+        print(f"  {name:<28} {b['value']:>12.0f} {value:>12.0f} {change:>+8.1%}  {status}")
+
+    for name in cur['metrics'].keys() - base['metrics'].keys():
+        print(f"  {name:<28} {'new':>12} {cur['metrics'][name]['value']:>12.0f}")
+
+    return 1 if failed else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,52 @@
+import json
+import sys
+
+# Folds several perf runs of one node (sim/perf/perf.c) into one
+# document, written to stdout in perf.c's layout. Each metric keeps
+# the run with its median value, so one run hit by a host stall does
+# not decide the number; lost counts keep the worst run.
+
+def load(path):
+    with open(path) as f:
+        return json.load(f)
+
+def median(docs, key):
+    ranked = sorted(docs, key=key)
+    return ranked[(len(ranked) - 1) // 2]
+
+def inline(obj):
+    return '{ ' + ', '.join(f'{json.dumps(k)}: {json.dumps(v)}' for k, v in obj.items()) + ' }'
+
+def main():
+    if len(sys.argv) < 2:
+        print('usage: perf_merge.py run.json...', file=sys.stderr)
+        return 2
+
+    runs = [load(path) for path in sys.argv[1:]]
+    first = runs[0]
+
+    metrics = {}
+    for name in first['metrics']:
+        have = [r['metrics'][name] for r in runs if name in r['metrics']]
+        m = dict(median(have, lambda m: m['value']))
+        m['lost'] = max(h.get('lost', 0) for h in have)
+        metrics[name] = m
+
+    load_ = dict(first['load'])
+    load_['lost'] = max(r['load']['lost'] for r in runs)
+
+    print('{')
+    print(f'  "node": {json.dumps(first["node"])},')
+    print(f'  "config": {inline(first["config"])},')
+    print(f'  "host_ref_ns": {median(runs, lambda r: r["host_ref_ns"])["host_ref_ns"]},')
+    print(f'  "runs": {len(runs)},')
+    print(f'  "load": {inline(load_)},')
+    print('  "metrics": {')
+    for i, (name, m) in enumerate(metrics.items()):
+        print(f'    {json.dumps(name)}: {inline(m)}{"," if i + 1 < len(metrics) else ""}')
+    print('  }')
+    print('}')
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,46 @@
+/*
+ * test.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Minimal check macros for the host tests. A failed CHECK prints
+ *  where and carries on; TEST_DONE prints the tally and is the exit
+ *  status of main.
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+
+static int _testChecks;
+static int _testFailed;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        _testChecks++;                                                      \
+        if (!(cond))                                                        \
+        {                                                                   \
+            _testFailed++;                                                  \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);        \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                          \
+    do {                                                                    \
+        long long _a = (long long)(actual), _e = (long long)(expected);     \
+        _testChecks++;                                                      \
+        if (_a != _e)                                                       \
+        {                                                                   \
+            _testFailed++;                                                  \
+            printf("  FAIL %s:%d: %s == %lld, expected %lld\n",             \
+                   __FILE__, __LINE__, #actual, _a, _e);                    \
+        }                                                                   \
+    } while (0)
+
+#define TEST_DONE(name)                                                     \
+    (printf("%s: %d checks, %d failed\n", (name), _testChecks, _testFailed), \
+     _testFailed != 0)
+
+#endif /* TEST_H_ */
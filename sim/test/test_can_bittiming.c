@@ -0,0 +1,108 @@
+/*
+ * test_can_bittiming.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  can_bittiming.h/.c at the 45 MHz APB1 clock: the four supported
+ *  bitrates against hand-checked register values, the compile-time
+ *  table against the runtime solver, and bitrates the bxCAN cannot
+ *  reach. Both nodes build the same solver.
+ */
+
+
+#include "can_bittiming.h"
+#include "test.h"
+
+/* Bits per second the solution actually produces */
+static uint32_t Achieved(const CAN_BitTiming_t *bt)
+{
+    return CAN_CLOCK_HZ / (bt->prescaler * (1U + bt->tseg1 + bt->tseg2));
+}
+
+static void Expect(uint32_t br, uint16_t prescaler, uint8_t tseg1, uint8_t tseg2,
+                   uint8_t sjw, uint16_t samplePermille)
+{
+    CAN_BitTiming_t bt;
+
+    CHECK(CAN_BitTiming_Solve(CAN_CLOCK_HZ, br, CAN_SAMPLE_POINT_PERMILLE, &bt));
+    CHECK_EQ(bt.bitrate, br);
+    CHECK_EQ(bt.prescaler, prescaler);
+    CHECK_EQ(bt.tseg1, tseg1);
+    CHECK_EQ(bt.tseg2, tseg2);
+    CHECK_EQ(bt.sjw, sjw);
+    CHECK_EQ(bt.samplePermille, samplePermille);
+    CHECK_EQ(Achieved(&bt), br);
+}
+
+/* ─────────────────────────────────────────────────
+ * Cases
+ * ───────────────────────────────────────────────── */
+static void Test_Supported(void)
+{
+    /* 1M: 3 × 15 Tq, sample at 13/15; the rest: 18 Tq, 16/18 */
+    Expect(1000000U,  3, 12, 2, 2, 866);
+    Expect(500000U,   5, 15, 2, 2, 888);
+    Expect(250000U,  10, 15, 2, 2, 888);
+    Expect(125000U,  20, 15, 2, 2, 888);
+}
+
+static void Test_TableMatchesSolver(void)
+{
+    CHECK_EQ(CAN_BitTimingCount, 4);
+
+    for (uint8_t i = 0; i < CAN_BitTimingCount; i++)
+    {
+        const CAN_BitTiming_t *t = &CAN_BitTimings[i];
+        CAN_BitTiming_t bt;
+
+        CHECK(CAN_BitTiming_Solve(CAN_CLOCK_HZ, t->bitrate, CAN_SAMPLE_POINT_PERMILLE, &bt));
+        CHECK_EQ(t->prescaler, bt.prescaler);
+        CHECK_EQ(t->tseg1, bt.tseg1);
+        CHECK_EQ(t->tseg2, bt.tseg2);
+        CHECK_EQ(t->sjw, bt.sjw);
+        CHECK_EQ(t->samplePermille, bt.samplePermille);
+        CHECK(CAN_BitTiming_Find(t->bitrate) == t);
+    }
+}
+
+/* 45 MHz / 800k is 56.25 clocks a bit; 1 kbit/s needs a prescaler
+ * over 1024 at any Tq count */
+static void Test_Impossible(void)
+{
+    CAN_BitTiming_t bt;
+
+    CHECK(!CAN_BitTiming_Solve(CAN_CLOCK_HZ, 800000U, CAN_SAMPLE_POINT_PERMILLE, &bt));
+    CHECK(!CAN_BitTiming_Solve(CAN_CLOCK_HZ, 83333U, CAN_SAMPLE_POINT_PERMILLE, &bt));
+    CHECK(!CAN_BitTiming_Solve(CAN_CLOCK_HZ, 1000U, CAN_SAMPLE_POINT_PERMILLE, &bt));
+    CHECK_EQ(CAN_BT_NTQ(CAN_CLOCK_HZ, 800000U, CAN_SAMPLE_POINT_PERMILLE), 0);
+
+    CHECK(!CAN_BitTiming_Solve(CAN_CLOCK_HZ, 0U, CAN_SAMPLE_POINT_PERMILLE, &bt));
+    CHECK(!CAN_BitTiming_Solve(CAN_CLOCK_HZ, 500000U, 0U, &bt));
+    CHECK(!CAN_BitTiming_Solve(CAN_CLOCK_HZ, 500000U, 1000U, &bt));
+
+    CHECK(CAN_BitTiming_Find(800000U) == NULL);
+}
+
+/* Other sample points move TSEG1/TSEG2, not the bitrate */
+static void Test_SamplePoint(void)
+{
+    CAN_BitTiming_t bt;
+
+    CHECK(CAN_BitTiming_Solve(CAN_CLOCK_HZ, 500000U, 750U, &bt));
+    CHECK_EQ(bt.prescaler, 5);
+    CHECK_EQ(bt.tseg1, 13);
+    CHECK_EQ(bt.tseg2, 4);
+    CHECK_EQ(bt.sjw, 4);
+    CHECK_EQ(Achieved(&bt), 500000U);
+}
+
+int main(void)
+{
+    Test_Supported();
+    Test_TableMatchesSolver();
+    Test_Impossible();
+    Test_SamplePoint();
+
+    return TEST_DONE("can_bittiming");
+}
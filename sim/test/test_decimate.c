@@ -0,0 +1,157 @@
+/*
+ * test_decimate.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  decimate.c fed from sensor_sim.c, as acq.c does on target: one
+ *  sample per millisecond, 100 ms broadcast windows. The expected
+ *  values are worked out from the trace formula by hand.
+ */
+
+
+#include "decimate.h"
+#include "sensor_sim.h"
+#include "test.h"
+
+#define TEST_STEP_MS            100U    /* OD_txPeriodMs default */
+
+/* One broadcast window of the synthetic trace, a sample per ms */
+static void Window(uint32_t startMs, uint32_t lengthMs, Dec_Window_t *rpm, Dec_Window_t *temp)
+{
+    Dec_Reset(rpm);
+    Dec_Reset(temp);
+    for (uint32_t ms = startMs; ms < startMs + lengthMs; ms++)
+    {
+        int32_t r, t;
+
+        Sim_Sample(ms, TEST_STEP_MS, &r, &t);
+        Dec_Push(rpm, r);
+        Dec_Push(temp, t);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Cases
+ * ───────────────────────────────────────────────── */
+static void Test_Empty(void)
+{
+    Dec_Window_t w;
+
+    Dec_Reset(&w);
+    CHECK_EQ(w.count, 0);
+    CHECK_EQ(Dec_Mean(&w), 0);
+
+    Dec_Push(&w, -7);
+    CHECK_EQ(w.min, -7);
+    CHECK_EQ(w.max, -7);
+    CHECK_EQ(w.last, -7);
+    CHECK_EQ(Dec_Mean(&w), -7);
+}
+
+static void Test_MeanRounding(void)
+{
+    Dec_Window_t w;
+
+    Dec_Reset(&w);
+    Dec_Push(&w, 1);
+    Dec_Push(&w, 2);
+    CHECK_EQ(Dec_Mean(&w), 2);          /* 1.5, half away from zero */
+
+    Dec_Reset(&w);
+    Dec_Push(&w, -1);
+    Dec_Push(&w, -2);
+    CHECK_EQ(Dec_Mean(&w), -2);
+
+    Dec_Reset(&w);
+    Dec_Push(&w, 1);
+    Dec_Push(&w, 1);
+    Dec_Push(&w, 2);
+    CHECK_EQ(Dec_Mean(&w), 1);          /* 1.33 */
+}
+
+/* A window with no spike: the ramp holds, noise is ±16 */
+static void Test_QuietWindow(void)
+{
+    Dec_Window_t rpm, temp;
+
+    Window(3600, 100, &rpm, &temp);
+    CHECK_EQ(rpm.count, 100);
+    CHECK_EQ(rpm.min, 4384);
+    CHECK_EQ(rpm.max, 4415);
+    CHECK_EQ(Dec_Mean(&rpm), 4399);
+    CHECK_EQ(rpm.last, 4387);
+
+    CHECK_EQ(temp.min, 61);
+    CHECK_EQ(temp.max, 61);
+    CHECK_EQ(Dec_Mean(&temp), 61);
+    CHECK_EQ(temp.last, 61);
+}
+
+/* The 4 ms spike at 3700 ms: max and mean catch it, last does not */
+static void Test_SpikeWindow(void)
+{
+    Dec_Window_t rpm, temp;
+
+    Window(3700, 100, &rpm, &temp);
+    CHECK_EQ(rpm.min, 4484);
+    CHECK_EQ(rpm.max, 7014);
+    CHECK_EQ(Dec_Mean(&rpm), 4600);     /* 4 × 2500 over 100 samples */
+    CHECK_EQ(rpm.last, 4513);
+    CHECK(rpm.last < 4500 + SIM_RPM_NOISE);     /* Back on the ramp */
+
+    /* Change of value against the last broadcast (4399) sees the spike */
+    CHECK_EQ(Dec_Extreme(&rpm, 4399), 7014);
+
+    CHECK_EQ(temp.last, 62);
+}
+
+/* Ten 10 ms windows merged equal the 100 ms window */
+static void Test_Merge(void)
+{
+    Dec_Window_t whole, wholeTemp, merged, part, partTemp;
+
+    Window(3700, 100, &whole, &wholeTemp);
+
+    Dec_Reset(&merged);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Window(3700 + i * 10, 10, &part, &partTemp);
+        Dec_Merge(&merged, &part);
+    }
+    CHECK_EQ(merged.count, whole.count);
+    CHECK_EQ(merged.sum, whole.sum);
+    CHECK_EQ(merged.min, whole.min);
+    CHECK_EQ(merged.max, whole.max);
+    CHECK_EQ(merged.last, whole.last);
+
+    /* An empty source changes nothing */
+    Dec_Reset(&part);
+    Dec_Merge(&merged, &part);
+    CHECK_EQ(merged.count, 100);
+    CHECK_EQ(merged.last, 4513);
+}
+
+static void Test_Extreme(void)
+{
+    Dec_Window_t w;
+
+    Dec_Reset(&w);
+    Dec_Push(&w, 90);
+    Dec_Push(&w, 130);
+    CHECK_EQ(Dec_Extreme(&w, 100), 130);
+    CHECK_EQ(Dec_Extreme(&w, 120), 90);
+    CHECK_EQ(Dec_Extreme(&w, 110), 130);    /* Tie goes to max */
+}
+
+int main(void)
+{
+    Test_Empty();
+    Test_MeanRounding();
+    Test_QuietWindow();
+    Test_SpikeWindow();
+    Test_Merge();
+    Test_Extreme();
+
+    return TEST_DONE("decimate");
+}
@@ -0,0 +1,227 @@
+/*
+ * test_filter.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  filter.c on the host, with the __SSAT stand-in it defines off
+ *  target. Median and moving average are checked against a plain
+ *  recomputation over the same window, the biquads against their
+ *  DC gain.
+ */
+
+
+#include "filter.h"
+#include "test.h"
+
+#define TEST_SAMPLES            200U
+
+/* Deterministic q15 input with repeats, so the median sees ties */
+static q15_t Input(uint32_t n)
+{
+    static uint32_t seed;
+
+    if (n == 0) seed = 12345U;
+    seed = seed * 1103515245U + 12345U;
+    return (q15_t)((int32_t)(seed >> 16) % 2000 - 1000) & ~3;
+}
+
+/* ─────────────────────────────────────────────────
+ * Reference implementations
+ * ───────────────────────────────────────────────── */
+static q15_t BruteMedian(const q15_t *hist, uint32_t count, uint8_t length)
+{
+    q15_t    w[FILT_MEDIAN_MAX];
+    uint32_t n = (count < length) ? count : length;
+
+    for (uint32_t i = 0; i < n; i++) w[i] = hist[count - n + i];
+    for (uint32_t i = 1; i < n; i++)
+    {
+        for (uint32_t j = i; j > 0 && w[j - 1] > w[j]; j--)
+        {
+            q15_t t = w[j];
+            w[j] = w[j - 1];
+            w[j - 1] = t;
+        }
+    }
+    return w[n / 2];
+}
+
+static int32_t WindowSum(const q15_t *hist, uint32_t count, uint8_t length)
+{
+    int32_t sum = 0;
+
+    for (uint32_t i = count - length; i < count; i++) sum += hist[i];
+    return sum;
+}
+
+/* ─────────────────────────────────────────────────
+ * Cases
+ * ───────────────────────────────────────────────── */
+static void Test_MedianOdd(void)
+{
+    for (uint8_t length = 3; length <= FILT_MEDIAN_MAX; length += 2)
+    {
+        Filt_t f;
+        q15_t  hist[TEST_SAMPLES];
+        int    mismatches = 0;
+
+        CHECK_EQ(Filt_Configure(&f, FILT_MEDIAN, length), FILT_MEDIAN);
+        for (uint32_t n = 0; n < TEST_SAMPLES; n++)
+        {
+            hist[n] = Input(n);
+            if (Filt_Process(&f, hist[n]) != BruteMedian(hist, n + 1, length)) mismatches++;
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+}
+
+/* A single spike shorter than half the window never gets through */
+static void Test_MedianSpike(void)
+{
+    Filt_t f;
+
+    Filt_Configure(&f, FILT_MEDIAN, 5);
+    for (uint32_t n = 0; n < 10; n++) Filt_Process(&f, 100);
+    CHECK_EQ(Filt_Process(&f, 30000), 100);
+    CHECK_EQ(Filt_Process(&f, 30000), 100);
+    CHECK_EQ(Filt_Process(&f, 100), 100);
+}
+
+static void Test_MovAvgFull(void)
+{
+    for (uint8_t length = 1; length <= FILT_MOVAVG_MAX; length++)
+    {
+        Filt_t f;
+        q15_t  hist[TEST_SAMPLES];
+        int    offByMore = 0;
+
+        Filt_Configure(&f, FILT_MOVAVG, length);
+        for (uint32_t n = 0; n < TEST_SAMPLES; n++)
+        {
+            hist[n] = Input(n);
+            int32_t y = Filt_Process(&f, hist[n]);
+
+            /* Q15 reciprocal: within one count of the exact mean */
+            if (n + 1 >= length)
+            {
+                int32_t d = y * length - WindowSum(hist, n + 1, length);
+                if (d < -length || d > length) offByMore++;
+            }
+        }
+        CHECK_EQ(offByMore, 0);
+    }
+}
+
+static void Test_MovAvgFilling(void)
+{
+    Filt_t f;
+
+    Filt_Configure(&f, FILT_MOVAVG, 4);
+    CHECK_EQ(Filt_Process(&f, 100), 100);   /* First output is the first input */
+    CHECK_EQ(Filt_Process(&f, 200), 150);
+    CHECK_EQ(Filt_Process(&f, 300), 200);
+    CHECK_EQ(Filt_Process(&f, 400), 250);   /* Full */
+    CHECK_EQ(Filt_Process(&f, 500), 350);   /* 100 dropped */
+}
+
+/* Full scale stays in range: the reciprocal rounds up, __SSAT clamps */
+static void Test_MovAvgSaturate(void)
+{
+    Filt_t f;
+
+    Filt_Configure(&f, FILT_MOVAVG, 3);
+    for (uint32_t n = 0; n < 6; n++)
+    {
+        CHECK_EQ(Filt_Process(&f, 32767), 32767);
+    }
+    for (uint32_t n = 0; n < 6; n++) Filt_Process(&f, -32768);
+    CHECK_EQ(Filt_Process(&f, -32768), -32768);
+}
+
+/* Every tabulated cutoff settles on the input after a step */
+static void Test_BiquadDcGain(void)
+{
+    static const uint16_t cutoffs[] = { 5, 10, 20, 50, 100, 200 };
+    static const q15_t    levels[]  = { 10000, -10000, 32000, 1 };
+
+    for (uint32_t c = 0; c < sizeof(cutoffs) / sizeof(cutoffs[0]); c++)
+    {
+        for (uint32_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++)
+        {
+            Filt_t f;
+            q15_t  y = 0;
+
+            CHECK_EQ(Filt_Configure(&f, FILT_IIR, cutoffs[c]), FILT_IIR);
+            CHECK_EQ(Filt_Process(&f, 0), 0);
+            for (uint32_t n = 0; n < 2000; n++) y = Filt_Process(&f, levels[l]);
+            CHECK_EQ(y, levels[l]);
+        }
+    }
+}
+
+/* A constant first input starts at steady state — no ramp from zero */
+static void Test_BiquadStart(void)
+{
+    Filt_t f;
+
+    Filt_Configure(&f, FILT_IIR, 5);
+    CHECK_EQ(Filt_Process(&f, 5000), 5000);
+    CHECK_EQ(Filt_Process(&f, 5000), 5000);
+}
+
+/* Cutoffs between table entries round down to the one below */
+static void Test_BiquadRounding(void)
+{
+    Filt_t a, b;
+
+    Filt_Configure(&a, FILT_IIR, 7);
+    Filt_Configure(&b, FILT_IIR, 5);
+    CHECK(a.coef == b.coef);
+
+    Filt_Configure(&a, FILT_IIR, 1000);
+    Filt_Configure(&b, FILT_IIR, 200);
+    CHECK(a.coef == b.coef);
+}
+
+static void Test_Fallback(void)
+{
+    static const struct { Filt_Kind_t kind; uint16_t param; } bad[] = {
+        { FILT_MOVAVG, 0 },
+        { FILT_MOVAVG, FILT_MOVAVG_MAX + 1 },
+        { FILT_IIR,    4 },
+        { FILT_IIR,    0 },
+        { FILT_MEDIAN, 1 },
+        { FILT_MEDIAN, 4 },
+        { FILT_MEDIAN, FILT_MEDIAN_MAX + 2 },
+        { FILT_KIND_COUNT, 4 },
+        { (Filt_Kind_t)200, 4 },
+    };
+
+    for (uint32_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++)
+    {
+        Filt_t f;
+
+        CHECK_EQ(Filt_Configure(&f, bad[i].kind, bad[i].param), FILT_NONE);
+        CHECK_EQ(f.kind, FILT_NONE);
+        CHECK_EQ(Filt_Process(&f, -1234), -1234);
+        CHECK_EQ(Filt_Process(&f, 4321), 4321);
+    }
+
+    CHECK_EQ(Filt_Configure(&(Filt_t){ 0 }, FILT_NONE, 0), FILT_NONE);
+}
+
+int main(void)
+{
+    Test_MedianOdd();
+    Test_MedianSpike();
+    Test_MovAvgFull();
+    Test_MovAvgFilling();
+    Test_MovAvgSaturate();
+    Test_BiquadDcGain();
+    Test_BiquadStart();
+    Test_BiquadRounding();
+    Test_Fallback();
+
+    return TEST_DONE("filter");
+}
@@ -0,0 +1,160 @@
+/*
+ * test_flash_kv.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  flash_kv.c on the RAM stand-in port (flash_kv_port_ram.c, 256-byte
+ *  sectors, so 31 records each). A "reboot" is FKV_Init again over
+ *  the same sectors; FKV_RamFailAfter cuts power mid-program.
+ */
+
+
+#include "flash_kv.h"
+#include "test.h"
+#include <string.h>
+
+extern uint32_t FKV_RamEraseCount[2];
+extern int32_t  FKV_RamFailAfter;
+
+/* Blank device: both sectors erased, stats cleared */
+static void Blank(void)
+{
+    FKV_Flash.erase(0);
+    FKV_Flash.erase(1);
+    FKV_RamEraseCount[0] = FKV_RamEraseCount[1] = 0;
+    FKV_RamFailAfter     = -1;
+    memset(&FKV_Stats, 0, sizeof(FKV_Stats));
+    FKV_Init();
+}
+
+static void Reboot(void)
+{
+    memset(&FKV_Stats, 0, sizeof(FKV_Stats));
+    FKV_Init();
+}
+
+static uint32_t Get(uint16_t key)
+{
+    uint32_t value = 0xDEADBEEFU;
+    return FKV_Get(key, &value) ? value : 0xDEADBEEFU;
+}
+
+/* ─────────────────────────────────────────────────
+ * Cases
+ * ───────────────────────────────────────────────── */
+static void Test_Blank(void)
+{
+    uint32_t value;
+
+    Blank();
+    CHECK(!FKV_Get(1, &value));
+    CHECK_EQ(FKV_Stats.records, 0);
+    CHECK_EQ(FKV_Stats.capacity, 31);
+    CHECK_EQ(FKV_Stats.generation, 1);
+}
+
+static void Test_SetGetReboot(void)
+{
+    Blank();
+    CHECK(FKV_Set(1, 5000));
+    CHECK(FKV_Set(2, (uint32_t)-40));
+    CHECK(FKV_Set(1, 6000));            /* Later record wins */
+    CHECK_EQ(FKV_Stats.records, 3);
+
+    Reboot();
+    CHECK_EQ(Get(1), 6000);
+    CHECK_EQ((int32_t)Get(2), -40);
+    CHECK_EQ(FKV_Stats.records, 3);
+    CHECK_EQ(FKV_Stats.errors, 0);
+}
+
+static void Test_UnchangedAndBadKeys(void)
+{
+    Blank();
+    CHECK(FKV_Set(3, 200));
+    CHECK(FKV_Set(3, 200));             /* No second record */
+    CHECK_EQ(FKV_Stats.records, 1);
+    CHECK_EQ(FKV_Stats.writes, 1);
+
+    CHECK(!FKV_Set(0, 1));
+    CHECK(!FKV_Set(FKV_MAX_KEYS, 1));
+    CHECK_EQ(FKV_Stats.records, 1);
+}
+
+static void Test_Compaction(void)
+{
+    Blank();
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        CHECK(FKV_Set(1 + (i % 3), i));
+    }
+
+    /* 31 records per sector, 3 live after each compaction */
+    CHECK(FKV_Stats.compactions >= 3);
+    CHECK_EQ(FKV_Stats.generation, 1 + FKV_Stats.compactions);
+    CHECK(FKV_RamEraseCount[0] >= 2 && FKV_RamEraseCount[1] >= 1);
+    CHECK(FKV_RamEraseCount[0] - FKV_RamEraseCount[1] <= 1);   /* Alternating */
+
+    Reboot();
+    CHECK_EQ(Get(1), 99);
+    CHECK_EQ(Get(2), 97);
+    CHECK_EQ(Get(3), 98);
+    CHECK_EQ(FKV_Stats.errors, 0);
+}
+
+static void Test_TornAppend(void)
+{
+    Blank();
+    CHECK(FKV_Set(1, 100));
+
+    /* Power fails after the value word, before the key word */
+    FKV_RamFailAfter = 1;
+    CHECK(!FKV_Set(1, 200));
+    FKV_RamFailAfter = -1;
+
+    Reboot();
+    CHECK_EQ(Get(1), 100);
+    CHECK_EQ(FKV_Stats.errors, 1);      /* Burnt slot skipped */
+
+    /* The slot after the torn one is usable */
+    CHECK(FKV_Set(1, 300));
+    Reboot();
+    CHECK_EQ(Get(1), 300);
+}
+
+static void Test_TornCompaction(void)
+{
+    Blank();
+    for (uint32_t i = 0; i < 31; i++)
+    {
+        CHECK(FKV_Set(1, i));           /* Fills sector 0 exactly */
+    }
+    CHECK_EQ(FKV_Stats.compactions, 0);
+
+    /* Compaction into sector 1 dies before its header is written */
+    FKV_RamFailAfter = 1;
+    CHECK(!FKV_Set(1, 1000));
+    FKV_RamFailAfter = -1;
+
+    Reboot();
+    CHECK_EQ(Get(1), 30);               /* Old sector still active */
+    CHECK_EQ(FKV_Stats.generation, 1);
+
+    CHECK(FKV_Set(1, 1000));            /* Retried compaction */
+    Reboot();
+    CHECK_EQ(Get(1), 1000);
+    CHECK_EQ(FKV_Stats.generation, 2);
+}
+
+int main(void)
+{
+    Test_Blank();
+    Test_SetGetReboot();
+    Test_UnchangedAndBadKeys();
+    Test_Compaction();
+    Test_TornAppend();
+    Test_TornCompaction();
+
+    return TEST_DONE("flash_kv");
+}
@@ -0,0 +1,639 @@
+/*
+ * vcan.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ */
+
+
+#include "vcan.h"
+#include <string.h>
+
+/* ── Bit Stream ──────────────────────────────── */
+/* SOF .. CRC of the longest frame (extended, 8 bytes) before stuffing */
+#define RAW_BITS_MAX        118U
+
+/* After the CRC: delimiter, ACK slot, ACK delimiter, 7 EOF bits,
+ * 3 intermission bits */
+#define TAIL_BITS           13U
+#define IFS_BITS            3U
+
+/* Error flag, worst-case superposition of the echoed flags, and the
+ * delimiter — counted from the bit after the one in error */
+#define ERROR_FRAME_BITS    (6U + 6U + 8U)
+
+#define SUSPEND_BITS        8U
+#define BUS_OFF_RECOVERY    (128U * 11U)
+
+#define TEC_BUS_OFF         256U
+#define ERROR_PASSIVE       128U
+
+#define CRC15_POLY          0x4599U
+
+typedef struct {
+    uint8_t bit[RAW_BITS_MAX];
+    uint8_t len;
+} VCAN_Bits_t;
+
+static void VCAN_Put(VCAN_Bits_t *b, uint32_t value, uint32_t n)
+{
+    while (n-- > 0U) b->bit[b->len++] = (uint8_t)((value >> n) & 1U);
+}
+
+/* ─────────────────────────────────────────────────
+ * VCAN_Encode — the frame as sent, SOF through CRC,
+ * unstuffed. ISO 11898-1 field order
+ * ───────────────────────────────────────────────── */
+static void VCAN_Encode(const VCAN_Frame_t *f, VCAN_Bits_t *b)
+{
+    uint32_t bytes = f->rtr ? 0U : (f->dlc > 8U ? 8U : f->dlc);
+    uint16_t crc = 0U;
+
+    b->len = 0U;
+    VCAN_Put(b, 0U, 1U);                                /* SOF */
+    if (f->ide)
+    {
+        VCAN_Put(b, f->id >> 18, 11U);
+        VCAN_Put(b, 3U, 2U);                            /* SRR, IDE */
+        VCAN_Put(b, f->id & 0x3FFFFU, 18U);
+        VCAN_Put(b, f->rtr ? 1U : 0U, 1U);
+        VCAN_Put(b, 0U, 2U);                            /* r1, r0 */
+    }
+    else
+    {
+        VCAN_Put(b, f->id & 0x7FFU, 11U);
+        VCAN_Put(b, f->rtr ? 1U : 0U, 1U);
+        VCAN_Put(b, 0U, 2U);                            /* IDE, r0 */
+    }
+    VCAN_Put(b, f->dlc & 0xFU, 4U);
+    for (uint32_t i = 0; i < bytes; i++) VCAN_Put(b, f->data[i], 8U);
+
+    for (uint32_t i = 0; i < b->len; i++)
+    {
+        uint16_t next = (uint16_t)(b->bit[i] ^ ((crc >> 14) & 1U));
+        crc = (uint16_t)((crc << 1) & 0x7FFFU);
+        if (next != 0U) crc ^= CRC15_POLY;
+    }
+    VCAN_Put(b, crc, 15U);
+}
+
+/* A stuff bit follows every five equal bits and starts the next run */
+static uint32_t VCAN_StuffCount(const VCAN_Bits_t *b)
+{
+    uint32_t stuff = 0U, run = 1U;
+    uint8_t  last  = b->bit[0];
+
+    for (uint32_t i = 1; i < b->len; i++)
+    {
+        if (b->bit[i] != last)
+        {
+            last = b->bit[i];
+            run  = 1U;
+        }
+        else if (++run == 5U)
+        {
+            stuff++;
+            last = (uint8_t)!last;
+            run  = 1U;
+        }
+    }
+    return stuff;
+}
+
+uint32_t VCAN_FrameBits(const VCAN_Frame_t *frame, uint32_t *stuffBits)
+{
+    VCAN_Bits_t b;
+    VCAN_Encode(frame, &b);
+
+    uint32_t stuff = VCAN_StuffCount(&b);
+    if (stuffBits != NULL) *stuffBits = stuff;
+    return b.len + stuff + TAIL_BITS;
+}
+
+/* ─────────────────────────────────────────────────
+ * VCAN_ArbKey — the arbitration field left-aligned in
+ * 32 bits, the order the wire sends it: base ID, RTR
+ * (SRR), IDE, then extended ID and RTR. A standard
+ * frame is never equal to an extended one past IDE
+ * ───────────────────────────────────────────────── */
+static uint32_t VCAN_ArbKey(const VCAN_Frame_t *f)
+{
+    if (!f->ide) return ((f->id & 0x7FFU) << 21) | (f->rtr ? 1U << 20 : 0U);
+
+    return ((f->id >> 18) << 21) | (3U << 19) | ((f->id & 0x3FFFFU) << 1) | (f->rtr ? 1U : 0U);
+}
+
+/* ── Helpers ─────────────────────────────────── */
+static uint64_t VCAN_BitsToNs(const VCAN_Bus_t *bus, uint64_t bits)
+{
+    return bits * 1000000000ULL / bus->bitrate;
+}
+
+/* xorshift64* — deterministic per seed, so a run can be repeated */
+static uint32_t VCAN_Random(VCAN_Bus_t *bus)
+{
+    uint64_t x = bus->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    bus->rng = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static bool VCAN_IsBusOff(const VCAN_Node_t *n)
+{
+    return n->tec >= TEC_BUS_OFF;
+}
+
+static bool VCAN_IsPassive(const VCAN_Node_t *n)
+{
+    return n->tec >= ERROR_PASSIVE || n->rec >= ERROR_PASSIVE;
+}
+
+/* On the bus: may ACK, receive and contend */
+static bool VCAN_IsAttached(const VCAN_Node_t *n)
+{
+    return n->online && !VCAN_IsBusOff(n);
+}
+
+static bool VCAN_IsOwner(const VCAN_Bus_t *bus, uint8_t node)
+{
+    for (uint32_t i = 0; i < bus->owners; i++)
+    {
+        if (bus->owner[i] == node) return true;
+    }
+    return false;
+}
+
+/* ─────────────────────────────────────────────────
+ * VCAN_NextMailbox — the node's own choice of frame
+ * to offer: request order with TXFP, otherwise the
+ * identifier that would win arbitration
+ * ───────────────────────────────────────────────── */
+static int32_t VCAN_NextMailbox(const VCAN_Node_t *n)
+{
+    int32_t best = -1;
+
+    if (n->txPending == 0U) return -1;
+
+    for (int32_t mb = 0; mb < VCAN_TX_MAILBOXES; mb++)
+    {
+        const VCAN_Mailbox_t *m = &n->tx[mb];
+        if ((n->txPending & (1U << mb)) == 0U) continue;
+        if (best < 0) { best = mb; continue; }
+
+        bool earlier = n->cfg.txfp ? (int32_t)(m->seq - n->tx[best].seq) < 0
+                                   : VCAN_ArbKey(&m->frame) < VCAN_ArbKey(&n->tx[best].frame);
+        if (earlier) best = mb;
+    }
+    return best;
+}
+
+static bool VCAN_CanStart(const VCAN_Bus_t *bus, const VCAN_Node_t *n)
+{
+    return VCAN_IsAttached(n) && n->suspendNs <= bus->nowNs && VCAN_NextMailbox(n) >= 0;
+}
+
+static bool VCAN_InjectHit(VCAN_Bus_t *bus, const VCAN_Frame_t *f, uint8_t sender)
+{
+    if (bus->injectNext > 0U)
+    {
+        bus->injectNext--;
+        return true;
+    }
+
+    const VCAN_ErrorInjection_t *inj = &bus->inject;
+    if (inj->framePpm == 0U) return false;
+    if ((f->id & inj->idMask) != inj->idMatch) return false;
+    if (inj->node != VCAN_ANY_NODE && inj->node != sender) return false;
+
+    return VCAN_Random(bus) % 1000000U < inj->framePpm;
+}
+
+/* ─────────────────────────────────────────────────
+ * VCAN_StartFrame — SOF for every node that can send.
+ * The bus is the wired AND of all contenders; one that
+ * sends recessive and reads dominant has lost
+ * ───────────────────────────────────────────────── */
+static void VCAN_StartFrame(VCAN_Bus_t *bus)
+{
+    uint8_t  contender[VCAN_MAX_NODES];
+    uint32_t key[VCAN_MAX_NODES];
+    uint8_t  mailbox[VCAN_MAX_NODES];
+    uint32_t count = 0U;
+
+    for (uint8_t i = 0; i < bus->nodes; i++)
+    {
+        VCAN_Node_t *n = &bus->node[i];
+        if (!VCAN_CanStart(bus, n)) continue;
+
+        mailbox[count]   = (uint8_t)VCAN_NextMailbox(n);
+        key[count]       = VCAN_ArbKey(&n->tx[mailbox[count]].frame);
+        contender[count] = i;
+        count++;
+    }
+    if (count == 0U) return;
+
+    uint32_t alive = count;
+    bool     in[VCAN_MAX_NODES];
+    memset(in, 1, sizeof(in));
+
+    for (uint32_t bit = 32; bit-- > 0U && alive > 1U; )
+    {
+        uint32_t wire = 1U;
+        for (uint32_t c = 0; c < count; c++)
+        {
+            if (in[c]) wire &= (key[c] >> bit) & 1U;
+        }
+        for (uint32_t c = 0; c < count; c++)
+        {
+            if (!in[c] || ((key[c] >> bit) & 1U) == wire) continue;
+
+            in[c] = false;
+            alive--;
+            bus->node[contender[c]].stats.arbLost++;
+        }
+    }
+    if (count > 1U) bus->stats.arbitrations++;
+
+    bus->owners = 0U;
+    for (uint32_t c = 0; c < count; c++)
+    {
+        if (!in[c]) continue;
+        bus->owner[bus->owners]        = contender[c];
+        bus->ownerMailbox[bus->owners] = mailbox[c];
+        bus->owners++;
+    }
+
+    /* What the bus actually carries */
+    const VCAN_Frame_t *f = &bus->node[bus->owner[0]].tx[bus->ownerMailbox[0]].frame;
+    VCAN_Bits_t bits;
+    VCAN_Encode(f, &bits);
+    bus->stuffBits = VCAN_StuffCount(&bits);
+
+    uint32_t total   = bits.len + bus->stuffBits + TAIL_BITS;
+    uint32_t errorAt = 0U;
+
+    /* Same identifier from two nodes: arbitration cannot separate
+     * them, the first differing bit is a bit error for its sender */
+    for (uint32_t o = 1; o < bus->owners && errorAt == 0U; o++)
+    {
+        VCAN_Bits_t other;
+        VCAN_Encode(&bus->node[bus->owner[o]].tx[bus->ownerMailbox[o]].frame, &other);
+        for (uint32_t i = 0; i < bits.len; i++)
+        {
+            if (other.bit[i] != bits.bit[i]) { errorAt = i; break; }
+        }
+    }
+
+    bus->ackError = false;
+    if (errorAt == 0U && VCAN_InjectHit(bus, f, bus->owner[0]))
+    {
+        /* Anywhere from the first identifier bit to the ACK slot */
+        errorAt = 1U + VCAN_Random(bus) % (bits.len + bus->stuffBits + 1U);
+    }
+    if (errorAt == 0U)
+    {
+        bool acked = false;
+        for (uint8_t i = 0; i < bus->nodes && !acked; i++)
+        {
+            acked = VCAN_IsAttached(&bus->node[i]) && !VCAN_IsOwner(bus, i);
+        }
+        if (!acked)
+        {
+            bus->ackError = true;
+            errorAt = bits.len + bus->stuffBits + 1U;  /* ACK slot */
+        }
+    }
+
+    bus->errored = errorAt != 0U;
+    if (bus->errored) total = errorAt + 1U + ERROR_FRAME_BITS + IFS_BITS;
+
+    bus->busy        = true;
+    bus->frameEndNs  = bus->nowNs + VCAN_BitsToNs(bus, total);
+    bus->stats.busyBits += total;
+}
+
+/* ─────────────────────────────────────────────────
+ * RX — filters in order, first match picks the FIFO;
+ * a node without filters takes everything into FIFO 0
+ * ───────────────────────────────────────────────── */
+static void VCAN_Deliver(VCAN_Bus_t *bus, uint8_t node, const VCAN_Frame_t *f)
+{
+    VCAN_Node_t *n = &bus->node[node];
+    int32_t fifo = n->filters == 0U ? 0 : -1;
+
+    for (uint32_t i = 0; i < n->filters && fifo < 0; i++)
+    {
+        const VCAN_Filter_t *flt = &n->filter[i];
+        if (flt->ide == f->ide && ((f->id ^ flt->id) & flt->mask) == 0U) fifo = flt->fifo;
+    }
+    if (fifo < 0) return;
+
+    VCAN_Fifo_t *q = &n->rx[fifo];
+    uint32_t slot;
+
+    if (q->count == VCAN_RX_FIFO_DEPTH)
+    {
+        n->stats.rxOverrun++;
+        if (n->cfg.rflm) return;
+        slot = VCAN_RX_FIFO_DEPTH - 1U;     /* Newest is overwritten */
+    }
+    else
+    {
+        slot = q->count++;
+    }
+
+    q->frame[slot]  = *f;
+    q->timeNs[slot] = bus->nowNs;
+    n->stats.rxFrames++;
+
+    if (n->cfg.rxPending != NULL) n->cfg.rxPending(bus, node, (uint8_t)fifo, n->cfg.ctx);
+}
+
+static void VCAN_Complete(VCAN_Bus_t *bus, uint8_t node, uint8_t mb, bool ok)
+{
+    VCAN_Node_t *n = &bus->node[node];
+
+    n->txPending &= (uint8_t)~(1U << mb);
+    if (!ok) n->stats.txAborted++;
+    if (n->cfg.txDone != NULL) n->cfg.txDone(bus, node, mb, ok, n->cfg.ctx);
+}
+
+static void VCAN_EnterBusOff(VCAN_Bus_t *bus, uint8_t node)
+{
+    VCAN_Node_t *n = &bus->node[node];
+
+    n->tec = TEC_BUS_OFF;
+    n->stats.busOff++;
+    bus->busOffNodes++;
+    n->recoverNs = n->cfg.abom ? bus->nowNs + VCAN_BitsToNs(bus, BUS_OFF_RECOVERY) : UINT64_MAX;
+
+    for (uint8_t mb = 0; mb < VCAN_TX_MAILBOXES; mb++)
+    {
+        if ((n->txPending & (1U << mb)) != 0U) VCAN_Complete(bus, node, mb, false);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * VCAN_FinishFrame — end of EOF or of the error frame.
+ * Counters follow ISO 11898-1 fault confinement, with
+ * the ACK error exception for error-passive senders
+ * ───────────────────────────────────────────────── */
+static void VCAN_FinishFrame(VCAN_Bus_t *bus)
+{
+    VCAN_Frame_t f = bus->node[bus->owner[0]].tx[bus->ownerMailbox[0]].frame;
+
+    bus->busy = false;
+
+    if (bus->errored)
+    {
+        bus->stats.errorFrames++;
+
+        for (uint8_t i = 0; i < bus->nodes; i++)
+        {
+            VCAN_Node_t *n = &bus->node[i];
+            if (!bus->ackError && VCAN_IsAttached(n) && !VCAN_IsOwner(bus, i) && n->rec < 255U) n->rec++;
+        }
+
+        for (uint32_t o = 0; o < bus->owners; o++)
+        {
+            uint8_t      node = bus->owner[o];
+            VCAN_Node_t *n    = &bus->node[node];
+
+            n->stats.txError++;
+            if (!(bus->ackError && VCAN_IsPassive(n))) n->tec += 8U;
+
+            if (VCAN_IsBusOff(n))
+            {
+                VCAN_EnterBusOff(bus, node);
+                continue;
+            }
+            if (VCAN_IsPassive(n)) n->suspendNs = bus->nowNs + VCAN_BitsToNs(bus, SUSPEND_BITS);
+            if (n->cfg.nart)       VCAN_Complete(bus, node, bus->ownerMailbox[o], false);
+        }
+        return;
+    }
+
+    bus->stats.frames++;
+    bus->stats.stuffBits += bus->stuffBits;
+
+    for (uint32_t o = 0; o < bus->owners; o++)
+    {
+        uint8_t      node = bus->owner[o];
+        VCAN_Node_t *n    = &bus->node[node];
+        uint64_t     wait = bus->nowNs - n->tx[bus->ownerMailbox[o]].requestNs;
+
+        n->stats.txOk++;
+        if (n->tec > 0U) n->tec--;
+        if (wait > n->stats.maxTxWaitNs) n->stats.maxTxWaitNs = wait;
+        if (VCAN_IsPassive(n)) n->suspendNs = bus->nowNs + VCAN_BitsToNs(bus, SUSPEND_BITS);
+    }
+
+    for (uint8_t i = 0; i < bus->nodes; i++)
+    {
+        VCAN_Node_t *n = &bus->node[i];
+        if (!VCAN_IsAttached(n) || VCAN_IsOwner(bus, i)) continue;
+
+        if (n->rec > ERROR_PASSIVE - 1U) n->rec = ERROR_PASSIVE - 1U;
+        else if (n->rec > 0U)            n->rec--;
+        VCAN_Deliver(bus, i, &f);
+    }
+
+    /* Last, so a callback that queues its next frame sees the
+     * mailbox free */
+    for (uint32_t o = 0; o < bus->owners; o++)
+    {
+        uint8_t node = bus->owner[o];
+        uint8_t mb   = bus->ownerMailbox[o];
+
+        bus->node[node].txPending &= (uint8_t)~(1U << mb);
+        if (bus->node[node].cfg.txDone != NULL)
+            bus->node[node].cfg.txDone(bus, node, mb, true, bus->node[node].cfg.ctx);
+    }
+}
+
+/* ── Simulated Time ──────────────────────────── */
+uint64_t VCAN_Now(const VCAN_Bus_t *bus)
+{
+    return bus->nowNs;
+}
+
+uint64_t VCAN_NextEvent(const VCAN_Bus_t *bus)
+{
+    if (bus->busy) return bus->frameEndNs;
+
+    uint64_t next = UINT64_MAX;
+    for (uint8_t i = 0; i < bus->nodes; i++)
+    {
+        const VCAN_Node_t *n = &bus->node[i];
+        uint64_t t;
+
+        if (VCAN_IsBusOff(n))                             t = n->recoverNs;
+        else if (n->online && VCAN_NextMailbox(n) >= 0)   t = n->suspendNs > bus->nowNs ? n->suspendNs : bus->nowNs;
+        else                                              continue;
+
+        if (t < next) next = t;
+    }
+    return next;
+}
+
+void VCAN_RunUntil(VCAN_Bus_t *bus, uint64_t ns)
+{
+    uint64_t t;
+
+    while ((t = VCAN_NextEvent(bus)) != UINT64_MAX && t <= ns)
+    {
+        if (t > bus->nowNs) bus->nowNs = t;
+
+        if (bus->busy && bus->frameEndNs <= bus->nowNs) VCAN_FinishFrame(bus);
+
+        for (uint8_t i = 0; i < bus->nodes && bus->busOffNodes > 0U; i++)
+        {
+            VCAN_Node_t *n = &bus->node[i];
+            if (VCAN_IsBusOff(n) && n->recoverNs <= bus->nowNs)
+            {
+                n->tec = 0U;
+                n->rec = 0U;
+                bus->busOffNodes--;
+            }
+        }
+
+        if (!bus->busy) VCAN_StartFrame(bus);
+    }
+    if (ns > bus->nowNs) bus->nowNs = ns;
+}
+
+/* ── Setup ───────────────────────────────────── */
+void VCAN_Init(VCAN_Bus_t *bus, uint32_t bitrate, uint8_t nodes, uint64_t seed)
+{
+    memset(bus, 0, sizeof(*bus));
+    bus->bitrate     = bitrate;
+    bus->nodes       = nodes > VCAN_MAX_NODES ? VCAN_MAX_NODES : nodes;
+    bus->rng         = seed != 0U ? seed : 0x9E3779B97F4A7C15ULL;
+    bus->inject.node = VCAN_ANY_NODE;
+
+    for (uint8_t i = 0; i < bus->nodes; i++) bus->node[i].online = true;
+}
+
+void VCAN_ConfigNode(VCAN_Bus_t *bus, uint8_t node, const VCAN_NodeConfig_t *cfg)
+{
+    if (node < bus->nodes) bus->node[node].cfg = *cfg;
+}
+
+bool VCAN_ConfigFilter(VCAN_Bus_t *bus, uint8_t node, const VCAN_Filter_t *filter)
+{
+    if (node >= bus->nodes || filter->fifo >= VCAN_RX_FIFOS) return false;
+
+    VCAN_Node_t *n = &bus->node[node];
+    if (n->filters == VCAN_MAX_FILTERS) return false;
+
+    n->filter[n->filters++] = *filter;
+    return true;
+}
+
+void VCAN_SetOnline(VCAN_Bus_t *bus, uint8_t node, bool online)
+{
+    if (node >= bus->nodes) return;
+
+    VCAN_Node_t *n = &bus->node[node];
+    n->online = online;
+    if (online && VCAN_IsBusOff(n) && n->recoverNs == UINT64_MAX)
+        n->recoverNs = bus->nowNs + VCAN_BitsToNs(bus, BUS_OFF_RECOVERY);
+}
+
+void VCAN_SetErrorInjection(VCAN_Bus_t *bus, const VCAN_ErrorInjection_t *inject)
+{
+    bus->inject = *inject;
+}
+
+void VCAN_InjectErrors(VCAN_Bus_t *bus, uint32_t frames)
+{
+    bus->injectNext = frames;
+}
+
+/* ── Node API ────────────────────────────────── */
+bool VCAN_AddTxMessage(VCAN_Bus_t *bus, uint8_t node, const VCAN_Frame_t *frame, uint8_t *mailbox)
+{
+    if (node >= bus->nodes) return false;
+
+    VCAN_Node_t *n = &bus->node[node];
+    for (uint8_t mb = 0; mb < VCAN_TX_MAILBOXES; mb++)
+    {
+        VCAN_Mailbox_t *m = &n->tx[mb];
+        if ((n->txPending & (1U << mb)) != 0U) continue;
+
+        m->frame     = *frame;
+        m->requestNs = bus->nowNs;
+        m->seq       = bus->txSeq++;
+        n->txPending |= (uint8_t)(1U << mb);
+        if (mailbox != NULL) *mailbox = mb;
+        return true;
+    }
+    return false;
+}
+
+/* A mailbox that is on the bus right now finishes its frame */
+bool VCAN_AbortTxRequest(VCAN_Bus_t *bus, uint8_t node, uint8_t mailbox)
+{
+    if (node >= bus->nodes || mailbox >= VCAN_TX_MAILBOXES) return false;
+    if ((bus->node[node].txPending & (1U << mailbox)) == 0U) return false;
+
+    for (uint32_t o = 0; bus->busy && o < bus->owners; o++)
+    {
+        if (bus->owner[o] == node && bus->ownerMailbox[o] == mailbox) return false;
+    }
+    VCAN_Complete(bus, node, mailbox, false);
+    return true;
+}
+
+uint8_t VCAN_GetTxMailboxesFreeLevel(const VCAN_Bus_t *bus, uint8_t node)
+{
+    uint8_t free = 0U;
+
+    for (uint8_t mb = 0; node < bus->nodes && mb < VCAN_TX_MAILBOXES; mb++)
+    {
+        if ((bus->node[node].txPending & (1U << mb)) == 0U) free++;
+    }
+    return free;
+}
+
+bool VCAN_GetRxMessage(VCAN_Bus_t *bus, uint8_t node, uint8_t fifo, VCAN_Frame_t *frame, uint64_t *timeNs)
+{
+    if (node >= bus->nodes || fifo >= VCAN_RX_FIFOS) return false;
+
+    VCAN_Fifo_t *q = &bus->node[node].rx[fifo];
+    if (q->count == 0U) return false;
+
+    *frame = q->frame[0];
+    if (timeNs != NULL) *timeNs = q->timeNs[0];
+
+    q->count--;
+    memmove(&q->frame[0], &q->frame[1], q->count * sizeof(q->frame[0]));
+    memmove(&q->timeNs[0], &q->timeNs[1], q->count * sizeof(q->timeNs[0]));
+    return true;
+}
+
+uint8_t VCAN_GetRxFifoFillLevel(const VCAN_Bus_t *bus, uint8_t node, uint8_t fifo)
+{
+    if (node >= bus->nodes || fifo >= VCAN_RX_FIFOS) return 0U;
+    return bus->node[node].rx[fifo].count;
+}
+
+VCAN_ErrorState_t VCAN_GetErrorState(const VCAN_Bus_t *bus, uint8_t node)
+{
+    const VCAN_Node_t *n = &bus->node[node];
+
+    if (VCAN_IsBusOff(n))  return VCAN_BUS_OFF;
+    if (VCAN_IsPassive(n)) return VCAN_ERROR_PASSIVE;
+    return VCAN_ERROR_ACTIVE;
+}
+
+VCAN_NodeStats_t VCAN_GetNodeStats(const VCAN_Bus_t *bus, uint8_t node)
+{
+    VCAN_NodeStats_t s = bus->node[node].stats;
+
+    s.tec = bus->node[node].tec;
+    s.rec = bus->node[node].rec;
+    return s;
+}
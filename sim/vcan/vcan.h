@@ -0,0 +1,191 @@
+/*
+ * vcan.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  In-process virtual CAN bus — a discrete-event model of up to
+ *  VCAN_MAX_NODES bxCAN controllers on one bus. Time is simulated:
+ *  VCAN_RunUntil() jumps from one bus event to the next, so an hour
+ *  of traffic is over as soon as the events are processed.
+ *
+ *  What is modelled:
+ *   - Bitwise arbitration: every node with a pending mailbox starts
+ *     SOF together once the bus is idle, and drops out on the first
+ *     recessive bit it sends while the bus is dominant
+ *   - Frame time from the real bit stream — CRC-15 and stuff bits
+ *     included — plus ACK, EOF and the 3-bit intermission
+ *   - Three TX mailboxes per node (by identifier, or request order
+ *     with txfp) and two three-deep RX FIFOs with overrun, locked or
+ *     not, behind mask filters
+ *   - Fault confinement: TEC/REC, error passive (suspend transmission)
+ *     and bus-off, with automatic recovery after 128 x 11 bits
+ *   - Injected errors: a share of frames, optionally by identifier or
+ *     sender, or the next N frames, is destroyed by an error frame at
+ *     a random bit
+ *
+ *  No OS or HAL dependency. Callbacks run inside VCAN_RunUntil() at
+ *  the simulated instant of the event and may queue new frames.
+ */
+
+#ifndef VCAN_H_
+#define VCAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ── Configuration ───────────────────────────── */
+#define VCAN_MAX_NODES          32
+#define VCAN_TX_MAILBOXES       3
+#define VCAN_RX_FIFOS           2
+#define VCAN_RX_FIFO_DEPTH      3
+#define VCAN_MAX_FILTERS        14      /* Per node */
+
+#define VCAN_ANY_NODE           0xFFU
+
+/* ── Types ───────────────────────────────────── */
+typedef struct {
+    uint32_t id;            /* 11 or 29 bits */
+    bool     ide;
+    bool     rtr;
+    uint8_t  dlc;
+    uint8_t  data[8];
+} VCAN_Frame_t;
+
+typedef enum {
+    VCAN_ERROR_ACTIVE = 0,
+    VCAN_ERROR_PASSIVE,
+    VCAN_BUS_OFF,
+} VCAN_ErrorState_t;
+
+typedef struct VCAN_Bus VCAN_Bus_t;
+
+/* A frame matches when ide agrees and (frame.id ^ id) & mask == 0 */
+typedef struct {
+    uint32_t id;
+    uint32_t mask;
+    bool     ide;
+    uint8_t  fifo;
+} VCAN_Filter_t;
+
+typedef struct {
+    bool  txfp;             /* Mailboxes go in request order, not by identifier */
+    bool  nart;             /* No automatic retransmission */
+    bool  rflm;             /* Full FIFO keeps its frames and drops the new one */
+    bool  abom;             /* Leave bus-off by itself */
+    void (*txDone)(VCAN_Bus_t *bus, uint8_t node, uint8_t mailbox, bool ok, void *ctx);
+    void (*rxPending)(VCAN_Bus_t *bus, uint8_t node, uint8_t fifo, void *ctx);
+    void *ctx;
+} VCAN_NodeConfig_t;
+
+/* Injected errors. A frame is hit with probability framePpm / 1e6
+ * when (id & idMask) == idMatch and the sender matches */
+typedef struct {
+    uint32_t framePpm;
+    uint32_t idMask;
+    uint32_t idMatch;
+    uint8_t  node;          /* Sender, or VCAN_ANY_NODE */
+} VCAN_ErrorInjection_t;
+
+/* ── Statistics ──────────────────────────────── */
+typedef struct {
+    uint64_t frames;        /* Completed without error */
+    uint64_t errorFrames;
+    uint64_t busyBits;      /* Bit times the bus was not idle */
+    uint64_t stuffBits;
+    uint64_t arbitrations;  /* SOFs with more than one contender */
+} VCAN_BusStats_t;
+
+typedef struct {
+    uint32_t txOk;
+    uint32_t txError;       /* Attempts destroyed by an error frame */
+    uint32_t txAborted;     /* NART, bus-off or VCAN_AbortTxRequest */
+    uint32_t arbLost;
+    uint32_t rxFrames;
+    uint32_t rxOverrun;
+    uint32_t busOff;
+    uint64_t maxTxWaitNs;   /* Request to end of frame */
+    uint16_t tec;           /* Filled in by VCAN_GetNodeStats */
+    uint16_t rec;
+} VCAN_NodeStats_t;
+
+/* ── Model State ─────────────────────────────── */
+/* Laid out here so a bus can be allocated statically; only ever
+ * touched through the functions below */
+typedef struct {
+    VCAN_Frame_t frame;
+    uint64_t     requestNs;
+    uint32_t     seq;
+} VCAN_Mailbox_t;
+
+typedef struct {
+    VCAN_Frame_t frame[VCAN_RX_FIFO_DEPTH];
+    uint64_t     timeNs[VCAN_RX_FIFO_DEPTH];
+    uint8_t      count;
+} VCAN_Fifo_t;
+
+typedef struct {
+    VCAN_NodeConfig_t cfg;
+    VCAN_Mailbox_t    tx[VCAN_TX_MAILBOXES];
+    uint8_t           txPending;    /* Bit per mailbox */
+    VCAN_Fifo_t       rx[VCAN_RX_FIFOS];
+    VCAN_Filter_t     filter[VCAN_MAX_FILTERS];
+    uint8_t           filters;
+    bool              online;
+    uint16_t          tec;          /* Beyond 255 means bus-off */
+    uint16_t          rec;
+    uint64_t          suspendNs;    /* Error passive: no SOF before this */
+    uint64_t          recoverNs;    /* Bus-off: back on the bus at this time */
+    VCAN_NodeStats_t  stats;
+} VCAN_Node_t;
+
+struct VCAN_Bus {
+    uint32_t              bitrate;
+    uint8_t               nodes;
+    uint64_t              nowNs;
+    uint64_t              frameEndNs;
+    bool                  busy;
+    uint32_t              txSeq;
+    uint32_t              busOffNodes;
+    uint64_t              rng;
+    VCAN_ErrorInjection_t inject;
+    uint32_t              injectNext;
+    VCAN_BusStats_t       stats;
+
+    /* The frame on the bus */
+    uint8_t               owner[VCAN_MAX_NODES];
+    uint8_t               owners;
+    uint8_t               ownerMailbox[VCAN_MAX_NODES];
+    uint32_t              stuffBits;
+    bool                  errored;
+    bool                  ackError;
+
+    VCAN_Node_t           node[VCAN_MAX_NODES];
+};
+
+/* ── Function Declarations ───────────────────── */
+void     VCAN_Init(VCAN_Bus_t *bus, uint32_t bitrate, uint8_t nodes, uint64_t seed);
+void     VCAN_ConfigNode(VCAN_Bus_t *bus, uint8_t node, const VCAN_NodeConfig_t *cfg);
+bool     VCAN_ConfigFilter(VCAN_Bus_t *bus, uint8_t node, const VCAN_Filter_t *filter);
+void     VCAN_SetOnline(VCAN_Bus_t *bus, uint8_t node, bool online);     /* Also starts bus-off recovery */
+void     VCAN_SetErrorInjection(VCAN_Bus_t *bus, const VCAN_ErrorInjection_t *inject);
+void     VCAN_InjectErrors(VCAN_Bus_t *bus, uint32_t frames);    /* The next N frames on the bus */
+
+/* HAL_CAN_* shaped node API */
+bool     VCAN_AddTxMessage(VCAN_Bus_t *bus, uint8_t node, const VCAN_Frame_t *frame, uint8_t *mailbox);
+bool     VCAN_AbortTxRequest(VCAN_Bus_t *bus, uint8_t node, uint8_t mailbox);
+uint8_t  VCAN_GetTxMailboxesFreeLevel(const VCAN_Bus_t *bus, uint8_t node);
+bool     VCAN_GetRxMessage(VCAN_Bus_t *bus, uint8_t node, uint8_t fifo, VCAN_Frame_t *frame, uint64_t *timeNs);
+uint8_t  VCAN_GetRxFifoFillLevel(const VCAN_Bus_t *bus, uint8_t node, uint8_t fifo);
+VCAN_ErrorState_t VCAN_GetErrorState(const VCAN_Bus_t *bus, uint8_t node);
+VCAN_NodeStats_t  VCAN_GetNodeStats(const VCAN_Bus_t *bus, uint8_t node);
+
+/* Simulated time */
+uint64_t VCAN_Now(const VCAN_Bus_t *bus);
+uint64_t VCAN_NextEvent(const VCAN_Bus_t *bus);         /* UINT64_MAX when nothing is due */
+void     VCAN_RunUntil(VCAN_Bus_t *bus, uint64_t ns);
+
+/* Bits from SOF to the end of intermission, stuff bits included */
+uint32_t VCAN_FrameBits(const VCAN_Frame_t *frame, uint32_t *stuffBits);
+
+#endif /* VCAN_H_ */
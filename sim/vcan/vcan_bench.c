@@ -0,0 +1,413 @@
+/*
+ * vcan_bench.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: sumanthgosi
+ *
+ *  Protocol load bench on the virtual bus: one controller and up to
+ *  31 sensor nodes exchanging traffic shaped like ours, for as long
+ *  as asked in simulated time. Reports bus load, per-class queue to
+ *  end-of-frame latency, command round trips and what each node lost.
+ *
+ *    vcan_bench [--nodes 32] [--seconds 3600] [--bitrate 500000]
+ *               [--seed 1] [--error-ppm 0] [--rx-service-us 0]
+ */
+
+
+#include "vcan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* ── Traffic Model ───────────────────────────── */
+/* Identifiers follow can_app.h with a 5-bit node field, so 31
+ * sensors fit: data 0x100 | node << 3 | fn, command 0x200 | node << 2 | fn */
+#define ID_SYNC             0x6E0U
+#define ID_SYNC_FOLLOWUP    0x6E1U
+#define ID_DATA(node, fn)   (0x100U | ((uint32_t)(node) << 3) | (fn))
+#define ID_CMD(node, fn)    (0x200U | ((uint32_t)(node) << 2) | (fn))
+#define ID_CTRL_HEARTBEAT   0x300U
+
+#define FN_HEARTBEAT        0x2U
+#define FN_RPM_AGG          0x4U
+#define FN_TEMP_AGG         0x5U
+#define FN_COMMAND          0x0U
+#define FN_ACK              0x1U
+
+#define MS                  1000000ULL
+#define CLOCK_PPM_SPREAD    200         /* Node oscillators within ±100 ppm */
+
+typedef enum {
+    CLASS_SYNC = 0,
+    CLASS_HEARTBEAT,
+    CLASS_DATA,
+    CLASS_COMMAND,
+    CLASS_COUNT,
+} Bench_Class_t;
+
+static const char *const _className[CLASS_COUNT] = { "sync", "heartbeat", "data", "command" };
+
+typedef struct {
+    uint32_t      id;
+    uint8_t       dlc;
+    Bench_Class_t cls;
+    uint64_t      periodNs;     /* Nominal, skewed by the node's clock */
+    uint64_t      nextNs;
+} Bench_Stream_t;
+
+#define STREAMS_MAX         4U
+#define SWQ_DEPTH           16U         /* The firmware's CAN TX queue */
+#define HIST_BUCKETS        24U         /* log2 µs: 1 µs .. 8 s */
+
+typedef struct {
+    VCAN_Frame_t  frame;
+    Bench_Class_t cls;
+    uint64_t      queuedNs;
+} Bench_Tx_t;
+
+typedef struct {
+    Bench_Stream_t stream[STREAMS_MAX];
+    uint32_t       streams;
+    int32_t        ppm;
+
+    /* Software TX queue in front of the mailboxes */
+    Bench_Tx_t     swq[SWQ_DEPTH];
+    uint32_t       swqHead;
+    uint32_t       swqCount;
+    uint32_t       swqDropped;
+    Bench_Tx_t     inMailbox[VCAN_TX_MAILBOXES];
+
+    uint64_t       serviceNs;   /* Pending RX service, 0 if none */
+} Bench_Node_t;
+
+typedef struct {
+    uint64_t count;
+    uint64_t lost;          /* Destroyed by an error, not retried */
+    uint64_t sumNs;
+    uint64_t maxNs;
+    uint64_t hist[HIST_BUCKETS];
+} Bench_Latency_t;
+
+/* ── State ───────────────────────────────────── */
+static VCAN_Bus_t      _bus;
+static Bench_Node_t    _node[VCAN_MAX_NODES];
+static Bench_Latency_t _latency[CLASS_COUNT];
+static Bench_Latency_t _cmdRtt;
+static uint64_t        _cmdSentNs[VCAN_MAX_NODES];
+static uint32_t        _cmdLost;
+static uint64_t        _rxServiceNs;
+static uint64_t        _rng = 0x2545F4914F6CDD1DULL;
+
+static uint32_t Bench_Random(void)
+{
+    _rng ^= _rng >> 12;
+    _rng ^= _rng << 25;
+    _rng ^= _rng >> 27;
+    return (uint32_t)((_rng * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static void Bench_Record(Bench_Latency_t *l, uint64_t ns)
+{
+    uint32_t us = (uint32_t)(ns / 1000U), b = 0U;
+
+    while (us > 1U && b < HIST_BUCKETS - 1U) { us >>= 1; b++; }
+    l->hist[b]++;
+    l->count++;
+    l->sumNs += ns;
+    if (ns > l->maxNs) l->maxNs = ns;
+}
+
+/* Upper edge of the bucket holding the given share */
+static uint64_t Bench_PercentileUs(const Bench_Latency_t *l, uint32_t permille)
+{
+    uint64_t want = (l->count * permille + 999U) / 1000U, seen = 0U;
+
+    for (uint32_t b = 0; b < HIST_BUCKETS; b++)
+    {
+        seen += l->hist[b];
+        if (seen >= want) return 2ULL << b;
+    }
+    return 2ULL << (HIST_BUCKETS - 1U);
+}
+
+/* ─────────────────────────────────────────────────
+ * TX path — software queue, drained into free mailboxes
+ * whenever one completes, as CAN_TX_Task does
+ * ───────────────────────────────────────────────── */
+static void Bench_Pump(uint8_t node)
+{
+    Bench_Node_t *n = &_node[node];
+
+    while (n->swqCount > 0U)
+    {
+        Bench_Tx_t *tx = &n->swq[n->swqHead];
+        uint8_t mb;
+
+        if (!VCAN_AddTxMessage(&_bus, node, &tx->frame, &mb)) return;
+
+        n->inMailbox[mb] = *tx;
+        n->swqHead = (n->swqHead + 1U) % SWQ_DEPTH;
+        n->swqCount--;
+    }
+}
+
+static void Bench_Send(uint8_t node, uint32_t id, uint8_t dlc, Bench_Class_t cls)
+{
+    Bench_Node_t *n = &_node[node];
+
+    if (n->swqCount == SWQ_DEPTH)
+    {
+        n->swqDropped++;
+        return;
+    }
+
+    Bench_Tx_t *tx = &n->swq[(n->swqHead + n->swqCount) % SWQ_DEPTH];
+    memset(tx, 0, sizeof(*tx));
+    tx->frame.id  = id;
+    tx->frame.dlc = dlc;
+    for (uint8_t i = 0; i < dlc; i++) tx->frame.data[i] = (uint8_t)Bench_Random();
+    tx->cls      = cls;
+    tx->queuedNs = VCAN_Now(&_bus);
+    n->swqCount++;
+
+    Bench_Pump(node);
+}
+
+static void Bench_TxDone(VCAN_Bus_t *bus, uint8_t node, uint8_t mailbox, bool ok, void *ctx)
+{
+    const Bench_Tx_t *tx = &_node[node].inMailbox[mailbox];
+
+    if (ok) Bench_Record(&_latency[tx->cls], VCAN_Now(bus) - tx->queuedNs);
+    else    _latency[tx->cls].lost++;
+
+    /* FOLLOW_UP carries the SYNC's completion time, so it can only
+     * be queued once that is known */
+    if (ok && tx->frame.id == ID_SYNC) Bench_Send(node, ID_SYNC_FOLLOWUP, 8U, CLASS_SYNC);
+    Bench_Pump(node);
+}
+
+/* ─────────────────────────────────────────────────
+ * RX path — the node drains its FIFO rxServiceNs after
+ * the first pending frame; 0 drains in the callback
+ * ───────────────────────────────────────────────── */
+static void Bench_Service(uint8_t node)
+{
+    VCAN_Frame_t f;
+
+    _node[node].serviceNs = 0U;
+
+    while (VCAN_GetRxMessage(&_bus, node, 0U, &f, NULL))
+    {
+        if (node == 0U && (f.id & 0x703U) == ID_CMD(0, FN_ACK))
+        {
+            uint8_t sensor = (uint8_t)((f.id >> 2) & 0x1FU);
+            if (_cmdSentNs[sensor] != 0U)
+            {
+                Bench_Record(&_cmdRtt, VCAN_Now(&_bus) - _cmdSentNs[sensor]);
+                _cmdSentNs[sensor] = 0U;
+            }
+        }
+        else if (node != 0U && f.id == ID_CMD(node, FN_COMMAND))
+        {
+            Bench_Send(node, ID_CMD(node, FN_ACK), 2U, CLASS_COMMAND);
+        }
+    }
+}
+
+static void Bench_RxPending(VCAN_Bus_t *bus, uint8_t node, uint8_t fifo, void *ctx)
+{
+    if (_rxServiceNs == 0U)              Bench_Service(node);
+    else if (_node[node].serviceNs == 0U) _node[node].serviceNs = VCAN_Now(bus) + _rxServiceNs;
+}
+
+/* ── Setup ───────────────────────────────────── */
+static void Bench_AddStream(uint8_t node, uint32_t id, uint8_t dlc, Bench_Class_t cls, uint64_t periodMs)
+{
+    Bench_Node_t   *n = &_node[node];
+    Bench_Stream_t *s = &n->stream[n->streams++];
+
+    s->id       = id;
+    s->dlc      = dlc;
+    s->cls      = cls;
+    s->periodNs = periodMs * MS + (uint64_t)((int64_t)(periodMs * MS) * n->ppm / 1000000);
+    s->nextNs   = (uint64_t)Bench_Random() % s->periodNs;     /* Random boot phase */
+}
+
+static void Bench_Setup(uint8_t nodes)
+{
+    /* As main.c sets up hcan1: no automatic retransmission */
+    const VCAN_NodeConfig_t cfg = {
+        .nart      = true,
+        .txDone    = Bench_TxDone,
+        .rxPending = Bench_RxPending,
+    };
+
+    for (uint8_t i = 0; i < nodes; i++)
+    {
+        _node[i].ppm = (int32_t)(Bench_Random() % (CLOCK_PPM_SPREAD + 1U)) - CLOCK_PPM_SPREAD / 2;
+        VCAN_ConfigNode(&_bus, i, &cfg);
+    }
+
+    /* Controller: time master, heartbeat, one command a second
+     * round-robin over the sensors (below) */
+    Bench_AddStream(0, ID_SYNC,           4U, CLASS_SYNC,      100U);
+    Bench_AddStream(0, ID_CTRL_HEARTBEAT, 1U, CLASS_HEARTBEAT, 500U);
+
+    /* Sensors: aggregated RPM at the subscribed 100 ms, TEMP at
+     * 500 ms, heartbeat every 100 ms. They filter like Node A:
+     * their own commands, SYNC and the controller heartbeat */
+    for (uint8_t s = 1; s < nodes; s++)
+    {
+        Bench_AddStream(s, ID_DATA(s, FN_RPM_AGG),   8U, CLASS_DATA,      100U);
+        Bench_AddStream(s, ID_DATA(s, FN_TEMP_AGG),  8U, CLASS_DATA,      500U);
+        Bench_AddStream(s, ID_DATA(s, FN_HEARTBEAT), 4U, CLASS_HEARTBEAT, 100U);
+
+        const VCAN_Filter_t filters[] = {
+            { .id = ID_CMD(s, 0),     .mask = 0x7FCU },
+            { .id = ID_SYNC,          .mask = 0x7FEU },
+            { .id = ID_CTRL_HEARTBEAT, .mask = 0x7FFU },
+        };
+        for (uint32_t f = 0; f < sizeof(filters) / sizeof(filters[0]); f++)
+            VCAN_ConfigFilter(&_bus, s, &filters[f]);
+    }
+}
+
+/* ─────────────────────────────────────────────────
+ * Bench_Run — the earliest of the streams, the pending
+ * RX services and the next command decides how far the
+ * bus runs before the application acts again
+ * ───────────────────────────────────────────────── */
+static void Bench_Run(uint8_t nodes, uint64_t endNs)
+{
+    uint64_t nextCmd = 1000U * MS;
+    uint8_t  cmdNode = 1U;
+
+    for (;;)
+    {
+        uint64_t t = nextCmd;
+        int32_t  node = -1, stream = -1;
+        bool     service = false;
+
+        for (uint8_t i = 0; i < nodes; i++)
+        {
+            const Bench_Node_t *n = &_node[i];
+            for (uint32_t s = 0; s < n->streams; s++)
+            {
+                if (n->stream[s].nextNs < t) { t = n->stream[s].nextNs; node = i; stream = (int32_t)s; service = false; }
+            }
+            if (n->serviceNs != 0U && n->serviceNs < t) { t = n->serviceNs; node = i; service = true; }
+        }
+        if (t > endNs) break;
+
+        VCAN_RunUntil(&_bus, t);
+
+        if (node < 0)
+        {
+            /* Command to the next sensor; the previous one unanswered is lost */
+            if (nodes > 1U)
+            {
+                if (_cmdSentNs[cmdNode] != 0U) _cmdLost++;
+                _cmdSentNs[cmdNode] = t;
+                Bench_Send(0, ID_CMD(cmdNode, FN_COMMAND), 2U, CLASS_COMMAND);
+                cmdNode = (uint8_t)(cmdNode + 1U < nodes ? cmdNode + 1U : 1U);
+            }
+            nextCmd += 1000U * MS;
+        }
+        else if (service)
+        {
+            Bench_Service((uint8_t)node);
+        }
+        else
+        {
+            Bench_Stream_t *s = &_node[node].stream[stream];
+            Bench_Send((uint8_t)node, s->id, s->dlc, s->cls);
+            s->nextNs += s->periodNs;
+        }
+    }
+    VCAN_RunUntil(&_bus, endNs);
+}
+
+/* ── Report ──────────────────────────────────── */
+static void Bench_Report(uint8_t nodes, uint64_t endNs, double wallSec)
+{
+    const VCAN_BusStats_t *bs = &_bus.stats;
+    double simSec = (double)endNs / 1e9;
+    double load   = 100.0 * (double)bs->busyBits / ((double)_bus.bitrate * simSec);
+
+    printf("vcan bench: %u nodes, %lu bit/s, %.0f s simulated in %.2f s (%.0fx real time)\n",
+           nodes, (unsigned long)_bus.bitrate, simSec, wallSec, simSec / (wallSec > 0.0 ? wallSec : 1e-9));
+    printf("bus: %llu frames, load %.1f%%, %.2f stuff bits/frame, %llu error frames, %llu arbitrations\n",
+           (unsigned long long)bs->frames, load,
+           bs->frames ? (double)bs->stuffBits / (double)bs->frames : 0.0,
+           (unsigned long long)bs->errorFrames, (unsigned long long)bs->arbitrations);
+
+    printf("\n%-10s %10s %10s %10s %10s %8s\n", "latency", "frames", "mean us", "p99 <= us", "max us", "lost");
+    for (uint32_t c = 0; c < CLASS_COUNT; c++)
+    {
+        const Bench_Latency_t *l = &_latency[c];
+        printf("%-10s %10llu %10.1f %10llu %10.1f %8llu\n", _className[c], (unsigned long long)l->count,
+               l->count ? (double)l->sumNs / (double)l->count / 1e3 : 0.0,
+               (unsigned long long)Bench_PercentileUs(l, 990U), (double)l->maxNs / 1e3,
+               (unsigned long long)l->lost);
+    }
+    printf("%-10s %10llu %10.1f %10llu %10.1f %8u\n", "cmd rtt",
+           (unsigned long long)_cmdRtt.count,
+           _cmdRtt.count ? (double)_cmdRtt.sumNs / (double)_cmdRtt.count / 1e3 : 0.0,
+           (unsigned long long)Bench_PercentileUs(&_cmdRtt, 990U), (double)_cmdRtt.maxNs / 1e3, _cmdLost);
+
+    printf("\n%-5s %9s %9s %7s %7s %7s %6s %5s %5s %11s\n",
+           "node", "tx", "rx", "arblost", "txerr", "overrun", "swdrop", "boff", "tec", "max wait us");
+    for (uint8_t i = 0; i < nodes; i++)
+    {
+        VCAN_NodeStats_t s = VCAN_GetNodeStats(&_bus, i);
+        printf("%-5u %9lu %9lu %7lu %7lu %7lu %6lu %5lu %5u %11.1f\n", i,
+               (unsigned long)s.txOk, (unsigned long)s.rxFrames, (unsigned long)s.arbLost,
+               (unsigned long)s.txError, (unsigned long)s.rxOverrun, (unsigned long)_node[i].swqDropped,
+               (unsigned long)s.busOff, s.tec, (double)s.maxTxWaitNs / 1e3);
+    }
+}
+
+static uint64_t Bench_Arg(int argc, char **argv, const char *name, uint64_t fallback)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], name) == 0) return strtoull(argv[i + 1], NULL, 0);
+    }
+    return fallback;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t nodes   = Bench_Arg(argc, argv, "--nodes", VCAN_MAX_NODES);
+    uint64_t seconds = Bench_Arg(argc, argv, "--seconds", 3600U);
+    uint64_t bitrate = Bench_Arg(argc, argv, "--bitrate", 500000U);
+    uint64_t seed    = Bench_Arg(argc, argv, "--seed", 1U);
+
+    if (nodes < 1U || nodes > VCAN_MAX_NODES || bitrate == 0U)
+    {
+        fprintf(stderr, "vcan_bench: --nodes 1..%d, --bitrate > 0\n", VCAN_MAX_NODES);
+        return 2;
+    }
+
+    VCAN_ErrorInjection_t inject = {
+        .framePpm = (uint32_t)Bench_Arg(argc, argv, "--error-ppm", 0U),
+        .node     = VCAN_ANY_NODE,
+    };
+
+    _rxServiceNs = Bench_Arg(argc, argv, "--rx-service-us", 0U) * 1000U;
+    _rng        ^= seed * 0x9E3779B97F4A7C15ULL;
+
+    VCAN_Init(&_bus, (uint32_t)bitrate, (uint8_t)nodes, seed);
+    VCAN_SetErrorInjection(&_bus, &inject);
+    Bench_Setup((uint8_t)nodes);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    Bench_Run((uint8_t)nodes, seconds * 1000U * MS);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    Bench_Report((uint8_t)nodes, seconds * 1000U * MS,
+                 (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9);
+    return 0;
+}